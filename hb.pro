@@ -54,6 +54,7 @@ else {
         hbToolExport("$${HB_BUILD_DIR}/bin/docml2bin", "$${HB_BIN_DIR}/docml2bin")
         hbToolExport("$${HB_BUILD_DIR}/bin/hbbincssmaker", "$${HB_BIN_DIR}/hbbincssmaker")
         hbToolExport("$${HB_BUILD_DIR}/bin/hbthemeindexer", "$${HB_BIN_DIR}/hbthemeindexer")
+        hbToolExport("$${HB_BUILD_DIR}/bin/fxml2bin", "$${HB_BIN_DIR}/fxml2bin")
     }
 }
 
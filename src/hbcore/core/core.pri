@@ -52,6 +52,7 @@ PRIVATE_HEADERS += $$PWD/hbvariant_p.h
 PRIVATE_HEADERS += $$PWD/hbstringvector_p.h
 PRIVATE_HEADERS += $$PWD/hbaction_p.h
 PRIVATE_HEADERS += $$PWD/hbgraphicsscene_p.h
+PRIVATE_HEADERS += $$PWD/hbframeprofiler_p.h
 PRIVATE_HEADERS += $$PWD/hbglobal_p.h
 PRIVATE_HEADERS += $$PWD/hbinstance_p.h
 PRIVATE_HEADERS += $$PWD/hbnamespace_p.h
@@ -80,6 +81,7 @@ SOURCES += $$PWD/hbapplication.cpp
 SOURCES += $$PWD/hbevent.cpp
 SOURCES += $$PWD/hbglobal.cpp
 SOURCES += $$PWD/hbgraphicsscene.cpp
+SOURCES += $$PWD/hbframeprofiler.cpp
 SOURCES += $$PWD/hbinstance.cpp
 SOURCES += $$PWD/hbnamespace.cpp
 SOURCES += $$PWD/hbhash_p.cpp
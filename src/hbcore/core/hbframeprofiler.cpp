@@ -0,0 +1,262 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the HbCore module of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include "hbframeprofiler_p.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+#include <QAtomicPointer>
+#include <QDebug>
+
+/*!
+    \class HbFrameProfiler
+    \internal
+
+    \brief Records the duration of the frame phases of HbGraphicsScene.
+
+    The profiler is disabled by default and costs a single flag check per
+    probe in that state. When enabled, every probe stores one event into a
+    fixed-size ring buffer. Writers only claim a slot with an atomic
+    increment, so probes can be hit from the icon loader thread as well as
+    from the GUI thread without locking. The oldest events are overwritten
+    once the buffer is full.
+
+    The recorded events can be written out as Chrome trace event JSON with
+    exportTrace() and inspected in chrome://tracing. Setting the
+    HB_FRAME_PROFILE environment variable to a file name enables the
+    profiler at startup and writes the trace into that file when the
+    application exits.
+
+    The item painting is measured in HbGraphicsScene::drawItems(). A view
+    calls it only with QGraphicsView::IndirectPainting, which HbGraphicsScene
+    sets on its view when the profiler is enabled at startup.
+*/
+
+// Must be a power of two.
+static const int HbFrameProfilerCapacity = 16384;
+
+struct HbFrameProfilerEvent
+{
+    // Zero while the slot is being written, otherwise the stamp of the
+    // ticket that wrote it, see hbFrameProfilerStamp().
+    QAtomicInt sequence;
+    int phase;
+    qint64 start;
+    qint64 duration;
+    Qt::HANDLE thread;
+};
+
+struct HbFrameProfilerBuffer
+{
+    QElapsedTimer clock;
+    HbFrameProfilerEvent events[HbFrameProfilerCapacity];
+};
+
+// Allocated when the profiler is first enabled and never released, so that
+// probes running in other threads cannot see it go away.
+static QAtomicPointer<HbFrameProfilerBuffer> profilerBuffer(0);
+// Ticket of the next event. Wraps around, so it is only ever used in
+// unsigned arithmetic.
+static QAtomicInt profilerWriteIndex(0);
+// Ticket of the first event that has not been cleared.
+static QAtomicInt profilerFirstIndex(0);
+static QString profilerTraceFile;
+
+static const char *const profilerPhaseNames[HbFrameProfiler::PhaseCount] = {
+    "frame",
+    "polish",
+    "layoutRequest",
+    "paint",
+    "iconLoad",
+    "cssLookup"
+};
+
+QAtomicInt HbFrameProfiler::enabled(0);
+
+static inline HbFrameProfilerBuffer *hbFrameProfilerBuffer()
+{
+    return profilerBuffer.fetchAndAddAcquire(0);
+}
+
+static inline int hbFrameProfilerStamp(quint32 ticket)
+{
+    // Zero marks a slot that is being written. The last ticket before the
+    // counter wraps around would get zero as well, so it gets 1 instead. That
+    // cannot be confused with ticket 0, because the two use different slots.
+    const quint32 stamp = ticket + 1;
+    return int(stamp ? stamp : 1);
+}
+
+static void hbFrameProfilerExportAtExit()
+{
+    if (!profilerTraceFile.isEmpty()) {
+        HbFrameProfiler::exportTrace(profilerTraceFile);
+    }
+}
+
+/*!
+    Enables the profiler if the HB_FRAME_PROFILE environment variable is set.
+    Only the first call has any effect.
+*/
+void HbFrameProfiler::initialize()
+{
+    static bool initialized = false;
+    if (initialized) {
+        return;
+    }
+    initialized = true;
+
+    QByteArray traceFile = qgetenv("HB_FRAME_PROFILE");
+    if (!traceFile.isEmpty()) {
+        profilerTraceFile = QString::fromLocal8Bit(traceFile);
+        setEnabled(true);
+        qAddPostRoutine(hbFrameProfilerExportAtExit);
+    }
+}
+
+/*!
+    Starts or stops recording. Already recorded events are kept. Probes that
+    are running while the profiler is disabled may still store their event.
+*/
+void HbFrameProfiler::setEnabled(bool enable)
+{
+    if (enable && !hbFrameProfilerBuffer()) {
+        HbFrameProfilerBuffer *buffer = new HbFrameProfilerBuffer;
+        buffer->clock.start();
+        if (!profilerBuffer.testAndSetOrdered(0, buffer)) {
+            delete buffer;
+        }
+    }
+    enabled.fetchAndStoreOrdered(enable ? 1 : 0);
+}
+
+/*!
+    Returns the time in nanoseconds since the profiler was first enabled.
+*/
+qint64 HbFrameProfiler::timestamp()
+{
+    HbFrameProfilerBuffer *buffer = hbFrameProfilerBuffer();
+    if (!buffer) {
+        return 0;
+    }
+#if QT_VERSION >= 0x040800
+    return buffer->clock.nsecsElapsed();
+#else
+    return buffer->clock.elapsed() * Q_INT64_C(1000000);
+#endif
+}
+
+/*!
+    Stores one event of \a phase lasting from \a start to \a end.
+*/
+void HbFrameProfiler::record(Phase phase, qint64 start, qint64 end)
+{
+    HbFrameProfilerBuffer *buffer = hbFrameProfilerBuffer();
+    if (!isEnabled() || !buffer) {
+        return;
+    }
+    const quint32 ticket = quint32(profilerWriteIndex.fetchAndAddRelaxed(1));
+    HbFrameProfilerEvent &event = buffer->events[ticket & (HbFrameProfilerCapacity - 1)];
+    // Mark the slot as busy first. The ordered exchange keeps the field
+    // writes below from becoming visible before the mark.
+    event.sequence.fetchAndStoreOrdered(0);
+    event.phase = phase;
+    event.start = start;
+    event.duration = end - start;
+    event.thread = QThread::currentThreadId();
+    event.sequence.fetchAndStoreRelease(hbFrameProfilerStamp(ticket));
+}
+
+/*!
+    Discards all recorded events. The slots are left untouched, only the
+    start of the exported range moves, so this is safe while probes are
+    writing.
+*/
+void HbFrameProfiler::clear()
+{
+    profilerFirstIndex.fetchAndStoreOrdered(profilerWriteIndex.fetchAndAddOrdered(0));
+}
+
+/*!
+    Writes the recorded events into \a fileName in the Chrome trace event
+    format. Returns false if the file cannot be written.
+*/
+bool HbFrameProfiler::exportTrace(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "HbFrameProfiler: cannot write" << fileName;
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "{\"traceEvents\":[";
+
+    HbFrameProfilerBuffer *buffer = hbFrameProfilerBuffer();
+    if (buffer) {
+        // The counters wrap around, so the number of events is computed in
+        // unsigned arithmetic. Only the last HbFrameProfilerCapacity events
+        // are still in the buffer.
+        const quint32 written = quint32(profilerWriteIndex.fetchAndAddAcquire(0));
+        const quint32 cleared = quint32(profilerFirstIndex.fetchAndAddAcquire(0));
+        const quint32 count = qMin(written - cleared, quint32(HbFrameProfilerCapacity));
+        const qint64 pid = QCoreApplication::applicationPid();
+        bool first = true;
+        for (quint32 ticket = written - count; ticket != written; ++ticket) {
+            HbFrameProfilerEvent &event = buffer->events[ticket & (HbFrameProfilerCapacity - 1)];
+            const int stamp = hbFrameProfilerStamp(ticket);
+            // Read the fields only after the writer has published them, and
+            // skip the slot if it was rewritten while it was being copied.
+            if (event.sequence.fetchAndAddAcquire(0) != stamp) {
+                continue;
+            }
+            const int phase = event.phase;
+            const qint64 start = event.start;
+            const qint64 duration = event.duration;
+            const Qt::HANDLE thread = event.thread;
+            if (event.sequence.fetchAndAddOrdered(0) != stamp
+                || phase < 0 || phase >= PhaseCount) {
+                continue;
+            }
+            if (!first) {
+                out << ',';
+            }
+            first = false;
+            // Trace event timestamps are in microseconds.
+            out << "\n{\"name\":\"" << profilerPhaseNames[phase]
+                << "\",\"cat\":\"hb\",\"ph\":\"X\",\"pid\":" << pid
+                << ",\"tid\":" << quint64(quintptr(thread))
+                << ",\"ts\":" << QString::number(start / 1000.0, 'f', 3)
+                << ",\"dur\":" << QString::number(duration / 1000.0, 'f', 3)
+                << '}';
+        }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return file.error() == QFile::NoError;
+}
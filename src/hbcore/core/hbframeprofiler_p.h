@@ -0,0 +1,95 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the HbCore module of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#ifndef HBFRAMEPROFILER_P_H
+#define HBFRAMEPROFILER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Hb API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QString>
+#include <QAtomicInt>
+#include <hbglobal.h>
+
+class HB_CORE_PRIVATE_EXPORT HbFrameProfiler
+{
+public:
+    enum Phase {
+        Frame,
+        Polish,
+        LayoutRequest,
+        Paint,
+        IconLoad,
+        CssLookup,
+        PhaseCount
+    };
+
+    static void initialize();
+
+    static inline bool isEnabled() { return enabled.fetchAndAddRelaxed(0) != 0; }
+    static void setEnabled(bool enable);
+
+    static qint64 timestamp();
+    static void record(Phase phase, qint64 start, qint64 end);
+    static void clear();
+
+    static bool exportTrace(const QString &fileName);
+
+private:
+    // Set from any thread and read by every probe, so it is atomic.
+    static QAtomicInt enabled;
+};
+
+class HbFrameProfilerScope
+{
+public:
+    explicit inline HbFrameProfilerScope(HbFrameProfiler::Phase phase)
+        : mPhase(phase),
+          mStart(HbFrameProfiler::isEnabled() ? HbFrameProfiler::timestamp() : -1)
+    {
+    }
+
+    inline ~HbFrameProfilerScope()
+    {
+        if (mStart >= 0) {
+            HbFrameProfiler::record(mPhase, mStart, HbFrameProfiler::timestamp());
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(HbFrameProfilerScope)
+    HbFrameProfiler::Phase mPhase;
+    qint64 mStart;
+};
+
+#endif // HBFRAMEPROFILER_P_H
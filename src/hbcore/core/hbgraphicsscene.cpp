@@ -32,6 +32,7 @@
 #include "hbinputfocusobject.h"
 #include "hbpopup.h"
 #include "hbtooltiplabel_p.h"
+#include "hbframeprofiler_p.h"
 
 #include <QApplication>
 #include <QGraphicsItem>
@@ -88,7 +89,8 @@ HbGraphicsScenePrivate::HbGraphicsScenePrivate()
       mDrawCount(0),
       mFPS(0),
       mFPSTime(0),
-      mMaxFPS(0)
+      mMaxFPS(0),
+      mFrameStart(-1)
 {
 }
 
@@ -191,6 +193,7 @@ void HbGraphicsScenePrivate::polishItems()
         // As we want to handle all the polish events before handling layout requests,
         // we do this in two seperate loops. We handle all the repolish and polish requests first
         // and than handle the layout requests.
+        qint64 start = HbFrameProfiler::isEnabled() ? HbFrameProfiler::timestamp() : -1;
         for (int i = 0; i < 2; ++i) {
             //This is run twice so that we handle all polish and itemChangeNotifications of widget
             //and if any primitives are created in the polish event.
@@ -206,9 +209,17 @@ void HbGraphicsScenePrivate::polishItems()
             //are handled before paint.
             method.invoke(q);
         }
+        if (start >= 0) {
+            qint64 end = HbFrameProfiler::timestamp();
+            HbFrameProfiler::record(HbFrameProfiler::Polish, start, end);
+            start = end;
+        }
         for (int i = 0; i < 3; ++i) {
             QApplication::sendPostedEvents(0, QEvent::LayoutRequest);
         }
+        if (start >= 0) {
+            HbFrameProfiler::record(HbFrameProfiler::LayoutRequest, start, HbFrameProfiler::timestamp());
+        }
         mPolishWidgets = false;
     }
 }
@@ -243,12 +254,17 @@ HbGraphicsScene::HbGraphicsScene(QObject *parent) : QGraphicsScene(parent),
     Q_D(HbGraphicsScene);
     d->q_ptr = this;
 
+    HbFrameProfiler::initialize();
+    // The frame profiler measures the item painting in drawItems().
+    bool indirectPainting = HbFrameProfiler::isEnabled();
 #ifdef HB_RND_DRAW_ITEM_BORDERS // see the top of the file
-    if (QGraphicsView *view = qobject_cast<QGraphicsView *>(parent)) {
+    indirectPainting = true;
+#endif
+    QGraphicsView *view = qobject_cast<QGraphicsView *>(parent);
+    if (view && indirectPainting) {
         // set the IndirectPainting flag -> drawItems() is called on paint.
         view->setOptimizationFlag(QGraphicsView::IndirectPainting, true);
     }
-#endif
     setStickyFocus(true);
     d->mPolishItemsSlotIndex = metaObject()->indexOfSlot("_q_polishItems()");
 }
@@ -364,6 +380,7 @@ void HbGraphicsScene::drawItems(QPainter *painter, int numItems,
                                 const QStyleOptionGraphicsItem options[],
                                 QWidget *widget)
 {
+    HbFrameProfilerScope profilerScope(HbFrameProfiler::Paint);
 #ifdef HB_RND_DRAW_ITEM_BORDERS // see the top of the file
     for (int i = 0; i < numItems; ++i) {
         // Draw the item
@@ -395,6 +412,7 @@ void HbGraphicsScene::drawItems(QPainter *painter, int numItems,
 void HbGraphicsScene::drawBackground(QPainter *painter, const QRectF &rect)
 {
     Q_D(HbGraphicsScene);
+    d->mFrameStart = HbFrameProfiler::isEnabled() ? HbFrameProfiler::timestamp() : -1;
     d->polishItems();
     QGraphicsScene::drawBackground(painter, rect);
 }
@@ -426,6 +444,10 @@ void HbGraphicsScene::drawForeground(QPainter *painter, const QRectF & /*rect*/)
         painter->drawText(0, 32, QString("FPS: %0 (%1)").arg(int(d->mFPS)).arg(int(d->mMaxFPS)));
         painter->restore();
     }
+    if (d->mFrameStart >= 0) {
+        HbFrameProfiler::record(HbFrameProfiler::Frame, d->mFrameStart, HbFrameProfiler::timestamp());
+        d->mFrameStart = -1;
+    }
 }
 
 /*!
@@ -81,6 +81,8 @@ public:
     QTime *mFPSTime;
 #endif
     qreal mMaxFPS;
+    // frame profiler timestamp, -1 when not profiling
+    qint64 mFrameStart;
 
 private:
 
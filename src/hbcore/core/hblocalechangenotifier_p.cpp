@@ -34,6 +34,7 @@
 
 #include "hblocalechangenotifier_p.h"
 #include "hbfeaturemanager_r.h"
+#include "hbtranslator_p.h"
 
 
 #ifdef Q_OS_SYMBIAN
@@ -72,6 +73,8 @@ void HbLocaleChangeNotifier::RunL()
 
     // To reset QLocale's cached data
     QSystemLocale dummy;
+    // The catalogs of the new language are looked up again.
+    HbTranslatorPrivate::clearCatalogCache();
     
     if ( HbFeatureManager::instance()->featureStatus(HbFeatureManager::LanguageSwitch) ) {
         foreach (HbMainWindow *window, HbInstance::instance()->allMainWindows()) {
@@ -27,7 +27,9 @@
 #include "hbsharedmemorymanager_p.h"
 #ifndef HB_BIN_CSS
 #include "hbheapmemorymanager_p.h"
+#ifndef HB_BOOTSTRAPPED
 #include "hbsharedmemorymanagerut_p.h"
+#endif // HB_BOOTSTRAPPED
 #endif // HB_BIN_CSS
 
 #include "hbmemoryutils_p.h"
@@ -58,6 +60,8 @@ void HbMemoryManager::releaseInstance( MemoryType type )
 
 void HbMemoryManager::createSharedMemoryManager()
 {
+    // Bootstrapped tools other than hbbincssmaker have heap memory only.
+#if !defined(HB_BOOTSTRAPPED) || defined(HB_BIN_CSS)
     if(!sharedMemoryManager) {
         sharedMemoryManager = HbSharedMemoryManager::create();
         if(!sharedMemoryManager->initialize()) {
@@ -65,6 +69,7 @@ void HbMemoryManager::createSharedMemoryManager()
             sharedMemoryManager = 0;
         }
     }
+#endif
 }
 
 void HbMemoryManager::createHeapMemoryManager()
@@ -798,7 +798,7 @@ HbSharedMemoryManager* HbSharedMemoryManager::create()
 {
 #ifndef HB_BIN_CSS
     // Check for shared container unit test
-    if ( isSharedContainerUnitTest() ) {
+    if ( isSharedContainerUnitTest() || HbSharedMemoryManagerUt::enabledForProcess() ) {
         return HbSharedMemoryManagerUt::create();
     }
 #endif
@@ -33,6 +33,26 @@
 
 #define HB_THEME_SHARED_AUTOTEST_CHUNK "hbthemesharedautotest"
 
+static bool testManagerEnabled = false;
+
+/**
+ * Makes HbSharedMemoryManager::create() return the writable test manager in
+ * this process, also when the application name is not one of the unit tests.
+ * Must be called before the shared memory manager is first used.
+ */
+void HbSharedMemoryManagerUt::enableForProcess()
+{
+    testManagerEnabled = true;
+}
+
+/**
+ * Returns true if enableForProcess() has been called.
+ */
+bool HbSharedMemoryManagerUt::enabledForProcess()
+{
+    return testManagerEnabled;
+}
+
 /**
  * initialize
  */
@@ -39,6 +39,9 @@ public:
         return new HbSharedMemoryManagerUt();
     }
 
+    static void enableForProcess();
+    static bool enabledForProcess();
+
     void setWritable( bool readWrite );
     // This class is only for unittest.. so getting unittest
     // should not be a problem.
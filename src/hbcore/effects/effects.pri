@@ -27,6 +27,7 @@ DEPENDPATH += $$PWD
 PUBLIC_HEADERS += $$PWD/hbeffect.h
 PRIVATE_HEADERS += $$PWD/hbeffect_p.h
 PRIVATE_HEADERS += $$PWD/hbeffectabstract_p.h
+PRIVATE_HEADERS += $$PWD/hbeffectbinaryfxml_p.h
 PRIVATE_HEADERS += $$PWD/hbeffectcontroller_p.h
 PRIVATE_HEADERS += $$PWD/hbeffectdef_p.h
 PRIVATE_HEADERS += $$PWD/hbeffectfactory_p.h
@@ -53,6 +54,7 @@ SOURCES += $$PWD/hbeffect.cpp
 SOURCES += $$PWD/hbeffectblur.cpp
 SOURCES += $$PWD/hbeffectdropshadow.cpp
 SOURCES += $$PWD/hbeffectabstract.cpp
+SOURCES += $$PWD/hbeffectbinaryfxml.cpp
 SOURCES += $$PWD/hbeffectcontroller.cpp
 SOURCES += $$PWD/hbeffectfactory.cpp
 SOURCES += $$PWD/hbeffectfxmldata.cpp
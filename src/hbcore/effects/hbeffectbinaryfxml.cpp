@@ -0,0 +1,258 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the HbCore module of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include "hbeffectbinaryfxml_p.h"
+#include "hbeffectdef_p.h"
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+
+/*
+  \class HbEffectBinaryFxml
+
+  \brief Reads and writes the precompiled binary form of fxml effect definitions.
+
+  The binary form holds the same data as HbEffectXmlParser produces from the
+  fxml document, so reading it skips the xml parsing. Durations are stored
+  in milliseconds and curve styles as QEasingCurve types, so they need no
+  string parsing when the effect is created either. Binary files are
+  recognized from their header, so a precompiled file can be installed
+  with the same name as the fxml file it replaces. Binary files are created
+  with the fxml2bin tool.
+
+  \internal
+*/
+
+// "HBFX" followed by the format version.
+static const quint32 BinaryFxmlMagic = 0x48424658;
+static const quint32 BinaryFxmlVersion = 2;
+static const int BinaryFxmlHeaderSize = 2 * sizeof(quint32);
+
+static void setupStream(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_4_6);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+}
+
+/*
+  Returns true if \a data starts with the header of a binary effect definition.
+*/
+bool HbEffectBinaryFxml::isBinary(const uchar *data, qint64 size)
+{
+    if (!data || size < BinaryFxmlHeaderSize) {
+        return false;
+    }
+    QByteArray header = QByteArray::fromRawData(reinterpret_cast<const char *>(data),
+                                                BinaryFxmlHeaderSize);
+    QDataStream stream(header);
+    setupStream(stream);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    return magic == BinaryFxmlMagic && version == BinaryFxmlVersion;
+}
+
+/*
+  Reads the binary effect definition in \a data into \a dst. The data is read
+  in place, so \a data can point directly into a memory mapped file.
+*/
+bool HbEffectBinaryFxml::read(const uchar *data, qint64 size, HbEffectFxmlData *dst)
+{
+    if (!isBinary(data, size) || !dst) {
+        return false;
+    }
+    QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char *>(data), int(size));
+    QDataStream stream(bytes);
+    setupStream(stream);
+    stream.skipRawData(BinaryFxmlHeaderSize);
+
+    HbMemoryManager::MemoryType memType = dst->memoryType();
+
+    quint32 paramCount = 0;
+    stream >> paramCount;
+    for (quint32 i = 0; i < paramCount && stream.status() == QDataStream::Ok; ++i) {
+        HbEffectFxmlParamData param(memType);
+        if (!readParam(stream, param)) {
+            return false;
+        }
+        dst->appendParamData(param);
+    }
+
+    quint32 filterCount = 0;
+    stream >> filterCount;
+    for (quint32 i = 0; i < filterCount && stream.status() == QDataStream::Ok; ++i) {
+        HbEffectFxmlFilterData filter(memType);
+        QString type;
+        QString blending;
+        quint32 filterParamCount = 0;
+        stream >> type >> blending >> filterParamCount;
+        filter.setType(type);
+        filter.setBlending(blending);
+        for (quint32 j = 0; j < filterParamCount && stream.status() == QDataStream::Ok; ++j) {
+            HbEffectFxmlParamData param(memType);
+            if (!readParam(stream, param)) {
+                return false;
+            }
+            filter.appendParamData(param);
+        }
+        dst->appendFilterData(filter);
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+/*
+  Reads \a file into \a dst if it is a binary effect definition. The file is
+  memory mapped when possible. \a isBinary is set to false and nothing is
+  read if the file is not in the binary format, so that the caller can parse
+  it as fxml instead.
+*/
+bool HbEffectBinaryFxml::readFile(QFile *file, HbEffectFxmlData *dst, bool *isBinary)
+{
+    *isBinary = false;
+    const qint64 size = file->size();
+    if (size < BinaryFxmlHeaderSize) {
+        return false;
+    }
+
+    uchar *mapped = file->map(0, size);
+    if (mapped) {
+        *isBinary = HbEffectBinaryFxml::isBinary(mapped, size);
+        bool ok = *isBinary && read(mapped, size, dst);
+        file->unmap(mapped);
+        return ok;
+    }
+
+    // Mapping is not supported e.g. for compressed resources.
+    QByteArray header = file->peek(BinaryFxmlHeaderSize);
+    *isBinary = HbEffectBinaryFxml::isBinary(
+        reinterpret_cast<const uchar *>(header.constData()), header.size());
+    if (!*isBinary) {
+        return false;
+    }
+    QByteArray contents = file->readAll();
+    return read(reinterpret_cast<const uchar *>(contents.constData()), contents.size(), dst);
+}
+
+/*
+  Writes \a data in the binary format into \a device.
+*/
+bool HbEffectBinaryFxml::write(QIODevice *device, const HbEffectFxmlData &data)
+{
+    QDataStream stream(device);
+    setupStream(stream);
+    stream << BinaryFxmlMagic << BinaryFxmlVersion;
+
+    QList<HbEffectFxmlParamData> params = data.paramData();
+    stream << quint32(params.count());
+    foreach(const HbEffectFxmlParamData & param, params) {
+        writeParam(stream, param);
+    }
+
+    QList<HbEffectFxmlFilterData> filters = data.filterData();
+    stream << quint32(filters.count());
+    foreach(const HbEffectFxmlFilterData & filter, filters) {
+        QList<HbEffectFxmlParamData> filterParams = filter.paramData();
+        stream << filter.type() << filter.blending() << quint32(filterParams.count());
+        foreach(const HbEffectFxmlParamData & param, filterParams) {
+            writeParam(stream, param);
+        }
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+void HbEffectBinaryFxml::writeParam(QDataStream &stream, const HbEffectFxmlParamData &param)
+{
+    stream << param.name() << param.getValue()
+           << qint32(param.durationMsecs()) << qint32(param.curveShape())
+           << param.startRef() << param.endRef()
+           << param.loopStart() << param.loopEnd();
+
+    // The style is stored resolved above.
+    QList<HbEffectFxmlAttrListEntry> attributes;
+    foreach(const HbEffectFxmlAttrListEntry & attr, param.mAttributes) {
+        if (attr.mKey != QLatin1String(FXML_STYLE)) {
+            attributes.append(attr);
+        }
+    }
+    stream << quint32(attributes.count());
+    foreach(const HbEffectFxmlAttrListEntry & attr, attributes) {
+        stream << QString(attr.mKey) << QString(attr.mValue);
+    }
+
+    stream << quint32(param.mKeyFrames.count());
+    foreach(const HbKeyFrame & keyFrame, param.mKeyFrames) {
+        stream << keyFrame.pos << keyFrame.val << QString(keyFrame.stringValue);
+    }
+}
+
+bool HbEffectBinaryFxml::readParam(QDataStream &stream, HbEffectFxmlParamData &param)
+{
+    QString name;
+    QString value;
+    qint32 durationMsecs;
+    qint32 curveShape;
+    QString startRef;
+    QString endRef;
+    float loopStart;
+    float loopEnd;
+    stream >> name >> value >> durationMsecs >> curveShape
+           >> startRef >> endRef >> loopStart >> loopEnd;
+    param.setName(name);
+    param.setValue(value);
+    param.setDurationMsecs(durationMsecs);
+    param.setCurveShape(curveShape);
+    param.setStartRef(startRef);
+    param.setEndRef(endRef);
+    param.setLoopStart(loopStart);
+    param.setLoopEnd(loopEnd);
+
+    quint32 attrCount = 0;
+    stream >> attrCount;
+    for (quint32 i = 0; i < attrCount && stream.status() == QDataStream::Ok; ++i) {
+        QString key;
+        QString attrValue;
+        stream >> key >> attrValue;
+        param.setAttribute(key, attrValue);
+    }
+
+    quint32 keyFrameCount = 0;
+    stream >> keyFrameCount;
+    for (quint32 i = 0; i < keyFrameCount && stream.status() == QDataStream::Ok; ++i) {
+        HbKeyFrame keyFrame(param.memoryType());
+        QString stringValue;
+        stream >> keyFrame.pos >> keyFrame.val >> stringValue;
+        if (!stringValue.isEmpty()) {
+            keyFrame.stringValue = stringValue;
+        }
+        param.append(keyFrame);
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
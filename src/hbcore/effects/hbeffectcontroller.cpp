@@ -26,6 +26,7 @@
 #include "hbeffectcontroller_p.h"
 #include "hbeffectfxmldata_p.h"
 #include "hbeffectxmlparser_p.h"
+#include "hbeffectbinaryfxml_p.h"
 #include "hbeffectdef_p.h"
 #include "hbeffecttheme_p.h"
 #include "hbinstance.h"
@@ -259,6 +260,24 @@ bool HbEffectController::addEffectDefinitionFile(
             }
             return false;
         }
+
+        // Precompiled effect definitions are read directly from the file mapping.
+        bool isBinary = false;
+        bool binaryRead = HbEffectBinaryFxml::readFile(&file, &fxmlData, &isBinary);
+        if (isBinary) {
+            file.close();
+            if (!binaryRead) {
+                qWarning("HbEffect: Reading of binary effect %s failed", qPrintable(filePath));
+                if (indexForSetInUseWhenFail >= 0) {
+                    mEffectEntries[indexForSetInUseWhenFail].mInUse = true;
+                }
+                return false;
+            }
+            effectEntry.setEffectData(fxmlData);
+            mEffectEntries.append(effectEntry);
+            return true;
+        }
+
         QByteArray arr(file.readAll());
         file.close();
 
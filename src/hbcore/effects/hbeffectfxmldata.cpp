@@ -24,9 +24,12 @@
 ****************************************************************************/
 
 #include "hbeffectfxmldata_p.h"
+#include "hbeffectdef_p.h"
+#include <QEasingCurve>
 #include <QDebug>
 
 static const float LoopUndefined = -1;
+static const qint32 Unresolved = -1;
 
 // 0.0 is min allowed value but comparing it to this value for fuzzy comparison
 static const float LoopMinDefined = -0.00001f;
@@ -128,6 +131,8 @@ HbEffectFxmlParamData::HbEffectFxmlParamData(HbMemoryManager::MemoryType memType
       mEndVal(memType),
       mLoopStart(LoopUndefined),
       mLoopEnd(LoopUndefined),
+      mDurationMsecs(Unresolved),
+      mCurveShape(Unresolved),
       mAttributes(memType),
       mKeyFrames(memType)
 {
@@ -155,6 +160,61 @@ QString HbEffectFxmlParamData::duration() const
 void HbEffectFxmlParamData::setDuration(const QString &value)
 {
     mDuration = value;
+    mDurationMsecs = Unresolved;
+}
+
+int HbEffectFxmlParamData::durationMsecs() const
+{
+    if (mDurationMsecs != Unresolved) {
+        return mDurationMsecs;
+    }
+    QString string = duration();
+    if (!string.isEmpty()) {
+        bool ok = false;
+        qreal value = string.toFloat(&ok);
+        if (ok) {
+            return (int)(value * 1000); // convert to milliseconds
+        }
+    }
+    return Unresolved;
+}
+
+void HbEffectFxmlParamData::setDurationMsecs(int value)
+{
+    mDurationMsecs = value;
+}
+
+int HbEffectFxmlParamData::curveShape() const
+{
+    if (mCurveShape != Unresolved) {
+        return mCurveShape;
+    }
+    QString style = getAttribute(FXML_STYLE);
+    if (style == FXML_KEYWORD_STYLE_LINEAR) {
+        return QEasingCurve::Linear;
+    } else if (style == FXML_KEYWORD_STYLE_INQUAD) {
+        return QEasingCurve::InQuad;
+    } else if (style == FXML_KEYWORD_STYLE_OUTQUAD) {
+        return QEasingCurve::OutQuad;
+    } else if (style == FXML_KEYWORD_STYLE_INOUTQUAD) {
+        return QEasingCurve::InOutQuad;
+    } else if (style == FXML_KEYWORD_STYLE_OUTINQUAD) {
+        return QEasingCurve::OutInQuad;
+    } else if (style == FXML_KEYWORD_STYLE_INBACK) {
+        return QEasingCurve::InBack;
+    } else if (style == FXML_KEYWORD_STYLE_OUTBACK) {
+        return QEasingCurve::OutBack;
+    } else if (style == FXML_KEYWORD_STYLE_INOUTBACK) {
+        return QEasingCurve::InOutBack;
+    } else if (style == FXML_KEYWORD_STYLE_OUTINBACK) {
+        return QEasingCurve::OutInBack;
+    }
+    return Unresolved;
+}
+
+void HbEffectFxmlParamData::setCurveShape(int value)
+{
+    mCurveShape = value;
 }
 
 QString HbEffectFxmlParamData::getAttribute(const QString &attrName) const
@@ -169,6 +229,9 @@ QString HbEffectFxmlParamData::getAttribute(const QString &attrName) const
 
 void HbEffectFxmlParamData::setAttribute(const QString &attrName, const QString &value)
 {
+    if (attrName == FXML_STYLE) {
+        mCurveShape = Unresolved;
+    }
     for (int i = 0, ie = mAttributes.count(); i != ie; ++i) {
         if (mAttributes.at(i).mKey == attrName) {
             mAttributes[i].mValue = value;
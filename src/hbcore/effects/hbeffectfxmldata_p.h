@@ -64,6 +64,14 @@ public:
     QString duration() const;
     void setDuration(const QString &value);
 
+    // Duration in milliseconds and QEasingCurve::Type of the param, -1 when
+    // not defined. Resolved from the duration and the "style" attribute
+    // unless set directly, as done for precompiled effects.
+    int durationMsecs() const;
+    void setDurationMsecs(int value);
+    int curveShape() const;
+    void setCurveShape(int value);
+
     // Attributes of the param
     QString getAttribute(const QString &attrName) const;
     void setAttribute(const QString &attrName, const QString &value);
@@ -102,8 +110,12 @@ private:
     HbString mEndVal;
     float mLoopStart;
     float mLoopEnd;
+    qint32 mDurationMsecs;
+    qint32 mCurveShape;
     HbVector<HbEffectFxmlAttrListEntry> mAttributes; // e.g. style="linear" becomes key="style", value="linear"
     HbVector<HbKeyFrame> mKeyFrames;
+
+    friend class HbEffectBinaryFxml;
 };
 
 class HB_CORE_PRIVATE_EXPORT HbEffectFxmlFilterData
@@ -240,40 +240,16 @@ qreal HbEffectUtils::resolveFxmlRef(
 
 void HbEffectUtils::resolveFxmlCurveShape(QEasingCurve &curve, const HbEffectFxmlParamData &data)
 {
-    QString style = data.getAttribute(FXML_STYLE);
-
-    if (!style.isEmpty()) {
-        if (style == FXML_KEYWORD_STYLE_LINEAR) {
-            curve = QEasingCurve::Linear;
-        } else if (style == FXML_KEYWORD_STYLE_INQUAD) {
-            curve = QEasingCurve::InQuad;
-        } else if (style == FXML_KEYWORD_STYLE_OUTQUAD) {
-            curve = QEasingCurve::OutQuad;
-        } else if (style == FXML_KEYWORD_STYLE_INOUTQUAD) {
-            curve = QEasingCurve::InOutQuad;
-        } else if (style == FXML_KEYWORD_STYLE_OUTINQUAD) {
-            curve = QEasingCurve::OutInQuad;
-        } else if (style == FXML_KEYWORD_STYLE_INBACK) {
-            curve = QEasingCurve::InBack;
-        } else if (style == FXML_KEYWORD_STYLE_OUTBACK) {
-            curve = QEasingCurve::OutBack;
-        } else if (style == FXML_KEYWORD_STYLE_INOUTBACK) {
-            curve = QEasingCurve::InOutBack;
-        } else if (style == FXML_KEYWORD_STYLE_OUTINBACK) {
-            curve = QEasingCurve::OutInBack;
-        }
+    int shape = data.curveShape();
+    if (shape >= 0) {
+        curve = QEasingCurve::Type(shape);
     }
 }
 
 void HbEffectUtils::resolveFxmlDuration(int &duration, const HbEffectFxmlParamData &data)
 {
-    QString string = data.duration();
-
-    if (!string.isEmpty()) {
-        bool ok = false;
-        qreal value = string.toFloat(&ok);
-        if (ok) {
-            duration = (int)(value * 1000); // convert to milliseconds
-        }
+    int msecs = data.durationMsecs();
+    if (msecs >= 0) {
+        duration = msecs;
     }
 }
@@ -35,10 +35,16 @@
 #include <QtDebug>
 #include <QList>
 #include <QCoreApplication>
+#include <QPointer>
+#include <QBasicTimer>
+#include <QTimerEvent>
 
 static int instantRunningIndex;
 static int continuousRunningIndex;
 
+// Continuous interaction deltas are delivered to the engines at most once in this interval.
+static const int KContinuousFrameInterval = 16; // ms
+
 /*!
     @beta
     @hbcore
@@ -58,9 +64,30 @@ class HbFeedbackManagerPrivate : public QObject
 public:
     HbFeedbackManagerPrivate();
     ~HbFeedbackManagerPrivate();
+
+    void queueContinuous(const HbWidget *widget, Hb::ContinuousInteraction interaction, const QPointF &delta);
+    void flushContinuous(const HbWidget *widget, Hb::ContinuousInteraction interaction);
+    void flushContinuous();
+
+protected:
+    void timerEvent(QTimerEvent *event);
+
+private:
+    void sendContinuous(int index);
+
 public:
     HbFeedbackPluginGroup* pluginGroup;
     QList <HbFeedbackEngine*> engines;
+
+private:
+    // deltas of the ongoing continuous interactions since the last delivery
+    struct PendingContinuous {
+        QPointer<HbWidget> widget;
+        Hb::ContinuousInteraction interaction;
+        QPointF delta;
+    };
+    QList<PendingContinuous> pending;
+    QBasicTimer frameTimer;
 };
 
 HbFeedbackManagerPrivate::HbFeedbackManagerPrivate()
@@ -74,6 +101,79 @@ HbFeedbackManagerPrivate::~HbFeedbackManagerPrivate()
     engines.clear();
 }
 
+/*
+    Adds \a delta to the pending delta of the same widget and interaction. The
+    sum is handed to the engines with the next frame.
+*/
+void HbFeedbackManagerPrivate::queueContinuous(const HbWidget *widget, Hb::ContinuousInteraction interaction, const QPointF &delta)
+{
+    for (int i = 0; i < pending.count(); ++i) {
+        PendingContinuous &entry = pending[i];
+        if (entry.widget == widget && entry.interaction == interaction) {
+            entry.delta += delta;
+            return;
+        }
+    }
+
+    PendingContinuous entry;
+    entry.widget = const_cast<HbWidget *>(widget);
+    entry.interaction = interaction;
+    entry.delta = delta;
+    pending.append(entry);
+
+    if (!frameTimer.isActive()) {
+        frameTimer.start(KContinuousFrameInterval, this);
+    }
+}
+
+/*
+    Delivers the pending delta of \a widget and \a interaction right away,
+    so that it reaches the engines before the interaction is stopped.
+*/
+void HbFeedbackManagerPrivate::flushContinuous(const HbWidget *widget, Hb::ContinuousInteraction interaction)
+{
+    for (int i = 0; i < pending.count(); ++i) {
+        const PendingContinuous &entry = pending.at(i);
+        if (entry.widget == widget && entry.interaction == interaction) {
+            sendContinuous(i);
+            break;
+        }
+    }
+    if (pending.isEmpty()) {
+        frameTimer.stop();
+    }
+}
+
+void HbFeedbackManagerPrivate::flushContinuous()
+{
+    frameTimer.stop();
+    while (!pending.isEmpty()) {
+        sendContinuous(0);
+    }
+}
+
+void HbFeedbackManagerPrivate::sendContinuous(int index)
+{
+    PendingContinuous entry = pending.takeAt(index);
+    // the widget may have been deleted since it reported the interaction
+    if (entry.widget && !entry.widget->testAttribute(Hb::InteractionDisabled)) {
+        HbContinuousInteractionEvent event(HbContinuousInteractionEvent::ContinuousInteraction,
+                                           entry.widget, entry.interaction, entry.delta);
+        foreach (HbFeedbackEngine* engine, engines) {
+            QCoreApplication::sendEvent(engine, &event);
+        }
+    }
+}
+
+void HbFeedbackManagerPrivate::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() == frameTimer.timerId()) {
+        flushContinuous();
+    } else {
+        QObject::timerEvent(event);
+    }
+}
+
 void removePlugins() {
     HbFeedbackManager* manager = HbFeedbackManager::instance();
     if (manager) {
@@ -124,6 +224,8 @@ void HbFeedbackManager::triggered(const HbWidget *widget, Hb::InstantInteraction
 {
     if (widget) {
         if (!widget->testAttribute(Hb::InteractionDisabled)) {
+            // deliver the continuous deltas reported before this trigger first
+            d->flushContinuous();
             HbInstantInteractionEvent event(widget, interaction, modifiers);
             foreach (HbFeedbackEngine* engine, d->engines) {
                 QCoreApplication::sendEvent(engine, &event);
@@ -137,6 +239,11 @@ void HbFeedbackManager::triggered(const HbWidget *widget, Hb::InstantInteraction
 /*!
     Mediates continuous interaction triggers to all active feedback engine plugins.
 
+    The triggers are not delivered immediately. The deltas of the same widget and
+    interaction are summed up, and the engines receive one event with the sum
+    per frame. A stop of the interaction delivers its pending delta first, and an
+    instant trigger delivers all pending deltas first.
+
     \param widget the widget being interacted with
     \param interaction the continuous interaction in progress
     \param delta the direction and distance of the continuous interaction
@@ -144,11 +251,8 @@ void HbFeedbackManager::triggered(const HbWidget *widget, Hb::InstantInteraction
 void HbFeedbackManager::continuousTriggered(const HbWidget *widget, Hb::ContinuousInteraction interaction, QPointF delta)
 {
     if (widget) {
-        if (!widget->testAttribute(Hb::InteractionDisabled)) {
-            HbContinuousInteractionEvent event(HbContinuousInteractionEvent::ContinuousInteraction, widget, interaction, delta);
-            foreach (HbFeedbackEngine* engine, d->engines) {
-                QCoreApplication::sendEvent(engine, &event);
-            }
+        if (!widget->testAttribute(Hb::InteractionDisabled) && !d->engines.isEmpty()) {
+            d->queueContinuous(widget, interaction, delta);
         }
     } else {
         qWarning("HbFeedbackManager::continuousTriggered: Attempt to stop a continuous interaction trigger with null widget pointer");
@@ -165,6 +269,7 @@ void HbFeedbackManager::continuousTriggered(const HbWidget *widget, Hb::Continuo
 void HbFeedbackManager::continuousStopped(const HbWidget *widget, Hb::ContinuousInteraction interaction)
 {
     if (widget) {
+        d->flushContinuous(widget, interaction);
         if (!widget->testAttribute(Hb::InteractionDisabled)) {
             HbContinuousInteractionEvent event(HbContinuousInteractionEvent::ContinuousInteractionStop, widget, interaction);
             foreach (HbFeedbackEngine* engine, d->engines) {
@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "hbpointrecorder_p.h"
+#include "hbgestures_p.h"
 
 #include <QPair>
 #include <QDebug>
@@ -42,6 +43,15 @@
 
    \brief Class to store and hold list of points and timestamps.
 
+   The points are kept in a fixed size circular buffer, so recording a point
+   does not allocate memory.
+
+   The recorder also keeps the velocity window: the newest point that is at
+   least HbVelocitySampleTime older than the last one, and the running sums
+   of displacement and time from there to the last point. The sums are
+   updated when a point is added and when the first point of the window
+   expires, so HbVelocityCalculator does not need to walk the points.
+
 */
 
 /*!
@@ -52,7 +62,12 @@
 */
 HbPointRecorder::HbPointRecorder()
     :
-    mThreshold(0)
+    mThreshold(0),
+    mFirst(0),
+    mCount(0),
+    mWindowFirst(0),
+    mWindowDelta(0),
+    mWindowTime(0)
 {
 }
 
@@ -74,7 +89,52 @@ HbPointRecorder::~HbPointRecorder()
 void HbPointRecorder::resetRecorder(qreal threshold)
 {
     mThreshold = threshold;
-    mPoints.clear();
+    mFirst = 0;
+    mCount = 0;
+    mWindowFirst = 0;
+    mWindowDelta = 0;
+    mWindowTime = 0;
+}
+
+/*!
+    \internal
+    \brief Drops the first point of the velocity window from the running sums.
+*/
+void HbPointRecorder::expireWindowFirst()
+{
+    const HbPointTime &first = at(mWindowFirst);
+    const HbPointTime &next = at(mWindowFirst + 1);
+    mWindowDelta -= next.first - first.first;
+    mWindowTime -= next.second - first.second;
+    ++mWindowFirst;
+}
+
+/*!
+    \internal
+    \brief Appends point to the buffer, dropping the oldest point when the buffer is full.
+*/
+void HbPointRecorder::append(const HbPointTime &point)
+{
+    if (mCount > 0) {
+        mWindowDelta += point.first - lastPoint();
+        mWindowTime += point.second - lastTime();
+    }
+    if (mCount == HbPointRecorderCapacity) {
+        if (mWindowFirst == 0) {
+            expireWindowFirst();
+        }
+        --mWindowFirst;
+        mPoints[mFirst] = point;
+        mFirst = (mFirst + 1) & (HbPointRecorderCapacity - 1);
+    } else {
+        mPoints[(mFirst + mCount) & (HbPointRecorderCapacity - 1)] = point;
+        ++mCount;
+    }
+    // Keep only one point that is older than the sample time in the window.
+    while (mWindowFirst + 1 < mCount
+           && point.second - at(mWindowFirst + 1).second >= HbVelocitySampleTime) {
+        expireWindowFirst();
+    }
 }
 
 /*!
@@ -93,7 +153,7 @@ void HbPointRecorder::record(qreal point, qint64 time)
 #endif
 
     // Empty list always accepts first point without tests.
-    if ( !mPoints.isEmpty() ) {
+    if ( !isEmpty() ) {
         // No point to record a point, if timestamp is less or equal with previous.
         if ( time - lastTime() <= 0 ) {
             DEBUG() << "Ignoring point, because no difference in time stamps.";
@@ -110,21 +170,23 @@ void HbPointRecorder::record(qreal point, qint64 time)
     // In case the list contains two or more points, direction can be
     // determined. Each new point added needs to be checked for direction
     // change.
-    if ( mPoints.length() > 1 ) {
+    if ( mCount > 1 ) {
         // Clear list, on direction change. Leave the last recorded point
         // to the list, as it can be considered as first point for new direction.
         if ( dirChanged( point ) ) {
-            HbPointTime temp = mPoints.last();
-            mPoints.clear();
-            mPoints.append(temp);
+            mFirst = (mFirst + mCount - 1) & (HbPointRecorderCapacity - 1);
+            mCount = 1;
+            mWindowFirst = 0;
+            mWindowDelta = 0;
+            mWindowTime = 0;
         }
     }
 
     // Finally check, if the position has changed. Don't record point, when no position
     // change.
-    if ( mPoints.isEmpty() || point != lastPoint() ) {
+    if ( isEmpty() || point != lastPoint() ) {
         // Add point and time to list.
-        mPoints.append(HbPointTime(point, time));
+        append(HbPointTime(point, time));
     } else {
         DEBUG() << "Ignoring point, because it equals previous.";
     }
@@ -138,8 +200,8 @@ void HbPointRecorder::record(qreal point, qint64 time)
 */
 qreal HbPointRecorder::lastPoint() const
 {
-    Q_ASSERT(!mPoints.isEmpty());
-    return mPoints.last().first;
+    Q_ASSERT(!isEmpty());
+    return at(mCount - 1).first;
 }
 
 /*!
@@ -150,8 +212,8 @@ qreal HbPointRecorder::lastPoint() const
 */
 qint64 HbPointRecorder::lastTime() const
 {
-    Q_ASSERT(!mPoints.isEmpty());
-    return mPoints.last().second;
+    Q_ASSERT(!isEmpty());
+    return at(mCount - 1).second;
 }
 
 /*!
@@ -162,13 +224,13 @@ qint64 HbPointRecorder::lastTime() const
 */
 bool HbPointRecorder::dirChanged( qreal point ) const
 {
-    int len = mPoints.length();
+    int len = mCount;
 
     // Without direction, the direction cannot really change
     if ( len < 2 ) { return false; }
 
-    qreal pos0 = mPoints.at(len-2).first;
-    qreal pos1 = mPoints.at(len-1).first;
+    qreal pos0 = at(len-2).first;
+    qreal pos1 = at(len-1).first;
     qreal dir0 = pos1 - pos0;
     qreal dir1 = point - pos1;
 
@@ -187,6 +249,10 @@ bool HbPointRecorder::dirChanged( qreal point ) const
 */
 QList<HbPointTime> HbPointRecorder::getLastRecords( int number ) const
 {
-    number = qMin(number, mPoints.count());
-    return mPoints.mid(mPoints.count() - number);
+    number = qMin(number, mCount);
+    QList<HbPointTime> records;
+    for (int i = mCount - number; i < mCount; ++i) {
+        records.append(at(i));
+    }
+    return records;
 }
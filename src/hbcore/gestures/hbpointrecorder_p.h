@@ -35,6 +35,11 @@
 
 typedef QPair<qreal, qint64> HbPointTime;
 
+// Capacity of the point recorder. Must be a power of two. Only the points of
+// the last HbVelocitySampleTime milliseconds are needed for the velocity, and
+// the recorder keeps at most one point per millisecond.
+const int HbPointRecorderCapacity = 128;
+
 class HB_CORE_PRIVATE_EXPORT HbPointRecorder
 {
 public:
@@ -49,12 +54,34 @@ public:
     bool dirChanged(qreal point) const;
     QList<HbPointTime> getLastRecords( int number ) const;
 
-    int count() const { return mPoints.count(); }
-    bool isEmpty() const { return mPoints.isEmpty(); }
-    HbPointTime at(int i) const { return mPoints.at(i); }
+    int count() const { return mCount; }
+    bool isEmpty() const { return mCount == 0; }
+    const HbPointTime &at(int i) const
+    {
+        Q_ASSERT(i >= 0 && i < mCount);
+        return mPoints[(mFirst + i) & (HbPointRecorderCapacity - 1)];
+    }
+
+    // The velocity window: the index of its first point and the displacement
+    // and time from that point to the newest one.
+    int windowFirst() const { return mWindowFirst; }
+    qreal windowDelta() const { return mWindowDelta; }
+    qint64 windowTime() const { return mWindowTime; }
 
     qreal mThreshold;
-    QList<HbPointTime> mPoints;
+
+private:
+    void append(const HbPointTime &point);
+    void expireWindowFirst();
+
+    // Circular buffer, the oldest points are overwritten when it is full.
+    HbPointTime mPoints[HbPointRecorderCapacity];
+    int mFirst;
+    int mCount;
+
+    int mWindowFirst;
+    qreal mWindowDelta;
+    qint64 mWindowTime;
 };
 
 inline uint qHash(const qreal)
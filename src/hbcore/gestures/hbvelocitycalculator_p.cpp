@@ -98,19 +98,24 @@ qreal HbVelocityCalculator::calculate_velocity(
         return 0.0;
     }
 
-    // Accumulate the distance from previous point until we have sufficient sample
-    qreal delta = 0.0;
-    qint64 timeDelta = 0;
-    int i = list.count();
-    while (timeDelta < HbVelocitySampleTime && i > 0) {
-        i--;
-        timeDelta = currentTime - list.at(i).second;
+    // The recorder keeps the sums for a window that ends at the last point.
+    // Extend it to currentTime, which only needs to drop the points that have
+    // aged past the sample time since the last point was recorded. Callers
+    // normally pass the time of the last point, so nothing is dropped.
+    qreal delta = list.windowDelta();
+    qint64 timeDelta = list.windowTime() + currentTime - list.lastTime();
+    for (int i = list.windowFirst(); i + 1 < list.count(); ++i) {
+        const HbPointTime &next = list.at(i + 1);
+        if (currentTime - next.second < HbVelocitySampleTime) {
+            break;
+        }
+        const HbPointTime &first = list.at(i);
+        delta -= next.first - first.first;
+        timeDelta -= next.second - first.second;
     }
     if(timeDelta <= 0) {
         return 0.0;
     }
 
-    delta = list.lastPoint() - list.at(i).first;
-
     return delta / (qreal)(timeDelta);
 }
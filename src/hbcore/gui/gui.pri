@@ -81,6 +81,7 @@ PRIVATE_HEADERS += $$PWD/hbwidgetbase_p.h
 PRIVATE_HEADERS += $$PWD/hbwidgetsequentialshow_p.h
 PRIVATE_HEADERS += $$PWD/hbnativewindow_sym_p.h
 PRIVATE_HEADERS += $$PWD/hbsplash_p.h
+PRIVATE_HEADERS += $$PWD/hbsplashcodec_p.h
 PRIVATE_HEADERS += $$PWD/hbsplash_direct_symbian_p.h
 PRIVATE_HEADERS += $$PWD/hbfadeitem_p.h
 PRIVATE_HEADERS += $$PWD/hbcontentwidget_p.h
@@ -125,6 +126,7 @@ SOURCES += $$PWD/hbwidget.cpp
 SOURCES += $$PWD/hbwidgetbase.cpp
 SOURCES += $$PWD/hbwidgetsequentialshow.cpp
 SOURCES += $$PWD/hbsplash.cpp
+SOURCES += $$PWD/hbsplashcodec.cpp
 SOURCES += $$PWD/hbsplashscreen.cpp
 SOURCES += $$PWD/hbfadeitem.cpp
 SOURCES += $$PWD/hbcontentwidget.cpp
@@ -1168,8 +1168,10 @@ void HbMainWindow::scrollContentsBy(int dx, int dy)
 /*!
     Broadcasts \a eventType into all widgets in the scene.
 
-    Visible widgets will receive the event synchronously and invisble widgets
-    asynchronously.
+    The current view and its children receive the event synchronously. The other
+    widgets receive it asynchronously, the most visible ones first and invisible widgets
+    last. The asynchronous part is split into slices, so that the event loop keeps
+    running while a large number of widgets is informed.
 
     If the receiving widget has abstract items as child items, these will be informed
     after the widget has received the event.
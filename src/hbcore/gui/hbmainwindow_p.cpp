@@ -55,6 +55,8 @@
 #include <QGraphicsLayout>
 #include <QLocale>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QPair>
 
 #ifdef Q_OS_SYMBIAN
 #include "hbnativewindow_sym_p.h"
@@ -83,6 +85,7 @@ const int QVga_res = 76800;
 // Setting for resizing by dragging
 bool HbMainWindowPrivate::dragToResizeEnabled = false;
 bool HbMainWindowPrivate::initializeInputs = true;
+int HbMainWindowPrivate::broadcastSliceBudget = -1;
 
 HbMainWindowPrivate::HbMainWindowPrivate() :
     mScene(0),
@@ -109,6 +112,7 @@ HbMainWindowPrivate::HbMainWindowPrivate() :
     mCurrentDockWidget(0),
     mVisibleItems(Hb::AllItems),
     mForceSetOrientation(false),
+    mBroadcastDepth(0),
     mDelayedConstructionHandled(false),
     q_ptr(0),
     mTheTestUtility(0),
@@ -886,46 +890,39 @@ void HbMainWindowPrivate::_q_themeChanged()
     broadcastEvent(HbEvent::ThemeChanged);
 }
 
-static void informWidget(HbMainWindowPrivate::BroadcastItem &bcItem, QGraphicsWidget *widget);
-
 /*
-    Sends event of \eventType to all items in the \inform list
-    excluding ones in the \a ignoreItems list.
-
-    Invible widgets will be added onto \deferredItems list which will be
-    informed asynchronously.
+    Returns how much of \a item is visible on \a screen, used to order the
+    root items of a broadcast.
 */
-static void informItems(HbMainWindowPrivate::BroadcastItem &bcItem, QList<QGraphicsItem *> &inform)
-{
-    if (inform.count()) {
-        foreach(QGraphicsItem * item, inform) {
-            if (item->isWidget()) {
-                QGraphicsWidget *widget = static_cast<QGraphicsWidget *>(item);
-                if (item->isVisible()) {
-                    informWidget(bcItem, widget);
-                } else {
-                    bcItem.mPending.append(QPointer<QGraphicsWidget>(widget));
-                }
-            }
-        }
+static qreal prominence(QGraphicsItem *item, const QRectF &screen)
+{
+    if (!item->isVisible()) {
+        return -1;
     }
+    QRectF visible = item->sceneBoundingRect() & screen;
+    return visible.width() * visible.height();
 }
 
-/*
-    Sends event of \eventType to \a widget.
+static bool moreProminent(const QPair<qreal, QGraphicsItem *> &a, const QPair<qreal, QGraphicsItem *> &b)
+{
+    return a.first > b.first;
+}
 
-    If the \a widget does not consume the event, it will be delivered to it's children.
+/*
+    Returns the time in milliseconds after which a slice of a broadcast yields to
+    the event loop. It can be set with the HB_BROADCAST_SLICE environment
+    variable, 0 meaning no limit.
 */
-static void informWidget(HbMainWindowPrivate::BroadcastItem &bcItem, QGraphicsWidget *widget)
+static int broadcastSliceBudget()
 {
-    QApplication::sendEvent(widget, bcItem.mEvent);
-
-    // go through child items
-    QList<QGraphicsItem *> children = widget->childItems();
-    informItems(bcItem, children);
+    if (HbMainWindowPrivate::broadcastSliceBudget < 0) {
+        bool ok(false);
+        int budget = qgetenv("HB_BROADCAST_SLICE").toInt(&ok);
+        HbMainWindowPrivate::broadcastSliceBudget = ok && budget >= 0 ? budget : 16;
+    }
+    return HbMainWindowPrivate::broadcastSliceBudget;
 }
 
-
 /*
     Broadcasts event of type \a eventType into all widgets in the scene.
 
@@ -942,10 +939,14 @@ void HbMainWindowPrivate::broadcastEvent(int eventType)
     Broadcasts \a event into all widgets in the scene.
 
     First the high priotity widgets are informed. Currently, the active view is treated as
-    a priority item and it will receive the event first.
-
-    Invisible child items are added into mPending array which will be handled
-    asynchronously.
+    a priority item and it is informed synchronously together with its children. The root
+    items of the scene follow in the order of how much of them is visible on the screen.
+    Only the root items are ordered, the visible children of a widget are informed right
+    after it in their own order and invisible ones after all the visible widgets.
+
+    Everything except the priority item is informed asynchronously, in slices of at most
+    broadcastSliceBudget milliseconds. broadcastFinished() is emitted when every widget
+    has got the event.
 */
 void HbMainWindowPrivate::broadcastEvent(QEvent *event)
 {
@@ -955,49 +956,151 @@ void HbMainWindowPrivate::broadcastEvent(QEvent *event)
     bool previousEvent(mBroadcastItems.contains(type));
 
     BroadcastItem &broadcastItem = mBroadcastItems[type];
-    broadcastItem.mEvent = event;
 
     // cancel previous requests
     if (previousEvent) {
-        mBroadcastItems[type].mPending.clear();
+        releaseBroadcastEvent(broadcastItem.mEvent);
+        broadcastItem.mPending.clear();
+    }
+    broadcastItem.mEvent = event;
+    broadcastItem.mPriorityItem = q->currentView();
+
+    // the priority item is informed right away, without a budget
+    if (broadcastItem.mPriorityItem) {
+        broadcastItem.mPending.append(broadcastItem.mPriorityItem);
+        if (!informPendingWidgets(type, 0)) {
+            return;
+        }
+    }
+
+    // then the root items in the scene, the most visible ones first
+    QRectF screen = q->mapToScene(q->viewport()->rect()).boundingRect();
+    QList<QPair<qreal, QGraphicsItem *> > rootItems;
+    foreach(QGraphicsItem * item, mScene->items()) {
+        if (!item->parentItem() && item->isWidget()) {
+            rootItems.append(qMakePair(prominence(item, screen), item));
+        }
+    }
+    qStableSort(rootItems.begin(), rootItems.end(), moreProminent);
+    QList<QGraphicsWidgetPtr> &pending = mBroadcastItems[type].mPending;
+    for (int i = 0; i < rootItems.count(); ++i) {
+        pending.append(static_cast<QGraphicsWidget *>(rootItems.at(i).second));
     }
 
-    // create high priority items
-    QList<QGraphicsItem *> priorityItems;
-    if (type == HbEvent::ThemeChanged) {
-        if (q->currentView()) {
-            priorityItems.append(q->currentView());
+    finishBroadcastSlice(type);
+}
+
+/*
+    Sends \a event of \a type to \a widget. Its visible children are put at the front of
+    the mPending array of the broadcast, so that they are informed next, and invisible
+    children at the end.
+
+    Returns false if the broadcast was cancelled by a new one of the same type while the
+    event was being delivered.
+*/
+bool HbMainWindowPrivate::informWidget(int type, QEvent *event, QGraphicsWidget *widget,
+                                       QGraphicsWidget *priorityItem)
+{
+    QGraphicsWidgetPtr widgetPtr(widget);
+
+    ++mBroadcastDepth;
+    QApplication::sendEvent(widget, event);
+    --mBroadcastDepth;
+
+    // the receiver may have started a new broadcast, so the broadcast item is looked up again
+    QMap<int, BroadcastItem>::iterator it = mBroadcastItems.find(type);
+    bool current = it != mBroadcastItems.end() && it->mEvent == event;
+    if (!mBroadcastDepth) {
+        // no event is being delivered anymore
+        qDeleteAll(mRetiredBroadcastEvents);
+        mRetiredBroadcastEvents.clear();
+    }
+    if (!current) {
+        return false;
+    }
+    if (widgetPtr.isNull()) {
+        return true;
+    }
+
+    // queue the child items
+    int visibleCount = 0;
+    foreach(QGraphicsItem * item, widget->childItems()) {
+        if (item->isWidget() && item != priorityItem) {
+            QGraphicsWidget *child = static_cast<QGraphicsWidget *>(item);
+            if (child->isVisible()) {
+                it->mPending.insert(visibleCount++, child);
+            } else {
+                it->mPending.append(child);
+            }
         }
     }
+    return true;
+}
 
-    // inform prority items now
-    informItems(broadcastItem, priorityItems);
+/*
+    Informs the items in the mPending array of the broadcast of \a type until the array
+    is empty or \a budget milliseconds have passed, 0 meaning no limit.
 
-    // inform root items in the scene
-    QList<QGraphicsItem *> sceneItems = mScene->items();
-    QList<QGraphicsItem *> rootItems;
-    foreach(QGraphicsItem * item, sceneItems) {
-        if (!item->parentItem() && !priorityItems.contains(item)) {
-            rootItems.append(item);
+    Returns false if the broadcast was cancelled by a new one of the same type.
+*/
+bool HbMainWindowPrivate::informPendingWidgets(int type, int budget)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for (;;) {
+        BroadcastItem &broadcastItem = mBroadcastItems[type];
+        if (broadcastItem.mPending.isEmpty()
+            || (budget > 0 && timer.elapsed() >= budget)) {
+            return true;
+        }
+        QGraphicsWidgetPtr widget = broadcastItem.mPending.takeFirst();
+        if (widget.isNull()) {
+            continue;
         }
+        if (!informWidget(type, broadcastItem.mEvent, widget.data(), broadcastItem.mPriorityItem.data())) {
+            return false;
+        }
+    }
+}
+
+/*
+    Deletes \a event of a finished or cancelled broadcast, or leaves it until the
+    outermost sendEvent() returns if an event is being delivered.
+*/
+void HbMainWindowPrivate::releaseBroadcastEvent(QEvent *event)
+{
+    if (mBroadcastDepth) {
+        mRetiredBroadcastEvents.append(event);
+    } else {
+        delete event;
     }
-    informItems(broadcastItem, rootItems);
+}
+
+/*
+    Schedules the next slice of the broadcast of \a type if there are items left,
+    otherwise removes the broadcast item.
+*/
+void HbMainWindowPrivate::finishBroadcastSlice(int type)
+{
+    Q_Q(HbMainWindow);
 
-    // create asynchronous broadcast loop if needed.
+    BroadcastItem &broadcastItem = mBroadcastItems[type];
     if (broadcastItem.mPending.count()) {
-        Q_Q(HbMainWindow);
+        // create asynchronous broadcast loop
         QMetaObject::invokeMethod(q, "_q_continueBroadcasting", Qt::QueuedConnection, Q_ARG(int, type));
     } else {
         // no pending items left, remove the broadcast item
-        delete mBroadcastItems[type].mEvent;
+        releaseBroadcastEvent(broadcastItem.mEvent);
         mBroadcastItems.remove(type);
+        emit broadcastFinished(type);
     }
 }
 
 /*
     For asynchronous event broadcasting.
 
-    Items in the mPending array are informed.
+    Items in the mPending array are informed until the slice budget has been used.
 */
 void HbMainWindowPrivate::_q_continueBroadcasting(int type)
 {
@@ -1006,26 +1109,8 @@ void HbMainWindowPrivate::_q_continueBroadcasting(int type)
         return;
     }
 
-    BroadcastItem &broadcastItem = mBroadcastItems[type];
-
-    // take a copy and then clear the pending items
-    QList<HbMainWindowPrivate::QGraphicsWidgetPtr> informItems = broadcastItem.mPending;
-    broadcastItem.mPending.clear();
-
-    foreach(QPointer<QGraphicsWidget> widgetPtr, informItems) {
-        if (!widgetPtr.isNull()) {
-            informWidget(broadcastItem, widgetPtr.data());
-        }
-    }
-
-    // create another broadcast loop if needed.
-    if (broadcastItem.mPending.count()) {
-        Q_Q(HbMainWindow);
-        QMetaObject::invokeMethod(q, "_q_continueBroadcasting", Qt::QueuedConnection, Q_ARG(int, type));
-    } else {
-        // no pending items left, remove the broadcast item
-        delete mBroadcastItems[type].mEvent;
-        mBroadcastItems.remove(type);
+    if (informPendingWidgets(type, broadcastSliceBudget())) {
+        finishBroadcastSlice(type);
     }
 }
 
@@ -157,8 +157,12 @@ public:
     struct BroadcastItem {
         QEvent *mEvent;
         QList<QGraphicsWidgetPtr> mPending;
+        QGraphicsWidgetPtr mPriorityItem;
     };
     QMap<int, BroadcastItem> mBroadcastItems;
+    // Number of broadcast events being delivered, and the replaced events waiting for them.
+    int mBroadcastDepth;
+    QList<QEvent *> mRetiredBroadcastEvents;
     HbDeviceProfile mCurrentProfile;
     bool mDelayedConstructionHandled;
     HbMainWindow *q_ptr;
@@ -197,11 +201,18 @@ public:
     void _q_contentFullScreenChanged();
     void _q_themeChanged();
     void _q_continueBroadcasting(int type);
+    bool informWidget(int type, QEvent *event, QGraphicsWidget *widget, QGraphicsWidget *priorityItem);
+    bool informPendingWidgets(int type, int budget);
+    void releaseBroadcastEvent(QEvent *event);
+    void finishBroadcastSlice(int type);
     void _q_restoreTitlePane();
     void _q_delayedConstruction();
 
     static bool dragToResizeEnabled;
     static bool initializeInputs;
+    // Time in milliseconds after which a slice of a broadcast yields to the
+    // event loop, 0 for no limit. Read from HB_BROADCAST_SLICE when negative.
+    static int broadcastSliceBudget;
 
     static const int IdleEvent;
     static const int IdleOrientationEvent;
@@ -219,6 +230,7 @@ public:
 
 signals:
     void idleEventDispatched();
+    void broadcastFinished(int eventType);
 
 public slots:
     void menuClosed();
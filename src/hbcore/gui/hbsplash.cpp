@@ -26,11 +26,14 @@
 #include "hbsplash_p.h"
 #include "hbsplash_direct_symbian_p.h"
 #include "hbsplashdefs_p.h"
+#include "hbsplashcodec_p.h"
 #include <QDir>
 #include <QFile>
 #include <QTime>
 #include <QScopedPointer>
 #include <QScopedArrayPointer>
+#include <QHash>
+#include <QVector>
 
 #ifdef Q_OS_SYMBIAN
 #include <e32std.h>
@@ -79,13 +82,30 @@ struct Params {
     bool forceFile; // supported only in load_symbian()
     bool async; // only supported when forceFile == false
     void *clientPtr;
+    bool map; // supported only in load_generic()
+    bool noDelta; // set when reading the base of a delta-encoded screen
+    quint32 id;
 };
 
+#ifdef Q_OS_SYMBIAN
+class HbSplashSrvClient;
+static bool openBaseFromServer(HbSplashSrvClient *client, const QString &ori, RFile &f);
+#endif
+
 struct File {
+#ifdef Q_OS_SYMBIAN
+    File() : mClient(0) { }
+#endif
     qint64 read(char *buf, qint64 size);
+    QString fullName();
+    bool openBase(File &base);
+    void close();
     QString mFullName;
 #ifdef Q_OS_SYMBIAN
     RFile mFile;
+    RFs mFs; // used only by files opened with openBase()
+    HbSplashSrvClient *mClient; // set when the file was handed over by the server
+    QString mOri;
 #else
     QFile mFile;
 #endif
@@ -101,23 +121,273 @@ qint64 File::read(char *buf, qint64 size)
 #endif
 }
 
+QString File::fullName()
+{
+#ifdef Q_OS_SYMBIAN
+    TFileName name;
+    if (mFile.FullName(name) == KErrNone) {
+        return QString::fromUtf16(name.Ptr(), name.Length());
+    }
+    return QString();
+#else
+    return mFullName;
+#endif
+}
+
+// Opens the generic screen ("splash_<orientation>.spl") from the directory
+// of this file. Files received from the server live in its private
+// directory so in that case the base is requested from the server too.
+bool File::openBase(File &base)
+{
+#ifdef Q_OS_SYMBIAN
+    if (mClient) {
+        base.mFullName = "[unavailable]";
+        return openBaseFromServer(mClient, mOri, base.mFile);
+    }
+#endif
+    QString name = fullName();
+    int sep = qMax(name.lastIndexOf('/'), name.lastIndexOf('\\'));
+    QString oriStr = name.mid(sep + 1).section('_', 1, 1).section('.', 0, 0);
+    if (oriStr.isEmpty()) {
+        return false;
+    }
+    base.mFullName = name.left(sep + 1) + QString("splash_%1.spl").arg(oriStr);
+    if (base.mFullName == name) {
+        return false;
+    }
+#ifdef Q_OS_SYMBIAN
+    if (base.mFs.Connect() != KErrNone) {
+        return false;
+    }
+    TPtrC nameDes(static_cast<const TUint16 *>(base.mFullName.utf16()), base.mFullName.length());
+    if (base.mFile.Open(base.mFs, nameDes, EFileRead | EFileShareReadersOrWriters) != KErrNone) {
+        base.mFs.Close();
+        return false;
+    }
+    return true;
+#else
+    base.mFile.setFileName(base.mFullName);
+    return base.mFile.open(QIODevice::ReadOnly);
+#endif
+}
+
+void File::close()
+{
+#ifdef Q_OS_SYMBIAN
+    mFile.Close();
+    mFs.Close();
+#else
+    mFile.close();
+#endif
+}
+
+// Files written before the codec and delta support have a header of six
+// words: width, height, bytes-per-line, format, extra flags and the size of
+// the zlib compressed data (0 for raw data). Newer files start with
+// hbsplash_file_magic and have the extended header below.
+struct SplHeader {
+    quint32 w;
+    quint32 h;
+    quint32 bpl;
+    QImage::Format fmt;
+    quint32 extra;
+    quint32 codec;
+    quint32 payloadSize;
+    quint32 id;
+    quint32 baseId;
+    quint32 rectCount;
+};
+
+const int legacy_header_words = 6;
+const int header_words = 13;
+
+static inline bool isExtendedHeader(const quint32 *buf)
+{
+    return buf[0] == hbsplash_file_magic && buf[1] == 0;
+}
+
+static void parseHeader(const quint32 *buf, SplHeader &hdr)
+{
+    if (isExtendedHeader(buf)) {
+        hdr.w = buf[3];
+        hdr.h = buf[4];
+        hdr.bpl = buf[5];
+        hdr.fmt = (QImage::Format) buf[6];
+        hdr.extra = buf[7];
+        hdr.codec = buf[8];
+        hdr.payloadSize = buf[9];
+        hdr.id = buf[10];
+        hdr.baseId = buf[11];
+        hdr.rectCount = buf[12];
+    } else {
+        hdr.w = buf[0];
+        hdr.h = buf[1];
+        hdr.bpl = buf[2];
+        hdr.fmt = (QImage::Format) buf[3];
+        hdr.extra = buf[4];
+        hdr.codec = buf[5] ? HbSplashCodecZlib : HbSplashCodecRaw;
+        hdr.payloadSize = buf[5];
+        hdr.id = 0;
+        hdr.baseId = 0;
+        hdr.rectCount = 0;
+    }
+}
+
+static bool readHeader(File &f, SplHeader &hdr)
+{
+    // Read the legacy header in one piece in order to minimize the number of
+    // read() calls, the rest of the extended header needs one more.
+    quint32 buf[header_words];
+    qMemSet(buf, 0, sizeof(buf));
+    f.read(reinterpret_cast<char *>(buf), legacy_header_words * sizeof(quint32));
+    if (isExtendedHeader(buf)) {
+        if (buf[2] != hbsplash_file_version) {
+            qWarning("[hbsplash] Unsupported version %u in %s", buf[2], qPrintable(f.mFullName));
+            return false;
+        }
+        const qint64 rest = (header_words - legacy_header_words) * sizeof(quint32);
+        if (f.read(reinterpret_cast<char *>(buf + legacy_header_words), rest) != rest) {
+            return false;
+        }
+    }
+    parseHeader(buf, hdr);
+    return true;
+}
+
+// Reads and decodes sz bytes of pixel data.
+static bool readPayload(File &f, const SplHeader &hdr, uchar *dst, qint64 sz)
+{
+    if (hdr.codec == HbSplashCodecRaw) {
+        return f.read(reinterpret_cast<char *>(dst), sz) == sz;
+    }
+    if (hdr.payloadSize == 0 || hdr.payloadSize > image_bytes_limit) {
+        return false;
+    }
+    QScopedArrayPointer<uchar> compressedData(new uchar[hdr.payloadSize]);
+    qint64 bytesRead = f.read(reinterpret_cast<char *>(compressedData.data()), hdr.payloadSize);
+    if (bytesRead != hdr.payloadSize) {
+        return false;
+    }
+    if (hdr.codec == HbSplashCodecLz) {
+        return HbSplashCodec::uncompress(compressedData.data(), hdr.payloadSize, dst, sz);
+    }
+    if (hdr.codec == HbSplashCodecZlib) {
+        QByteArray uncompData = qUncompress(compressedData.data(), hdr.payloadSize);
+        if (uncompData.size() != sz) {
+            qWarning("[hbsplash] Bad data (size %d, expected %d)", uncompData.size(), (int) sz);
+            return false;
+        }
+        qMemCopy(dst, uncompData.constData(), sz);
+        return true;
+    }
+    qWarning("[hbsplash] Unknown codec %u", hdr.codec);
+    return false;
+}
+
+struct BaseBuffer {
+    uchar *data;
+    int w;
+    int h;
+    int bpl;
+    QImage::Format fmt;
+};
+
+static uchar *baseAllocFunc(int w, int h, int bpl, QImage::Format fmt, void *param)
+{
+    BaseBuffer *buf = static_cast<BaseBuffer *>(param);
+    if (w == buf->w && h == buf->h && bpl == buf->bpl && fmt == buf->fmt) {
+        return buf->data;
+    }
+    return 0;
+}
+
+static uchar *readSpl(File &f, Params &params);
+
+// Reads a screen stored as the rectangles that differ from the generic
+// screen. The generic screen is decoded directly into `data' and the
+// rectangles are copied over it.
+static bool readDelta(File &f, const SplHeader &hdr, uchar *data)
+{
+    if (hdr.fmt != QImage::Format_ARGB32_Premultiplied
+        || hdr.rectCount == 0 || hdr.rectCount > hbsplash_max_delta_rects) {
+        return false;
+    }
+    QVector<quint32> rects(hdr.rectCount * 4);
+    const qint64 rectBytes = rects.count() * sizeof(quint32);
+    if (f.read(reinterpret_cast<char *>(rects.data()), rectBytes) != rectBytes) {
+        return false;
+    }
+    qint64 deltaSize = 0;
+    for (int i = 0; i < rects.count(); i += 4) {
+        quint32 x = rects.at(i);
+        quint32 y = rects.at(i + 1);
+        quint32 rw = rects.at(i + 2);
+        quint32 rh = rects.at(i + 3);
+        if (!rw || !rh || x >= hdr.w || y >= hdr.h || rw > hdr.w - x || rh > hdr.h - y) {
+            return false;
+        }
+        deltaSize += qint64(rw) * rh * 4;
+    }
+    if (deltaSize > qint64(hdr.h) * hdr.bpl) {
+        return false;
+    }
+
+    File base;
+    if (!f.openBase(base)) {
+        qWarning("[hbsplash] Base screen for %s not found", qPrintable(f.mFullName));
+        return false;
+    }
+    int w, h, bpl;
+    QImage::Format fmt;
+    BaseBuffer buf = { data, hdr.w, hdr.h, hdr.bpl, hdr.fmt };
+    Params baseParams;
+    baseParams.w = &w;
+    baseParams.h = &h;
+    baseParams.bpl = &bpl;
+    baseParams.fmt = &fmt;
+    baseParams.flags = HbSplashScreen::Default;
+    baseParams.allocFunc = baseAllocFunc;
+    baseParams.allocFuncParam = &buf;
+    baseParams.forceFile = true;
+    baseParams.async = false;
+    baseParams.clientPtr = 0;
+    baseParams.map = false;
+    baseParams.noDelta = true;
+    baseParams.id = 0;
+    uchar *baseData = readSpl(base, baseParams);
+    base.close();
+    if (baseData != data || baseParams.id != hdr.baseId) {
+        qWarning("[hbsplash] Base screen for %s is not usable", qPrintable(f.mFullName));
+        return false;
+    }
+
+    QScopedArrayPointer<uchar> delta(new uchar[deltaSize]);
+    if (!readPayload(f, hdr, delta.data(), deltaSize)) {
+        return false;
+    }
+    const uchar *src = delta.data();
+    for (int i = 0; i < rects.count(); i += 4) {
+        const int rowBytes = rects.at(i + 2) * 4;
+        uchar *dst = data + rects.at(i + 1) * hdr.bpl + rects.at(i) * 4;
+        for (quint32 row = 0; row < rects.at(i + 3); ++row) {
+            qMemCopy(dst, src, rowBytes);
+            dst += hdr.bpl;
+            src += rowBytes;
+        }
+    }
+    return true;
+}
+
 static uchar *readSpl(File &f, Params &params)
 {
-    quint32 w = 0, h = 0, bpl = 0, compressedSz = 0;
-    QImage::Format fmt = QImage::Format_Invalid;
-    // Have to read the header in one piece in order to minimize the
-    // number of read() calls.
-    const int headerLength = sizeof(quint32) * 6;
-    char headerBuf[headerLength];
-    qMemSet(headerBuf, 0, headerLength);
-    f.read(headerBuf, headerLength);
-    quint32 *headerPtr = reinterpret_cast<quint32 *>(headerBuf);
-    w = *headerPtr++;
-    h = *headerPtr++;
-    bpl = *headerPtr++;
-    fmt = (QImage::Format) * headerPtr++;
-    params.extra = *headerPtr++;
-    compressedSz = *headerPtr;
+    SplHeader hdr;
+    if (!readHeader(f, hdr)) {
+        return 0;
+    }
+    quint32 w = hdr.w, h = hdr.h, bpl = hdr.bpl;
+    QImage::Format fmt = hdr.fmt;
+    params.extra = hdr.extra;
+    params.id = hdr.id;
     if (fmt != QImage::Format_ARGB32_Premultiplied) {
         qWarning("[hbsplash] Image format for %s is not ARGB32_PRE (is %d instead)",
                  qPrintable(f.mFullName), fmt);
@@ -126,11 +396,15 @@ static uchar *readSpl(File &f, Params &params)
         qWarning("[hbsplash] Image format is invalid");
         return 0;
     }
+    if (hdr.baseId && params.noDelta) {
+        qWarning("[hbsplash] Base screen %s is delta-encoded", qPrintable(f.mFullName));
+        return 0;
+    }
     qint64 sz = h * bpl;
     uchar *data = 0;
     if (w > 0 && h > 0 && bpl > 0 && sz > 0
         && sz <= image_bytes_limit
-        && compressedSz <= image_bytes_limit) {
+        && hdr.payloadSize <= image_bytes_limit) {
         try {
             QScopedArrayPointer<uchar> dataGuard;
             if (params.allocFunc) {
@@ -142,30 +416,12 @@ static uchar *readSpl(File &f, Params &params)
                 dataGuard.reset(data);
             }
             if (data) {
-                if (compressedSz > 0) {
-                    QScopedArrayPointer<uchar> compressedData(new uchar[compressedSz]);
-                    qint64 bytesRead = f.read(reinterpret_cast<char *>(compressedData.data()), compressedSz);
-                    if (bytesRead != compressedSz) {
-                        qWarning("[hbsplash] File %s is invalid", qPrintable(f.mFullName));
-                        data = 0;
-                    } else {
-                        QByteArray uncompData = qUncompress(compressedData.data(), compressedSz);
-                        if (uncompData.size() == sz) {
-                            qMemCopy(data, uncompData.constData(), sz);
-                        } else {
-                            qWarning("[hbsplash] Bad data (size %d, expected %d)", uncompData.size(), (int) sz);
-                            data = 0;
-                        }
-                    }
-                } else {
-                    qint64 bytesRead = f.read(reinterpret_cast<char *>(data), sz);
-                    if (bytesRead != sz) {
-                        qWarning("[hbsplash] File %s is invalid", qPrintable(f.mFullName));
-                        data = 0;
-                    }
-                }
-                if (data) {
+                bool ok = hdr.baseId ? readDelta(f, hdr, data) : readPayload(f, hdr, data, sz);
+                if (ok) {
                     dataGuard.take();
+                } else {
+                    qWarning("[hbsplash] File %s is invalid", qPrintable(f.mFullName));
+                    data = 0;
                 }
             }
         } catch (const std::bad_alloc &) {
@@ -200,6 +456,8 @@ public:
                              const QString &appId,
                              const QString &screenId);
 
+    bool getSplashBaseFileHandle(RFile &f, const QString &ori);
+
     void getSplashFromBitmapAsync(const QString &ori,
                                   const QString &appId,
                                   const QString &screenId,
@@ -305,6 +563,22 @@ bool HbSplashSrvClient::getSplashFileHandle(RFile &f,
     return f.AdoptFromServer(fsHandle, fileHandle) == KErrNone;
 }
 
+bool HbSplashSrvClient::getSplashBaseFileHandle(RFile &f, const QString &ori)
+{
+    TPtrC oriDes(static_cast<const TUint16 *>(ori.utf16()), ori.length());
+    TPtrC emptyDes;
+    TInt fileHandle;
+    TPckg<TInt> fileHandlePckg(fileHandle);
+    TIpcArgs args(&oriDes, &emptyDes, &emptyDes, &fileHandlePckg);
+    TInt fsHandle = SendReceive(HbSplashSrvGetSplashBaseFile, args);
+    return f.AdoptFromServer(fsHandle, fileHandle) == KErrNone;
+}
+
+static bool openBaseFromServer(HbSplashSrvClient *client, const QString &ori, RFile &f)
+{
+    return client->getSplashBaseFileHandle(f, ori);
+}
+
 void HbSplashSrvClient::getSplashFromBitmapAsync(const QString &ori,
                                                  const QString &appId,
                                                  const QString &screenId,
@@ -412,6 +686,8 @@ static uchar *load_symbian(Params &params)
     } else {
         File f;
         f.mFullName = "[unavailable]";
+        f.mClient = client.data();
+        f.mOri = oriStr;
         if (client->getSplashFileHandle(f.mFile, oriStr, appIdStr, params.screenId)) {
             splDebug("[hbsplash] got handle from server");
             data = readSpl(f, params);
@@ -444,6 +720,74 @@ static uchar *read_file_generic(const QString &name, Params &params)
     return data;
 }
 
+typedef QHash<uchar *, QFile *> MappedSplashHash;
+Q_GLOBAL_STATIC(MappedSplashHash, mappedSplashes)
+
+// Maps an uncompressed splash file and returns a pointer to the pixel data
+// inside the mapping. Compressed and delta-encoded files cannot be used
+// directly, for those `fallback' is set and the caller is expected to read
+// the file instead.
+static uchar *map_file_generic(const QString &name, Params &params, bool *fallback)
+{
+    *fallback = false;
+    QScopedPointer<QFile> f(new QFile(name));
+    if (!f->open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    const qint64 fileSize = f->size();
+    uchar *map = fileSize >= qint64(legacy_header_words * sizeof(quint32)) ? f->map(0, fileSize) : 0;
+    if (!map) {
+        *fallback = true;
+        return 0;
+    }
+    const quint32 *headerPtr = reinterpret_cast<const quint32 *>(map);
+    qint64 headerLength = legacy_header_words * sizeof(quint32);
+    if (isExtendedHeader(headerPtr)) {
+        headerLength = header_words * sizeof(quint32);
+        if (fileSize < headerLength || headerPtr[2] != hbsplash_file_version) {
+            *fallback = true;
+            return 0;
+        }
+    }
+    SplHeader hdr;
+    parseHeader(headerPtr, hdr);
+    quint32 w = hdr.w;
+    quint32 h = hdr.h;
+    quint32 bpl = hdr.bpl;
+    QImage::Format fmt = hdr.fmt;
+    quint32 extra = hdr.extra;
+    qint64 sz = h * bpl;
+    if (hdr.codec != HbSplashCodecRaw || hdr.baseId
+        || fmt < 0 || fmt >= QImage::NImageFormats
+        || w == 0 || h == 0 || bpl == 0 || sz > image_bytes_limit
+        || fileSize < headerLength + sz) {
+        // Let readSpl() deal with compressed, delta-encoded and bad files.
+        *fallback = true;
+        return 0;
+    }
+    uchar *data = map + headerLength;
+    mappedSplashes()->insert(data, f.take());
+    params.extra = extra;
+    params.id = hdr.id;
+    *params.w = w;
+    *params.h = h;
+    *params.bpl = bpl;
+    *params.fmt = fmt;
+    return data;
+}
+
+static uchar *load_file_generic(const QString &name, Params &params)
+{
+    if (params.map) {
+        bool fallback;
+        uchar *data = map_file_generic(name, params, &fallback);
+        if (data || !fallback) {
+            return data;
+        }
+    }
+    return read_file_generic(name, params);
+}
+
 static uchar *load_generic(Params &params)
 {
     QString appSpecificName("splash_%1_%2.spl");
@@ -460,11 +804,11 @@ static uchar *load_generic(Params &params)
         } else {
             name = appSpecificName.arg(oriStr).arg(params.appId);
         }
-        data = read_file_generic(dir.filePath(name), params);
+        data = load_file_generic(dir.filePath(name), params);
     }
     // If failed then use the common one.
     if (!data) {
-        data = read_file_generic(dir.filePath(genericName.arg(oriStr)), params);
+        data = load_file_generic(dir.filePath(genericName.arg(oriStr)), params);
     }
     return data;
 }
@@ -526,6 +870,9 @@ uchar *HbSplash::load(int &w, int &h, int &bpl, QImage::Format &fmt,
     params.forceFile = false; // use CFbsBitmap-based sharing on Symbian
     params.async = async;
     params.clientPtr = 0;
+    params.map = false;
+    params.noDelta = false;
+    params.id = 0;
 #ifdef Q_OS_SYMBIAN
     uchar *data = load_symbian(params);
     return async ? reinterpret_cast<uchar *>(params.clientPtr) : data;
@@ -553,6 +900,66 @@ uchar *HbSplash::finishAsync(uchar *handle)
 #endif
 }
 
+/*!
+  Like load() but on non-Symbian platforms uncompressed splash files are not
+  read into a new buffer. The returned pointer refers directly to a read-only
+  memory mapping of the file, which saves a copy of the whole image on the
+  start-up path. Compressed files are read the same way as in load().
+
+  Symbian: Same as load(), the data is received from the server.
+
+  The returned pointer must be released with releaseMapped().
+
+  \internal
+*/
+uchar *HbSplash::loadMapped(int &w, int &h, int &bpl, QImage::Format &fmt,
+                            HbSplashScreen::Flags flags,
+                            const QString &appId, const QString &screenId)
+{
+#ifdef Q_OS_SYMBIAN
+    return load(w, h, bpl, fmt, flags, appId, screenId);
+#else
+    Params params;
+    params.w = &w;
+    params.h = &h;
+    params.bpl = &bpl;
+    params.fmt = &fmt;
+    params.flags = flags;
+    params.appId = appId;
+    params.screenId = screenId;
+    params.allocFunc = 0;
+    params.allocFuncParam = 0;
+    params.forceFile = false;
+    params.async = false;
+    params.clientPtr = 0;
+    params.map = true;
+    params.noDelta = false;
+    params.id = 0;
+    return load_generic(params);
+#endif
+}
+
+/*!
+  Releases the pixel data returned by loadMapped(). Unmaps the file when the
+  data points into a mapping, otherwise frees the buffer.
+
+  \internal
+*/
+void HbSplash::releaseMapped(uchar *data)
+{
+    if (!data) {
+        return;
+    }
+#ifndef Q_OS_SYMBIAN
+    QFile *f = mappedSplashes()->take(data);
+    if (f) {
+        delete f; // closing the file unmaps the data
+        return;
+    }
+#endif
+    delete[] data;
+}
+
 #ifdef Q_OS_SYMBIAN
 static uchar *fbsBitmapAllocFunc(int w, int h, int bpl, QImage::Format fmt, void *param)
 {
@@ -593,6 +1000,7 @@ void *HbSplashDirectSymbian::load(void *file, int *extra)
     params.flags = HbSplashScreen::Default;
     params.allocFunc = fbsBitmapAllocFunc;
     params.allocFuncParam = bmp.data();
+    params.noDelta = false;
     File f;
     f.mFile = *static_cast<RFile *>(file);
     if (readSpl(f, params)) {
@@ -47,6 +47,16 @@ public:
                        bool async = false);
 
     static uchar *finishAsync(uchar *handle);
+
+    static uchar *loadMapped(int &w,
+                             int &h,
+                             int &bpl,
+                             QImage::Format &fmt,
+                             HbSplashScreen::Flags flags = HbSplashScreen::Default,
+                             const QString &appId = QString(),
+                             const QString &screenId = QString());
+
+    static void releaseMapped(uchar *data);
 };
 
 #endif // HBSPLASH_P_H
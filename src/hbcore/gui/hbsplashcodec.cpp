@@ -0,0 +1,190 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the HbCore module of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include "hbsplashcodec_p.h"
+
+/*!
+  \class HbSplashCodec
+
+  \brief Byte-oriented LZ77 codec for splash screen pixel data.
+
+  The compressed data is a sequence of blocks. Each block starts with a token
+  byte, the high nibble of which is the number of literal bytes and the low
+  nibble the length of the match minus four. A nibble value of 15 means that
+  further length bytes follow, each adding up to 255. The literals come next,
+  then the 16-bit little-endian offset of the match. The last block has
+  literals only.
+
+  Decoding needs no tables and no allocations, which makes it considerably
+  faster than qUncompress() for the large, mostly flat images rendered by
+  hbsplashgenerator.
+
+  \internal
+*/
+
+static const int minMatch = 4;
+static const int maxOffset = 65535;
+static const int hashBits = 12;
+
+static inline quint32 read32(const uchar *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (quint32(p[3]) << 24);
+}
+
+static inline int hash(quint32 v)
+{
+    return (v * 2654435761U) >> (32 - hashBits);
+}
+
+static void writeLength(QByteArray &out, int len)
+{
+    while (len >= 255) {
+        out.append(char(255));
+        len -= 255;
+    }
+    out.append(char(len));
+}
+
+static void writeBlock(QByteArray &out, const uchar *literals, int literalCount,
+                       int offset, int matchLength)
+{
+    const int m = matchLength ? matchLength - minMatch : 0;
+    uchar token = (qMin(literalCount, 15) << 4) | qMin(m, 15);
+    out.append(char(token));
+    if (literalCount >= 15) {
+        writeLength(out, literalCount - 15);
+    }
+    out.append(reinterpret_cast<const char *>(literals), literalCount);
+    if (matchLength) {
+        out.append(char(offset & 0xff));
+        out.append(char(offset >> 8));
+        if (m >= 15) {
+            writeLength(out, m - 15);
+        }
+    }
+}
+
+/*!
+  Compresses \a size bytes from \a data.
+*/
+QByteArray HbSplashCodec::compress(const uchar *data, int size)
+{
+    QByteArray out;
+    out.reserve(size / 8 + 16);
+    int table[1 << hashBits];
+    for (int i = 0; i < (1 << hashBits); ++i) {
+        table[i] = -1;
+    }
+
+    int anchor = 0;
+    int pos = 0;
+    while (pos + minMatch <= size) {
+        const quint32 v = read32(data + pos);
+        const int h = hash(v);
+        const int candidate = table[h];
+        table[h] = pos;
+        if (candidate >= 0 && pos - candidate <= maxOffset && read32(data + candidate) == v) {
+            int len = minMatch;
+            while (pos + len < size && data[candidate + len] == data[pos + len]) {
+                ++len;
+            }
+            writeBlock(out, data + anchor, pos - anchor, pos - candidate, len);
+            pos += len;
+            anchor = pos;
+        } else {
+            ++pos;
+        }
+    }
+    writeBlock(out, data + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+/*!
+  Decompresses \a srcSize bytes from \a src into \a dst. Returns true when the
+  input was valid and produced exactly \a dstSize bytes.
+*/
+bool HbSplashCodec::uncompress(const uchar *src, int srcSize, uchar *dst, int dstSize)
+{
+    const uchar *ip = src;
+    const uchar *const ipEnd = src + srcSize;
+    uchar *op = dst;
+    uchar *const opEnd = dst + dstSize;
+
+    while (ip < ipEnd) {
+        const uchar token = *ip++;
+        int literalCount = token >> 4;
+        if (literalCount == 15) {
+            uchar b;
+            do {
+                if (ip >= ipEnd) {
+                    return false;
+                }
+                b = *ip++;
+                literalCount += b;
+            } while (b == 255);
+        }
+        if (literalCount > ipEnd - ip || literalCount > opEnd - op) {
+            return false;
+        }
+        qMemCopy(op, ip, literalCount);
+        ip += literalCount;
+        op += literalCount;
+        if (ip == ipEnd) {
+            break; // last block
+        }
+
+        if (ipEnd - ip < 2) {
+            return false;
+        }
+        const int offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        int matchLength = (token & 0x0f);
+        if (matchLength == 15) {
+            uchar b;
+            do {
+                if (ip >= ipEnd) {
+                    return false;
+                }
+                b = *ip++;
+                matchLength += b;
+            } while (b == 255);
+        }
+        matchLength += minMatch;
+        if (offset == 0 || offset > op - dst || matchLength > opEnd - op) {
+            return false;
+        }
+        const uchar *match = op - offset;
+        if (offset >= matchLength) {
+            qMemCopy(op, match, matchLength);
+            op += matchLength;
+        } else {
+            // Overlapping copy, e.g. a run of the same pixel.
+            while (matchLength--) {
+                *op++ = *match++;
+            }
+        }
+    }
+    return op == opEnd;
+}
@@ -43,7 +43,8 @@ const TUid hbsplash_server_uid3 = { 0x2002E68B };
 
 enum HbSplashServerFuncs {
     HbSplashSrvGetSplashFile = 1,
-    HbSplashSrvGetSplashData
+    HbSplashSrvGetSplashData,
+    HbSplashSrvGetSplashBaseFile
 };
 
 enum HbSplashServerPanics {
@@ -74,6 +75,26 @@ enum HbSplashStoredExtraFlags {
  */
 #define HB_SPLASH_COMPRESSION
 
+/*
+  Enable the following to store application-specific screens as the
+  rectangles that differ from the generic screen of the same orientation.
+ */
+#define HB_SPLASH_DELTA_ENCODING
+
+/*
+  Files written with the extended header start with the magic number followed
+  by a zero (in place of the height of the old header) and the version.
+ */
+const quint32 hbsplash_file_magic = 0x4c505348; // "HSPL"
+const quint32 hbsplash_file_version = 2;
+const quint32 hbsplash_max_delta_rects = 64;
+
+enum HbSplashCodecId {
+    HbSplashCodecRaw = 0,
+    HbSplashCodecZlib,
+    HbSplashCodecLz
+};
+
 #ifdef HB_SPLASH_VERBOSE_LOGGING
 inline QDebug splDeb() { return qDebug(); }
 #define splDebug qDebug
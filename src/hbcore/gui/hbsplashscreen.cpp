@@ -288,7 +288,7 @@ HbSplashScreenGeneric::~HbSplashScreenGeneric()
 {
     if (mImageData) {
         splDebug("[hbsplash] destroying splash screen");
-        delete mImageData;
+        HbSplash::releaseMapped(mImageData);
     }
 }
 
@@ -304,10 +304,11 @@ void HbSplashScreenGeneric::start(HbSplashScreen::Flags flags)
             int w, h, bpl;
             QImage::Format fmt;
             RequestProps *props = requestProps();
-            mImageData = HbSplash::load(w, h, bpl, fmt, flags,
-                                        props->mAppId, props->mScreenId);
+            mImageData = HbSplash::loadMapped(w, h, bpl, fmt, flags,
+                                              props->mAppId, props->mScreenId);
             if (mImageData) {
-                mContents = QImage(mImageData, w, h, bpl, fmt);
+                // The data may point into a read-only file mapping.
+                mContents = QImage(static_cast<const uchar *>(mImageData), w, h, bpl, fmt);
                 resize(mContents.size());
             }
         }
@@ -0,0 +1,362 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the HbCore module of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include "hbdatetimeformat_p.h"
+#include "hbextendedlocale.h"
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+// Maximum number of compiled formats kept in the cache. The formats of
+// hbi18ndef.h fit in easily.
+const int format_cache_size = 32;
+
+struct HbDateTimeFormatCache
+{
+    QMutex mutex;
+    QHash<QString, HbDateTimeFormat> formats;
+};
+
+Q_GLOBAL_STATIC(HbDateTimeFormatCache, formatCache)
+
+HbDateTimeFormat::HbDateTimeFormat() :
+    mDayAbbreviated(false),
+    mMonthAbbreviated(false),
+    mYearAbbreviated(false)
+{
+}
+
+/*
+  Parses \a format into tokens. Unsupported directives are ignored.
+*/
+HbDateTimeFormat HbDateTimeFormat::compile(const QString &format)
+{
+    HbDateTimeFormat program;
+    QString literal;
+    bool ordered = false;
+    bool fixed = false;
+
+    int i = 0;
+    const int length = format.length();
+    while (i < length) {
+        QChar c = format.at(i++);
+        if (c != QLatin1Char('%') || i >= length) {
+            literal += c;
+            continue;
+        }
+
+        Token token;
+        token.arg = 0;
+        token.abbreviated = false;
+
+        c = format.at(i++);
+        while ((c == QLatin1Char('*') || c == QLatin1Char('+') || c == QLatin1Char('-')) && i < length) {
+            if (c == QLatin1Char('*')) {
+                token.abbreviated = true;
+            } else {
+                token.arg = c == QLatin1Char('+') ? 1 : -1;
+            }
+            c = format.at(i++);
+        }
+
+        switch (c.unicode()) {
+        case '%':
+            literal += c;
+            continue;
+        case ':':
+        case '/': {
+            int index = i < length ? format.at(i).digitValue() : -1;
+            if (index < 0 || index > 3) {
+                continue;
+            }
+            ++i;
+            token.op = c == QLatin1Char(':') ? TimeSeparator : DateSeparator;
+            token.arg = index;
+            break;
+        }
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+            token.op = DateComponent;
+            token.arg = c.digitValue();
+            ordered = true;
+            break;
+        case 'D':
+            token.op = Day;
+            break;
+        case 'M':
+            token.op = Month;
+            break;
+        case 'Y':
+            token.op = Year;
+            break;
+        case 'H':
+            token.op = Hour24;
+            break;
+        case 'I':
+            token.op = Hour12;
+            break;
+        case 'J':
+            token.op = HourLocale;
+            break;
+        case 'T':
+            token.op = Minute;
+            break;
+        case 'S':
+            token.op = Second;
+            break;
+        case 'A':
+            token.op = AmPmText;
+            break;
+        case 'B':
+            token.op = AmPm;
+            break;
+        case 'E':
+            token.op = DayName;
+            break;
+        case 'N':
+            token.op = MonthName;
+            break;
+        case 'F':
+            fixed = true;
+            continue;
+        default:
+            continue;
+        }
+
+        program.appendLiteral(literal);
+        literal.clear();
+        program.mTokens.append(token);
+    }
+    program.appendLiteral(literal);
+
+    // With the locale ordered components %D, %M and %Y only give the
+    // modifiers of the components, unless %F asks for the fixed order.
+    if (ordered && !fixed) {
+        QList<Token>::iterator it = program.mTokens.begin();
+        while (it != program.mTokens.end()) {
+            if (it->op == Day) {
+                program.mDayAbbreviated = it->abbreviated;
+            } else if (it->op == Month) {
+                program.mMonthAbbreviated = it->abbreviated;
+            } else if (it->op == Year) {
+                program.mYearAbbreviated = it->abbreviated;
+            } else {
+                ++it;
+                continue;
+            }
+            it = program.mTokens.erase(it);
+        }
+    }
+    return program;
+}
+
+/*
+  Returns the compiled \a format from the process wide cache, compiling it
+  on the first use.
+*/
+HbDateTimeFormat HbDateTimeFormat::cached(const QString &format)
+{
+    HbDateTimeFormatCache *cache = formatCache();
+    if (!cache) {
+        return compile(format);
+    }
+
+    QMutexLocker locker(&cache->mutex);
+    QHash<QString, HbDateTimeFormat>::const_iterator it = cache->formats.constFind(format);
+    if (it != cache->formats.constEnd()) {
+        return it.value();
+    }
+    HbDateTimeFormat program = compile(format);
+    if (cache->formats.count() >= format_cache_size) {
+        cache->formats.clear();
+    }
+    cache->formats.insert(format, program);
+    return program;
+}
+
+/*
+  Formats \a date and \a time with the settings of \a locale. The date is
+  taken as the first day of year 0 when it is not valid.
+*/
+QString HbDateTimeFormat::run(const HbExtendedLocale &locale, const QDate &date, const QTime &time) const
+{
+    int year = 0;
+    int month = 1;
+    int day = 1;
+    if (date.isValid()) {
+        year = date.year();
+        month = date.month();
+        day = date.day();
+    }
+    const int hour = time.hour();
+
+    QString result;
+    result.reserve(32);
+
+    QList<Token>::const_iterator end = mTokens.constEnd();
+    for (QList<Token>::const_iterator it = mTokens.constBegin(); it != end; ++it) {
+        const Token &token = *it;
+        switch (token.op) {
+        case Literal:
+            result += token.text;
+            break;
+        case Day:
+            appendNumber(result, day, token.abbreviated);
+            break;
+        case Month:
+            appendNumber(result, month, token.abbreviated);
+            break;
+        case Year:
+            if (token.abbreviated) {
+                appendNumber(result, year % 100, false);
+            } else {
+                result += QString::number(year);
+            }
+            break;
+        case DateComponent: {
+            // Components of %1 - %3 and of %4 - %5 in the order of the date style.
+            static const Op american[] = { Month, Day, Year, Month, Day };
+            static const Op european[] = { Day, Month, Year, Day, Month };
+            static const Op japanese[] = { Year, Month, Day, Month, Day };
+            const Op *order = american;
+            HbExtendedLocale::DateStyle style = locale.dateStyle();
+            if (style == HbExtendedLocale::European) {
+                order = european;
+            } else if (style == HbExtendedLocale::Japanese) {
+                order = japanese;
+            }
+            Op component = order[token.arg - 1];
+            if (component == Day) {
+                appendNumber(result, day, mDayAbbreviated);
+            } else if (component == Month) {
+                appendNumber(result, month, mMonthAbbreviated);
+            } else if (mYearAbbreviated) {
+                appendNumber(result, year % 100, false);
+            } else {
+                result += QString::number(year);
+            }
+            break;
+        }
+        case DateSeparator: {
+            QChar separator = locale.dateSeparator(token.arg);
+            if (!separator.isNull()) {
+                result += separator;
+            }
+            break;
+        }
+        case TimeSeparator: {
+            QChar separator = locale.timeSeparator(token.arg);
+            if (!separator.isNull()) {
+                result += separator;
+            }
+            break;
+        }
+        case Hour24:
+            appendNumber(result, hour, token.abbreviated);
+            break;
+        case Hour12:
+            appendNumber(result, hour % 12 ? hour % 12 : 12, token.abbreviated);
+            break;
+        case HourLocale:
+            if (locale.timeStyle() == HbExtendedLocale::Time12) {
+                appendNumber(result, hour % 12 ? hour % 12 : 12, token.abbreviated);
+            } else {
+                appendNumber(result, hour, token.abbreviated);
+            }
+            break;
+        case Minute:
+            appendNumber(result, time.minute(), token.abbreviated);
+            break;
+        case Second:
+            appendNumber(result, time.second(), token.abbreviated);
+            break;
+        case AmPm:
+            if (locale.timeStyle() != HbExtendedLocale::Time12) {
+                break;
+            }
+            // fall through
+        case AmPmText: {
+            QString text = hour < 12 ? locale.amText() : locale.pmText();
+            if (token.arg < 0) {
+                if (locale.amPmSymbolPosition() == HbExtendedLocale::Before) {
+                    result += text;
+                    if (locale.amPmSpace()) {
+                        result += QLatin1Char(' ');
+                    }
+                }
+            } else if (token.arg > 0) {
+                if (locale.amPmSymbolPosition() == HbExtendedLocale::After) {
+                    if (locale.amPmSpace()) {
+                        result += QLatin1Char(' ');
+                    }
+                    result += text;
+                }
+            } else {
+                result += text;
+            }
+            break;
+        }
+        case DayName:
+            if (date.isValid()) {
+                result += locale.dayName(date.dayOfWeek(),
+                                         token.abbreviated ? QLocale::ShortFormat : QLocale::LongFormat);
+            }
+            break;
+        case MonthName:
+            result += locale.monthName(month,
+                                       token.abbreviated ? QLocale::ShortFormat : QLocale::LongFormat);
+            break;
+        }
+    }
+    return result;
+}
+
+void HbDateTimeFormat::appendLiteral(const QString &text)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+    if (!mTokens.isEmpty() && mTokens.last().op == Literal) {
+        mTokens.last().text += text;
+        return;
+    }
+    Token token;
+    token.op = Literal;
+    token.arg = 0;
+    token.abbreviated = false;
+    token.text = text;
+    mTokens.append(token);
+}
+
+void HbDateTimeFormat::appendNumber(QString &result, int value, bool abbreviated)
+{
+    if (!abbreviated && value >= 0 && value < 10) {
+        result += QLatin1Char('0');
+    }
+    result += QString::number(value);
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the HbCore module of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#ifndef HBDATETIMEFORMAT_P_H
+#define HBDATETIMEFORMAT_P_H
+
+#include <QString>
+#include <QList>
+#include <QDate>
+#include <QTime>
+#include <hbglobal.h>
+
+class HbExtendedLocale;
+
+/*
+  A date or time format string of hbi18ndef.h (Symbian TTime::FormatL
+  syntax) compiled into a list of tokens. The locale dependent parts, like
+  the order of the date components and the separators, are resolved when the
+  format is run, so a compiled format stays valid when the locale changes.
+*/
+class HB_CORE_PRIVATE_EXPORT HbDateTimeFormat
+{
+public:
+    HbDateTimeFormat();
+
+    static HbDateTimeFormat compile(const QString &format);
+    static HbDateTimeFormat cached(const QString &format);
+
+    QString run(const HbExtendedLocale &locale, const QDate &date, const QTime &time) const;
+
+private:
+    enum Op {
+        Literal,
+        Day,
+        Month,
+        Year,
+        DateComponent,
+        DateSeparator,
+        TimeSeparator,
+        Hour24,
+        Hour12,
+        HourLocale,
+        Minute,
+        Second,
+        AmPm,      // %B, only with the 12 hour clock
+        AmPmText,  // %A, regardless of the clock
+        DayName,
+        MonthName
+    };
+
+    struct Token {
+        Op op;
+        // Component or separator index, or the am/pm position: -1 before the
+        // time, 1 after the time and 0 unconditionally.
+        int arg;
+        bool abbreviated;
+        QString text;
+    };
+
+    void appendLiteral(const QString &text);
+    static void appendNumber(QString &result, int value, bool abbreviated);
+
+    QList<Token> mTokens;
+    // Modifiers of %D, %M and %Y, applied to the components %1 - %5.
+    bool mDayAbbreviated;
+    bool mMonthAbbreviated;
+    bool mYearAbbreviated;
+};
+
+#endif // HBDATETIMEFORMAT_P_H
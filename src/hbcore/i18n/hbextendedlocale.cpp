@@ -36,6 +36,9 @@
 #endif
 
 #include "hbextendedlocale.h"
+#if !defined(Q_OS_SYMBIAN)
+#include "hbdatetimeformat_p.h"
+#endif
 
 static const int CURRENCY_FORMAT_SIZE_STEP = 8; 
 
@@ -2578,9 +2581,10 @@ HbExtendedLocale HbExtendedLocale::system()
     \param dateFormat The date format to be used in the formatting. The possible 
     date formats are defined in the hbi18ndef.h header file.
      
-    \attention Only fully implemented on the Symbian platform. On other 
-    platforms, returns a localized string representation of the given date in 
-    short format.
+    \attention Cross-Platform API. On platforms other than Symbian, the date 
+    format is interpreted with the locale settings returned by this class, 
+    for example dateStyle() and dateSeparator(). Each format string is parsed 
+    only once.
 
  */
 QString HbExtendedLocale::format( const QDate &date, const QString &dateFormat )
@@ -2634,8 +2638,10 @@ QString HbExtendedLocale::format( const QDate &date, const QString &dateFormat )
     return TDesC2QString(s60DateStr->Des());
     
 #else
-    Q_UNUSED(dateFormat);
-    return toString(date, ShortFormat );
+    if (!date.isValid()) {
+        return QString();
+    }
+    return HbDateTimeFormat::cached(dateFormat).run(*this, date, QTime(0, 0));
 #endif
 }
 
@@ -2649,9 +2655,10 @@ QString HbExtendedLocale::format( const QDate &date, const QString &dateFormat )
     \param timeFormat The time format to be used in the formatting. The possible 
     time formats are defined in the hbi18ndef.h header file.
      
-    \attention Only fully implemented on the Symbian platform. On other 
-    platforms, returns a localized string representation of the given time in 
-    short format.
+    \attention Cross-Platform API. On platforms other than Symbian, the time 
+    format is interpreted with the locale settings returned by this class, 
+    for example timeStyle() and timeSeparator(). Each format string is parsed 
+    only once.
     
  */
 QString HbExtendedLocale::format( const QTime &time, const QString &timeFormat )
@@ -2703,7 +2710,9 @@ QString HbExtendedLocale::format( const QTime &time, const QString &timeFormat )
     }
     return result;
 #else 
-    Q_UNUSED(timeFormat);
-    return toString(time, ShortFormat);
+    if (!time.isValid()) {
+        return QString();
+    }
+    return HbDateTimeFormat::cached(timeFormat).run(*this, QDate(), time);
 #endif  
 }
@@ -26,7 +26,6 @@
 #include <hbextendedlocale.h>
 #include <QtAlgorithms>
 
-#include "hbstringutil_p.h"
 #include "hbstringutil.h"
 
 #if defined(__SYMBIAN32__)
@@ -39,6 +38,62 @@
 
 #ifndef QT_NO_REGEXP
 #include <QRegExp>
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
+#endif
+
+#if !defined(Q_OS_SYMBIAN) && defined(Q_OS_UNIX) && !defined(Q_OS_MAC)
+// QString::localeAwareCompare() is strcoll() based here, so the same
+// ordering can be reproduced with strxfrm() sort keys.
+#define HB_STRINGUTIL_SORTKEYS
+#include <string.h>
+#include <QVector>
+#ifndef QT_NO_CONCURRENT
+#include <QThread>
+#include <QtConcurrentMap>
+#endif
+#endif
+
+#include "hbstringutil_p.h"
+
+#ifndef QT_NO_REGEXP
+// Maximum number of compiled wildcard patterns kept by matchC() and matchF().
+static const int HbStringUtilMatcherCacheSize = 32;
+
+class HbStringUtilMatcherCache
+{
+public:
+    HbStringUtilMatcherCache() : cache(HbStringUtilMatcherCacheSize) {}
+    QMutex mutex;
+    QCache<QString, QRegExp> cache;
+};
+
+Q_GLOBAL_STATIC(HbStringUtilMatcherCache, matcherCache)
+
+/*
+    Returns a wildcard matcher for \a pattern. Compiled matchers are kept in a
+    small LRU cache so that repeated matchC()/matchF() calls with the same
+    pattern do not construct and compile a new QRegExp every time. The
+    returned copy shares the compiled engine with the cached one.
+*/
+QRegExp hbStringUtil_WildcardMatcher( const QString &pattern, Qt::CaseSensitivity cs )
+{
+    HbStringUtilMatcherCache *matchers = matcherCache();
+    if ( !matchers ) {
+        return QRegExp( pattern, cs, QRegExp::Wildcard );
+    }
+    QString key( pattern );
+    key.prepend( cs == Qt::CaseSensitive ? QLatin1Char('C') : QLatin1Char('F') );
+
+    QMutexLocker locker( &matchers->mutex );
+    QRegExp *matcher = matchers->cache.object( key );
+    if ( !matcher ) {
+        matcher = new QRegExp( pattern, cs, QRegExp::Wildcard );
+        matchers->cache.insert( key, matcher );
+    }
+    return *matcher;
+}
 #endif
 
 /*!
@@ -255,7 +310,7 @@ int HbStringUtil::matchC( const QString &strFrom, const QString &strToMatch,
     return strFrom.indexOf( strToMatch, 0, Qt::CaseSensitive );
 #else    
     // works with standard wildcards
-    QRegExp locStrToMatch( strToMatch, Qt::CaseSensitive, QRegExp::Wildcard );    
+    QRegExp locStrToMatch( hbStringUtil_WildcardMatcher( strToMatch, Qt::CaseSensitive ) );
     return strFrom.indexOf( locStrToMatch, 0 );
 #endif    
     
@@ -404,7 +459,7 @@ int HbStringUtil::matchF( const QString &strFrom,
     // if no regular expressions defined do standard FindF
     return strFrom.indexOf( strToMatch, 0, Qt::CaseInsensitive );
 #else    
-    QRegExp locStrToMatch( strToMatch, Qt::CaseInsensitive, QRegExp::Wildcard );
+    QRegExp locStrToMatch( hbStringUtil_WildcardMatcher( strToMatch, Qt::CaseInsensitive ) );
     return strFrom.indexOf( locStrToMatch, 0 );
 #endif
     
@@ -600,9 +655,34 @@ QString HbStringUtil::convertDigitsTo( const QString str, const DigitType digitT
  */
 void HbStringUtil::sort( QStringList &strList )
 {
+#if defined( HB_STRINGUTIL_SORTKEYS )
+    if ( strList.size() > 1 ) {
+        // Compute the collation key of each string once instead of collating
+        // both strings again in every comparison.
+        QVector<HbStringUtilSortItem> items( strList.size() );
+        for ( int i = 0; i < strList.size(); ++i ) {
+            items[i].string = strList.at(i);
+        }
+#ifndef QT_NO_CONCURRENT
+        if ( items.size() >= HbStringUtilParallelSortKeyLimit && QThread::idealThreadCount() > 1 ) {
+            QtConcurrent::blockingMap( items, hbStringUtil_ComputeSortKey );
+        } else
+#endif
+        {
+            for ( int i = 0; i < items.size(); ++i ) {
+                hbStringUtil_ComputeSortKey( items[i] );
+            }
+        }
+        qSort( items.begin(), items.end(), hbStringUtil_SortKeyHelper );
+        for ( int i = 0; i < items.size(); ++i ) {
+            strList[i] = items.at(i).string;
+        }
+    }
+#else
     if ( strList.size() > 1 ) {
         qSort(strList.begin(), strList.end(), hbStringUtil_SortHelper);
     }
+#endif
 }
 
 bool hbStringUtil_SortHelper( const QString &s1, const QString &s2 )
@@ -615,3 +695,29 @@ bool hbStringUtil_SortHelper( const QString &s1, const QString &s2 )
         return false;
     }           
 }
+
+#if defined( HB_STRINGUTIL_SORTKEYS )
+/*
+    Fills in the collation key of \a item. Comparing two keys with strcmp()
+    gives the same result as strcoll() on the original strings, which is what
+    QString::localeAwareCompare() uses on this platform.
+*/
+void hbStringUtil_ComputeSortKey( HbStringUtilSortItem &item )
+{
+    const QByteArray local = item.string.toLocal8Bit();
+    const size_t length = strxfrm( 0, local.constData(), 0 );
+    item.key.resize( int(length) + 1 );
+    strxfrm( item.key.data(), local.constData(), length + 1 );
+    item.key.resize( int(length) );
+}
+
+bool hbStringUtil_SortKeyHelper( const HbStringUtilSortItem &s1, const HbStringUtilSortItem &s2 )
+{
+    int delta = strcmp( s1.key.constData(), s2.key.constData() );
+    if ( delta == 0 ) {
+        // localeAwareCompare() falls back to comparing the UTF-16 data
+        return s1.string < s2.string;
+    }
+    return delta < 0;
+}
+#endif
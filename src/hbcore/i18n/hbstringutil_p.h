@@ -31,4 +31,25 @@
 
 bool hbStringUtil_SortHelper( const QString &s1, const QString &s2 );
 
+#ifndef QT_NO_REGEXP
+#include <QRegExp>
+QRegExp hbStringUtil_WildcardMatcher( const QString &pattern, Qt::CaseSensitivity cs );
+#endif
+
+#if defined( HB_STRINGUTIL_SORTKEYS )
+#include <QByteArray>
+
+// Lists at least this long get their collation keys computed in parallel.
+static const int HbStringUtilParallelSortKeyLimit = 2048;
+
+struct HbStringUtilSortItem
+{
+    QString string;
+    QByteArray key;
+};
+
+void hbStringUtil_ComputeSortKey( HbStringUtilSortItem &item );
+bool hbStringUtil_SortKeyHelper( const HbStringUtilSortItem &s1, const HbStringUtilSortItem &s2 );
+#endif
+
 #endif // HBSTRINGUTIL_P_H
@@ -29,6 +29,12 @@
 #include <QTranslator> 
 #include <QHash>
 #include <QDir>
+#include <QStringList>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QThread>
 
 #include <hbfindfile.h>
 #include <hbtranslator.h>
@@ -72,6 +78,239 @@ static void toSymbianPath(QString &path) {
 }
 #endif
 
+Q_GLOBAL_STATIC(HbTranslatorCatalogCache, gs_CatalogCache)
+
+/*
+    Application event filter that drops the resolved catalog names on
+    QEvent::LocaleChange. It does not depend on HbMainWindow, so processes
+    without a main window see the new catalogs as well.
+*/
+class HbTranslatorLocaleFilter : public QObject
+{
+public:
+    explicit HbTranslatorLocaleFilter(QObject *parent) : QObject(parent) {}
+
+    bool eventFilter(QObject *watched, QEvent *event)
+    {
+        if (event->type() == QEvent::LocaleChange) {
+            HbTranslatorPrivate::clearCatalogCache();
+        }
+        return QObject::eventFilter(watched, event);
+    }
+};
+
+/*
+    Installs HbTranslatorLocaleFilter on the application, once per
+    application instance. The filter must live in the thread of the
+    application, other threads leave the installing to it.
+*/
+static void watchLocaleChanges()
+{
+    static QPointer<HbTranslatorLocaleFilter> filter;
+    QCoreApplication *app = QCoreApplication::instance();
+    if (!app || app->thread() != QThread::currentThread() || filter) {
+        return;
+    }
+    filter = new HbTranslatorLocaleFilter(app);
+    app->installEventFilter(filter);
+}
+
+/*!
+    \class HbTranslatorCatalogCache
+    \internal
+
+    Process-wide cache of the resolved translation file names and of the
+    memory mappings of the loaded files. Applications create several
+    HbTranslator instances, often for the same catalogs, and each of them
+    would otherwise probe the file system and read the files again.
+
+    The resolved names, including the catalogs that were not found, are
+    dropped when the locale or the UI language changes, because the set of
+    installed catalogs may change with it.
+*/
+
+HbTranslatorCatalogCache *HbTranslatorCatalogCache::instance()
+{
+    return gs_CatalogCache();
+}
+
+HbTranslatorCatalogCache::~HbTranslatorCatalogCache()
+{
+    foreach (const Mapping &mapping, mMappings) {
+        delete mapping.file;
+    }
+}
+
+bool HbTranslatorCatalogCache::resolved(const QString &key, QString &file)
+{
+    QMutexLocker locker(&mMutex);
+    QHash<QString, QString>::const_iterator i = mResolved.constFind(key);
+    if (i == mResolved.constEnd()) {
+        return false;
+    }
+    file = i.value();
+    return true;
+}
+
+void HbTranslatorCatalogCache::setResolved(const QString &key, const QString &file)
+{
+    // Resolved names must be dropped when the locale changes.
+    watchLocaleChanges();
+    QMutexLocker locker(&mMutex);
+    mResolved.insert(key, file);
+}
+
+/*!
+    Forgets the resolved file names. The mappings stay, they are released
+    by the translators that use them.
+*/
+void HbTranslatorCatalogCache::clearResolved()
+{
+    QMutexLocker locker(&mMutex);
+    mResolved.clear();
+}
+
+/*!
+    Returns the number of files that are currently mapped.
+*/
+int HbTranslatorCatalogCache::mappingCount()
+{
+    QMutexLocker locker(&mMutex);
+    return mMappings.count();
+}
+
+/*!
+    Returns the contents of \a file mapped to memory, sharing the mapping
+    with the earlier callers. Every successful call must be paired with
+    unmap().
+*/
+uchar *HbTranslatorCatalogCache::map(const QString &file, int &size)
+{
+    QMutexLocker locker(&mMutex);
+    QHash<QString, Mapping>::iterator i = mMappings.find(file);
+    if (i != mMappings.end()) {
+        ++i.value().refCount;
+        size = i.value().size;
+        return i.value().data;
+    }
+
+    Mapping mapping;
+    mapping.file = new QFile(file);
+    mapping.data = 0;
+    if (mapping.file->open(QIODevice::ReadOnly) && mapping.file->size() > 0) {
+        mapping.data = mapping.file->map(0, mapping.file->size());
+    }
+    if (!mapping.data) {
+        delete mapping.file;
+        return 0;
+    }
+    mapping.size = mapping.file->size();
+    mapping.refCount = 1;
+    mMappings.insert(file, mapping);
+    size = mapping.size;
+    return mapping.data;
+}
+
+void HbTranslatorCatalogCache::unmap(uchar *data)
+{
+    QMutexLocker locker(&mMutex);
+    QHash<QString, Mapping>::iterator i = mMappings.begin();
+    for (; i != mMappings.end(); ++i) {
+        if (i.value().data == data) {
+            if (--i.value().refCount == 0) {
+                delete i.value().file;
+                mMappings.erase(i);
+            }
+            return;
+        }
+    }
+}
+
+#ifdef PLATFORM_WITH_DRIVES
+/*!
+    Like HbFindFile::hbFindFile(), but remembers the result.
+*/
+static bool findCatalog(QString &file, const QChar &drive)
+{
+    HbTranslatorCatalogCache *cache = gs_CatalogCache();
+    QString key = file + QLatin1Char('|') + drive;
+    QString found;
+    if (cache && cache->resolved(key, found)) {
+        if (found.isEmpty()) {
+            return false;
+        }
+        file = found;
+        return true;
+    }
+
+    found = file;
+    bool exists = HbFindFile::hbFindFile(found, drive);
+    if (cache) {
+        cache->setResolved(key, exists ? found : QString());
+    }
+    if (exists) {
+        file = found;
+    }
+    return exists;
+}
+#endif
+
+#ifndef Q_OS_SYMBIAN
+/*!
+    Returns the file QTranslator::load() would pick for \a qmFile, trying
+    the .qm suffix and then shorter names cut at the last '_' or '.'.
+*/
+static QString resolveCatalog(const QString &qmFile)
+{
+    HbTranslatorCatalogCache *cache = gs_CatalogCache();
+    QString found;
+    if (cache && cache->resolved(qmFile, found)) {
+        return found;
+    }
+
+    QString base = qmFile;
+    for (;;) {
+        QFileInfo info(base + QLatin1String(".qm"));
+        if (!info.isFile()) {
+            info.setFile(base);
+        }
+        if (info.isFile() && info.isReadable()) {
+            found = info.filePath();
+            break;
+        }
+        int directory = qMax(base.lastIndexOf(QLatin1Char('/')), base.lastIndexOf(QLatin1Char('\\')));
+        int rightmost = qMax(base.lastIndexOf(QLatin1Char('_')), base.lastIndexOf(QLatin1Char('.')));
+        if (rightmost <= directory + 1) {
+            break;
+        }
+        base.truncate(rightmost);
+    }
+
+    if (cache) {
+        cache->setResolved(qmFile, found);
+    }
+    return found;
+}
+#endif
+
+/*!
+    Releases the data returned by loadTranslatorData().
+*/
+static void releaseTranslatorData(uchar *buffer)
+{
+    if (!buffer) {
+        return;
+    }
+#ifndef Q_OS_SYMBIAN
+    HbTranslatorCatalogCache *cache = gs_CatalogCache();
+    if (cache) {
+        cache->unmap(buffer);
+    }
+#else
+    delete [] buffer;
+#endif
+}
+
 /*!
     Load data from translator
 */
@@ -79,7 +318,23 @@ bool loadTranslatorData(QTranslator &translator, QString &qmFile, uchar* &buffer
 #ifndef Q_OS_SYMBIAN    
     Q_UNUSED(doFallback);
     buffer = 0;
-    return translator.load(qmFile);
+    QString file = resolveCatalog(qmFile);
+    if (file.isEmpty()) {
+        return false;
+    }
+    // The mapping is shared by all translators loading the same file.
+    HbTranslatorCatalogCache *cache = gs_CatalogCache();
+    int size = 0;
+    uchar *data = cache ? cache->map(file, size) : 0;
+    if (!data) {
+        return translator.load(file);
+    }
+    if (!translator.load(data, size)) {
+        cache->unmap(data);
+        return false;
+    }
+    buffer = data;
+    return true;
 #else    
     RFile fl;
     RFs& fs = CCoeEnv::Static()->FsSession();
@@ -222,8 +477,6 @@ HbTranslator::~HbTranslator()
 }
 
 static bool commonTr = false;
-#include <QMutex>
-#include <QMutexLocker>
 Q_GLOBAL_STATIC_WITH_ARGS(QMutex, gs_CommonTrMutex, (QMutex::Recursive) )
 
 /*!
@@ -249,7 +502,7 @@ void HbTranslator::loadCommon()
 #endif        
         bool loaded;
         uchar *commonData = 0;
-        loaded = loadTranslatorData(d->common, commonts, d->commonData);
+        loaded = loadTranslatorData(d->common, commonts, commonData);
         if (loaded) {
             d->commonData = commonData;
             d->commonTr = true;
@@ -265,18 +518,26 @@ void HbTranslator::loadCommon()
 HbTranslatorPrivate::~HbTranslatorPrivate()
 {
     qApp->removeTranslator(&translator);
-    if (translatorData) {
-        delete [] translatorData;
-    }
+    releaseTranslatorData(translatorData);
     qApp->removeTranslator(&common);
-    if (commonData) {        
-        delete [] commonData;
-    }
+    releaseTranslatorData(commonData);
     if (commonTr) {
        ::commonTr=false;
     }    
 }
 
+/*!
+    Drops the cached catalog file names, called when the locale or the UI
+    language changes.
+*/
+void HbTranslatorPrivate::clearCatalogCache()
+{
+    HbTranslatorCatalogCache *cache = gs_CatalogCache();
+    if (cache) {
+        cache->clearResolved();
+    }
+}
+
 /*!
     Internal function for common operations of HbTranslator.  
      
@@ -307,36 +568,20 @@ void HbTranslatorPrivate::installTranslator(const QString &pth, const QString &n
             drive = filepath.at(0);
         }    
                 
-        QString tsfile = path + name + QString("_") + lang;
-        QString tsfileQM = tsfile + QString(".qm"); 
-    
-        bool loaded = false;    
-        if (HbFindFile::hbFindFile(tsfileQM, drive)) {
-            tsfileQM.chop(3);        
-            loaded = loadTranslatorData(translator,tsfileQM,translatorData);        
-        } else {
-            tsfile = path + name + QString("_") + lang2;
-            tsfileQM = tsfile + QString(".qm");
-            if (HbFindFile::hbFindFile(tsfileQM, drive)) {
+        // The last fallback found was loaded over the earlier ones, so en_US
+        // takes precedence over en.
+        QStringList candidates;
+        candidates << lang << lang2 << QString("en_US") << QString("en");
+        bool loaded = false;
+        foreach (const QString &candidate, candidates) {
+            QString tsfileQM = path + name + QString("_") + candidate + QString(".qm");
+            if (findCatalog(tsfileQM, drive)) {
                 tsfileQM.chop(3);
-                loaded = loadTranslatorData(translator,tsfileQM,translatorData);        
-            } else {
-                QList<QString> fallBack;
-                fallBack.append("en");
-                fallBack.append("en_US");
-                int len = fallBack.length();
-                for (int i=0; i<len; i++) {
-                    QString lang;
-                    tsfile = path + name + QString("_") + fallBack.at(i);
-                    tsfileQM = tsfile + QString(".qm");
-                    if (HbFindFile::hbFindFile(tsfileQM, drive)) {
-                        tsfileQM.chop(3);
-                        loaded = loadTranslatorData(translator,tsfileQM,translatorData);        
-                    }    
-                }        
+                loaded = loadTranslatorData(translator,tsfileQM,translatorData);
+                break;
             }
         }
-           
+
         if (loaded) {
             qApp->installTranslator(&translator);
             return;
@@ -346,7 +591,7 @@ void HbTranslatorPrivate::installTranslator(const QString &pth, const QString &n
 #ifndef Q_OS_SYMBIAN
     // This is for other platforms than Symbian        
     QString tsfile3 = path + name + QString("_") + lang;
-    if ( translator.load(tsfile3) ) {
+    if (loadTranslatorData(translator, tsfile3, translatorData)) {
         qApp->installTranslator(&translator);
     }
 #endif    
@@ -26,11 +26,46 @@
 #ifndef HBTRANSLATOR_P_H
 #define HBTRANSLATOR_P_H
 
-class QTranslator;
+#include <hbglobal.h>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QTranslator>
+
+class QFile;
+
+class HB_AUTOTEST_EXPORT HbTranslatorCatalogCache
+{
+public:
+    static HbTranslatorCatalogCache *instance();
+    ~HbTranslatorCatalogCache();
+
+    bool resolved(const QString &key, QString &file);
+    void setResolved(const QString &key, const QString &file);
+    void clearResolved();
+    uchar *map(const QString &file, int &size);
+    void unmap(uchar *data);
+    int mappingCount();
+
+private:
+    struct Mapping {
+        QFile *file;
+        uchar *data;
+        int size;
+        int refCount;
+    };
+
+    QMutex mMutex;
+    // Empty file name means that the catalog was not found.
+    QHash<QString, QString> mResolved;
+    QHash<QString, Mapping> mMappings;
+};
 
 class HB_CORE_PRIVATE_EXPORT HbTranslatorPrivate
 {
 public:
+    static void clearCatalogCache();
+
     void installTranslator(const QString &name, const QString &path);
     bool languageDowngrade(QString &lang);
     HbTranslatorPrivate(): translatorData(0), commonData(0), commonTr(false) {}
@@ -43,6 +43,7 @@ PRIVATE_HEADERS += $$PWD/hbdirectorynamelocalizer_p.h
 PRIVATE_HEADERS += $$PWD/hbstringutil_p.h
 PRIVATE_HEADERS += $$PWD/hbparameterlengthlimiter_p.h
 PRIVATE_HEADERS += $$PWD/hbtranslator_p.h
+PRIVATE_HEADERS += $$PWD/hbdatetimeformat_p.h
 
 SOURCES += $$PWD/hbextendedlocale.cpp
 SOURCES += $$PWD/hbstringutil.cpp
@@ -55,6 +56,7 @@ SOURCES += $$PWD/hbparameterlengthlimiter.cpp
 SOURCES += $$PWD/hbtranslator.cpp
 SOURCES += $$PWD/hbfindfile.cpp
 SOURCES += $$PWD/hblocaleutil.cpp
+SOURCES += $$PWD/hbdatetimeformat.cpp
 
 symbian:LIBS += -leuser -lhal -lcentralrepository -lptiengine -lSysLangUtil
 symbian:TARGET.CAPABILITY += WriteDeviceData
@@ -336,7 +336,10 @@ HbIconAnimationImage::HbIconAnimationImage(
     mIconFileName(iconFileName),
     mType(type),
     mTimerEntry(0),
-    mDoNotResetLoopCount(false)
+    mDoNotResetLoopCount(false),
+    mFrameIndex(0),
+    mRecording(true),
+    mRecordedCost(0)
 {
     // This class supports these types
     Q_ASSERT(mType == MNG || mType == GIF);
@@ -347,12 +350,13 @@ HbIconAnimationImage::HbIconAnimationImage(
 
     // Store the first frame in the current frame pixmap
     mCurrentFrame = QPixmap::fromImage(img);
+    recordFrame(mCurrentFrame, mImageRenderer->nextImageDelay());
 
     // Set default size based on the first frame
     setDefaultSize(mCurrentFrame.size());
 
     // Get the loop count. -1 means infinite loop.
-    mLoopCount = mImageRenderer->loopCount();
+    mLoopCount = mReaderLoopCount = mImageRenderer->loopCount();
     mCustomLoopCountSet = false;
 
     // Do not start the timer or initiate any signal emission here.
@@ -387,7 +391,18 @@ void HbIconAnimationImage::start()
     }
     if (mFresh) {
         mFresh = false;
-        mTimerInterval = mImageRenderer->nextImageDelay();
+        if (playCachedFrames()) {
+            // Another animation has already decoded the frames.
+            const HbIconAnimationFrames::Frame &first = mFrames->frames.first();
+            mFrameIndex = 0;
+            mCurrentFrame = first.pixmap;
+            mTimerInterval = first.delay;
+            if (!mCustomLoopCountSet) {
+                mLoopCount = mFrames->loopCount;
+            }
+        } else {
+            mTimerInterval = mImageRenderer->nextImageDelay();
+        }
         mTimerEntry = HbTimer::instance()->addTimeout(mTimerInterval, this, SLOT(handleAnimationUpdated()));
         // Emit the signal later as nobody is connected at this point (if the
         // animation is auto-started, because the start() comes straight after
@@ -396,10 +411,20 @@ void HbIconAnimationImage::start()
     } else {
         stopTimer(mTimerEntry);
 
-        // Recreate the image reader. It's slow but QImageReader::jumpToImage does not work.
-        delete mImageRenderer;
-        mImageRenderer = 0;
-        mImageRenderer = new QImageReader(mIconFileName, mType == MNG ? "MNG" : "GIF");
+        // Restart from the decoded frames when available. Otherwise recreate
+        // the image reader. It's slow but QImageReader::jumpToImage does not work.
+        if (!playCachedFrames()) {
+            delete mImageRenderer;
+            mImageRenderer = 0;
+            mImageRenderer = new QImageReader(mIconFileName, mType == MNG ? "MNG" : "GIF");
+            mReaderLoopCount = mImageRenderer->loopCount();
+            mFrames.reset();
+            mFramesKey.clear();
+            mLastFrame = QPixmap();
+            mRecordedFrames.clear();
+            mRecordedCost = 0;
+            mRecording = true;
+        }
 
         if (mDoNotResetLoopCount) {
             mDoNotResetLoopCount = false;
@@ -408,11 +433,11 @@ void HbIconAnimationImage::start()
             if (mCustomLoopCountSet) {
                 mLoopCount = mCustomLoopCount;
             } else {
-                mLoopCount = mImageRenderer->loopCount();
+                mLoopCount = mReaderLoopCount;
             }
         }
 
-        // New image reader starts from the first frame. Handle animation update.
+        // Start from the first frame. Handle animation update.
         notifyAnimationStarted();
         handleAnimationUpdated();
     }
@@ -431,7 +456,13 @@ void HbIconAnimationImage::stop()
     // Has the last frame been read already?
     if (!mLastFrame.isNull()) {
         mCurrentFrame = mLastFrame;
+    } else if (!mImageRenderer) {
+        mCurrentFrame = mLastFrame = mFrames->frames.last().pixmap;
     } else {
+        // The frames read ahead here are not recorded.
+        mRecording = false;
+        mRecordedFrames.clear();
+
         // Read all frames until the last one.
         // QImageReader::jumpToImage does not work so cannot jump to the last frame if it has not been read yet.
         while (true) {
@@ -472,7 +503,11 @@ QPixmap HbIconAnimationImage::currentFrame() const
     QPixmap canvasPixmap;
 
     if (!pixelSize.isEmpty()) {
-        if (pixelSize != mCurrentFrame.size()) {
+        // Frames from the cache are already scaled to the render size.
+        bool prescaled = !mImageRenderer
+                         && mFrames->renderSize == pixelSize
+                         && mFrames->aspectRatioMode == mAspectRatioMode;
+        if (!prescaled && pixelSize != mCurrentFrame.size()) {
             canvasPixmap = mCurrentFrame.scaled(pixelSize, mAspectRatioMode, Qt::SmoothTransformation);
         } else {
             canvasPixmap = mCurrentFrame;
@@ -518,35 +553,140 @@ bool HbIconAnimationImage::loopCountSet(int *loopCount)
     return mCustomLoopCountSet;
 }
 
-void HbIconAnimationImage::handleAnimationUpdated()
+QString HbIconAnimationImage::frameCacheKey() const
 {
-    bool finished = false;
+    return HbIconAnimationManagerPrivate::frameCacheKey(mIconFileName,
+                                                        renderSize().toSize(),
+                                                        mAspectRatioMode);
+}
 
-    // Read the new frame. QImageReader::read() must be called before
-    // QImageReader::nextImageDelay()
-    QImage img = mImageRenderer->read();
+/*
+  Switches to playing the decoded frames of the frame cache, when the frames
+  for the current render size are available. The frames are then played from
+  the start.
+*/
+bool HbIconAnimationImage::playCachedFrames()
+{
+    QString key = frameCacheKey();
+    if (mFrames && mFramesKey == key) {
+        // Restarting the loop with the frames this animation already shares.
+        mAnimMgrD->countFrameCacheHit();
+    } else {
+        HbIconAnimationFramesPtr frames = mAnimMgrD->findFrames(key);
+        if (!frames || frames->frames.isEmpty()) {
+            return false;
+        }
+        mFrames = frames;
+        mFramesKey = key;
+    }
+    delete mImageRenderer;
+    mImageRenderer = 0;
+    mRecording = false;
+    mRecordedFrames.clear();
+    mLastFrame = QPixmap();
+    mReaderLoopCount = mFrames->loopCount;
+    mFrameIndex = -1;
+    return true;
+}
 
-    int delay = mImageRenderer->nextImageDelay();
-    // If there is next image, restart the timer
-    if (!img.isNull() && delay > 0) {
-        // Restart timer
-        mTimerInterval = delay;
-        mTimerEntry = HbTimer::instance()->addTimeout(mTimerInterval, this, SLOT(handleAnimationUpdated()));
+void HbIconAnimationImage::recordFrame(const QPixmap &frame, int delay)
+{
+    if (!mRecording) {
+        return;
     }
+    // Give up when the frames would not fit in the cache anyway.
+    mRecordedCost += frame.width() * frame.height() * 4 / 1024 + 1;
+    if (mRecordedCost > mAnimMgrD->frameCacheBudget()) {
+        mRecording = false;
+        mRecordedFrames.clear();
+        return;
+    }
+    HbIconAnimationFrames::Frame f;
+    f.pixmap = frame;
+    f.delay = delay;
+    mRecordedFrames.append(f);
+}
 
-    // Store the new frame in the current frame pixmap
-    if (!img.isNull()) {
-        // Must get rid of the old pixmap first, in case of very large frames
-        // keeping both the old and new frame in memory would not succeed.
-        // (with the OpenVG paint engine QPixmap will create a new QImage if
-        // the pixel format is different and it will be different here...)
-        mCurrentFrame = QPixmap(); // This call is not superfluous.
-        mCurrentFrame = QPixmap::fromImage(img);
+/*
+  Called when the image reader has delivered all the frames. Scales them to
+  the current render size and shares them with other animations of the same
+  file.
+*/
+void HbIconAnimationImage::publishFrames()
+{
+    mRecording = false;
+    if (mRecordedFrames.isEmpty()) {
+        return;
+    }
+    QSize size = renderSize().toSize();
+    HbIconAnimationFramesPtr frames(new HbIconAnimationFrames);
+    frames->loopCount = mReaderLoopCount;
+    frames->renderSize = size;
+    frames->aspectRatioMode = mAspectRatioMode;
+    int cost = 0;
+    foreach(HbIconAnimationFrames::Frame frame, mRecordedFrames) {
+        if (!size.isEmpty() && frame.pixmap.size() != size) {
+            frame.pixmap = frame.pixmap.scaled(size, mAspectRatioMode, Qt::SmoothTransformation);
+        }
+        cost += frame.pixmap.width() * frame.pixmap.height() * 4 / 1024 + 1;
+        frames->frames.append(frame);
     }
-    // Reached the last frame. Store it so it can be used by stop().
-    else {
-        mLastFrame = mCurrentFrame;
-        finished = true;
+    mRecordedFrames.clear();
+
+    mFramesKey = frameCacheKey();
+    mFrames = frames;
+    mAnimMgrD->insertFrames(mFramesKey, mFrames, cost);
+}
+
+void HbIconAnimationImage::handleAnimationUpdated()
+{
+    bool finished = false;
+
+    if (!mImageRenderer) {
+        // Playing the decoded frames.
+        ++mFrameIndex;
+        if (mFrameIndex < mFrames->frames.count()) {
+            const HbIconAnimationFrames::Frame &frame = mFrames->frames.at(mFrameIndex);
+            mCurrentFrame = frame.pixmap;
+            if (frame.delay > 0) {
+                mTimerInterval = frame.delay;
+                mTimerEntry = HbTimer::instance()->addTimeout(mTimerInterval, this, SLOT(handleAnimationUpdated()));
+            }
+        } else {
+            mLastFrame = mCurrentFrame;
+            finished = true;
+        }
+    } else {
+        // Read the new frame. QImageReader::read() must be called before
+        // QImageReader::nextImageDelay()
+        QImage img = mImageRenderer->read();
+
+        int delay = mImageRenderer->nextImageDelay();
+        // If there is next image, restart the timer
+        if (!img.isNull() && delay > 0) {
+            // Restart timer
+            mTimerInterval = delay;
+            mTimerEntry = HbTimer::instance()->addTimeout(mTimerInterval, this, SLOT(handleAnimationUpdated()));
+        }
+
+        // Store the new frame in the current frame pixmap
+        if (!img.isNull()) {
+            // Must get rid of the old pixmap first, in case of very large frames
+            // keeping both the old and new frame in memory would not succeed.
+            // (with the OpenVG paint engine QPixmap will create a new QImage if
+            // the pixel format is different and it will be different here...)
+            mCurrentFrame = QPixmap(); // This call is not superfluous.
+            mCurrentFrame = QPixmap::fromImage(img);
+            recordFrame(mCurrentFrame, delay);
+        }
+        // Reached the last frame. Store it so it can be used by stop().
+        else {
+            mLastFrame = mCurrentFrame;
+            finished = true;
+            if (mRecording) {
+                publishFrames();
+            }
+        }
     }
 
 #ifdef HB_ICON_TRACES
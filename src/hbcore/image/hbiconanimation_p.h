@@ -28,6 +28,7 @@
 
 #include <hbglobal.h>
 #include <hbiconanimationdefinition.h>
+#include "hbiconanimationmanager_p.h"
 #include <QtGlobal>
 #include <QTimer>
 #include <QObject>
@@ -216,6 +217,11 @@ private slots:
     void handleAnimationUpdated();
 
 private:
+    QString frameCacheKey() const;
+    bool playCachedFrames();
+    void recordFrame(const QPixmap &frame, int delay);
+    void publishFrames();
+
     QImageReader *mImageRenderer;
     QString mIconFileName;
     int mType;
@@ -227,6 +233,17 @@ private:
     int mLoopCount;
     bool mCustomLoopCountSet;
     int mCustomLoopCount;
+
+    // Frames shared through the frame cache of the animation manager. When
+    // these are played the image reader is not needed.
+    HbIconAnimationFramesPtr mFrames;
+    QString mFramesKey;
+    int mFrameIndex;
+    int mReaderLoopCount;
+    // Frames decoded during the first pass, published when the pass completes.
+    QList<HbIconAnimationFrames::Frame> mRecordedFrames;
+    bool mRecording;
+    int mRecordedCost;
 };
 
 class HbIconAnimationFrameSet : public HbIconAnimation
@@ -33,20 +33,32 @@
 #include "hbiconanimator.h"
 #include "hbiconanimator_p.h"
 #include "hbtheme.h"
+#include "hbtheme_p.h"
 #include "hbiconanimation_p.h"
 #include "hbimagetraces_p.h"
 
 // Private class
 
+// Memory budget of the shared frame cache in kilobytes.
+const int frame_cache_budget = 4096;
+
 /*!
 \internal
 */
 HbIconAnimationManagerPrivate::HbIconAnimationManagerPrivate() :
-    viewChangeConnected(false)
+    viewChangeConnected(false),
+    frameCache(frame_cache_budget),
+    frameCacheHitCount(0),
+    frameCacheMissCount(0)
 {
     fgWatcher = HbForegroundWatcher::instance();
     connect(fgWatcher, SIGNAL(resumeAnimation()), SLOT(handleAnimationResume()));
     connect(fgWatcher, SIGNAL(stopAnimation()), SLOT(handleAnimationPause()));
+    // The manager is created by the icon loader, before any icon engine
+    // connects to iconsUpdated(), so the frame cache is cleared before the
+    // icons reload their content from the new theme.
+    connect(&hbInstance->theme()->d_ptr->iconTheme, SIGNAL(iconsUpdated(QStringList)),
+            SLOT(handleIconsUpdated()));
     connect(hbInstance->theme(), SIGNAL(changed()), SLOT(handleThemeChanged()));
     connect(hbInstance->theme(), SIGNAL(changeFinished()), SLOT(handleThemeChangeFinished()));
 }
@@ -200,6 +212,58 @@ void HbIconAnimationManagerPrivate::handleThemeChanged()
     }
 }
 
+/*!
+  \internal
+*/
+void HbIconAnimationManagerPrivate::handleIconsUpdated()
+{
+    // The files may resolve to different graphics in the new theme.
+    frameCache.clear();
+}
+
+/*!
+\internal
+
+Returns the key of the frame cache for the given file, size and aspect ratio mode.
+*/
+QString HbIconAnimationManagerPrivate::frameCacheKey(const QString &fileName,
+                                                     const QSize &renderSize,
+                                                     Qt::AspectRatioMode aspectRatioMode)
+{
+    return QString("%1|%2x%3|%4").arg(fileName).arg(renderSize.width())
+           .arg(renderSize.height()).arg(int(aspectRatioMode));
+}
+
+/*!
+\internal
+
+Returns the cached frames for \a key or a null pointer. Updates the hit and miss counters.
+*/
+HbIconAnimationFramesPtr HbIconAnimationManagerPrivate::findFrames(const QString &key)
+{
+    HbIconAnimationFramesPtr *frames = frameCache.object(key);
+    if (frames) {
+        ++frameCacheHitCount;
+        return *frames;
+    }
+    ++frameCacheMissCount;
+    return HbIconAnimationFramesPtr();
+}
+
+/*!
+\internal
+
+Stores \a frames in the cache. The least recently used entries are dropped
+when the budget is exceeded. Animations still playing the dropped frames keep
+their own reference.
+*/
+void HbIconAnimationManagerPrivate::insertFrames(const QString &key,
+                                                 const HbIconAnimationFramesPtr &frames,
+                                                 int cost)
+{
+    frameCache.insert(key, new HbIconAnimationFramesPtr(frames), cost);
+}
+
 /*!
   \internal
 */
@@ -449,4 +513,28 @@ HbIconAnimationDefinition HbIconAnimationManager::getDefinition(const QString &i
     return d->getDefinition(iconName);
 }
 
+/*!
+* Returns how many times an animation found its decoded frames in the shared
+* frame cache since the application was started. Restarting a looping
+* animation from its decoded frames counts as a hit.
+*
+* \sa frameCacheMisses()
+*/
+int HbIconAnimationManager::frameCacheHits() const
+{
+    return d->frameCacheHits();
+}
+
+/*!
+* Returns how many times an animation had to decode its frames because they
+* were not in the shared frame cache. The cache is emptied when the theme
+* changes.
+*
+* \sa frameCacheHits()
+*/
+int HbIconAnimationManager::frameCacheMisses() const
+{
+    return d->frameCacheMisses();
+}
+
 // End of File
@@ -52,6 +52,9 @@ public:
 
     HbIconAnimationDefinition getDefinition(const QString &iconName);
 
+    int frameCacheHits() const;
+    int frameCacheMisses() const;
+
 private:
     Q_DISABLE_COPY(HbIconAnimationManager)
     HbIconAnimationManagerPrivate *d;
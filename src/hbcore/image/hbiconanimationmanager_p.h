@@ -31,11 +31,31 @@
 #include "hbiconanimationdatatypes_p.h"
 #include <hbglobal.h>
 #include <QSet>
+#include <QCache>
+#include <QPixmap>
+#include <QSharedData>
 
 class HbForegroundWatcher;
 class HbIconAnimation;
 class HbView;
 
+// Decoded frames of an animated image file, scaled to one render size.
+class HbIconAnimationFrames : public QSharedData
+{
+public:
+    struct Frame {
+        QPixmap pixmap;
+        int delay;
+    };
+
+    QList<Frame> frames;
+    int loopCount;
+    QSize renderSize;
+    Qt::AspectRatioMode aspectRatioMode;
+};
+
+typedef QExplicitlySharedDataPointer<HbIconAnimationFrames> HbIconAnimationFramesPtr;
+
 class HB_CORE_PRIVATE_EXPORT HbIconAnimationManagerPrivate : public QObject
 {
     Q_OBJECT
@@ -58,6 +78,15 @@ public:
     void animPlaying(HbIconAnimation *anim);
     void animNotPlaying(HbIconAnimation *anim);
 
+    static QString frameCacheKey(const QString &fileName, const QSize &renderSize,
+                                 Qt::AspectRatioMode aspectRatioMode);
+    HbIconAnimationFramesPtr findFrames(const QString &key);
+    void insertFrames(const QString &key, const HbIconAnimationFramesPtr &frames, int cost);
+    int frameCacheBudget() const { return frameCache.maxCost(); }
+    int frameCacheHits() const { return frameCacheHitCount; }
+    int frameCacheMisses() const { return frameCacheMissCount; }
+    void countFrameCacheHit() { ++frameCacheHitCount; }
+
     static HbIconAnimationManagerPrivate *d_ptr(HbIconAnimationManager *mgr) {
         return mgr->d;
     }
@@ -66,6 +95,7 @@ public slots:
     void handleAnimationResume();
     void handleAnimationPause();
     void handleThemeChanged();
+    void handleIconsUpdated();
     void handleThemeChangeFinished();
     void handleViewChanged(HbView *);
 
@@ -86,6 +116,12 @@ private:
     QSet<QString> allDefNames;
 
     bool viewChangeConnected;
+
+    // Decoded frames of animated image files shared by all the animations
+    // playing the same file at the same size. The cost is in kilobytes.
+    QCache<QString, HbIconAnimationFramesPtr> frameCache;
+    int frameCacheHitCount;
+    int frameCacheMissCount;
 };
 
 #endif // HBICONANIMATIONMANAGER_P_H
@@ -45,6 +45,7 @@
 #include "hbiconsource_p.h"
 #include "hbthemeindex_p.h"
 #include "hbthemecommon_p.h"
+#include "hbframeprofiler_p.h"
 #include <QDir>
 #include <QCoreApplication>
 #include <QDebug>
@@ -61,9 +62,9 @@
 #include <QMutex>
 #include <QMutexLocker>
 
+#include "hbnvgrasterizer_p.h"
 #ifdef HB_NVG_CS_ICON
 #include "hbeglstate_p.h"
-#include "hbnvgrasterizer_p.h"
 #endif
 
 // SVG animation is currently disabled because of bugs in QT's svg engine
@@ -1455,7 +1456,6 @@ void HbIconLoader::loadPixmapIcon(HbIconLoadingParams &params, const QString &fo
 
 void HbIconLoader::loadNvgIcon(HbIconLoadingParams &params )
 {
-#ifdef HB_NVG_CS_ICON
     HbIconSource *source = getIconSource(params.iconFileName, "NVG");
     if (!source) {
         return;
@@ -1487,11 +1487,6 @@ void HbIconLoader::loadNvgIcon(HbIconLoadingParams &params )
     if (success) {
         params.image = image;
     }
-
-#else
-    Q_UNUSED(params)
-#endif
-
 }
 
 /*!
@@ -1593,6 +1588,7 @@ HbIconImpl *HbIconLoader::loadIcon(
 #ifdef HB_ICON_TRACES
     qDebug() << "loadIcon" << iconName << size;
 #endif
+    HbFrameProfilerScope profilerScope(HbFrameProfiler::IconLoad);
     Q_UNUSED(type)
 
     HbIconImpl *icon = 0;
@@ -79,12 +79,16 @@ QString iconTypeFromFilename(const QString &iconPath)
     return iconPath.section('.', -1);
 }
 
+#endif // HB_BOOTSTRAPPED
+
+#if defined(HB_BOOTSTRAPPED) || !defined(HB_NVG_CS_ICON)
+
 static const qint32 NVG_VIEWBOX_WIDTH_OFS   = 44;
 static const qint32 NVG_VIEWBOX_HEIGHT_OFS  = 48;
 
 // Copied from HbNvgEnginePrivate::contentDimensions,
-// to avoid NVG dependency in ThemeIndexer
-QSize nvgContentDimensions(const QByteArray &buffer)
+// to avoid NVG dependency in ThemeIndexer and in builds without OpenVG
+static QSize nvgContentDimensions(const QByteArray &buffer)
 {
     QSize ret(0, 0);
     if (buffer.length() < static_cast<qint32>(NVG_VIEWBOX_HEIGHT_OFS + sizeof(float))) {
@@ -106,8 +110,7 @@ QSize nvgContentDimensions(const QByteArray &buffer)
     return ret;
 }
 
-
-#endif // HB_BOOTSTRAPPED
+#endif // HB_BOOTSTRAPPED || !HB_NVG_CS_ICON
 
 /*!
   \class HbIconSource
@@ -183,6 +186,10 @@ QSizeF HbIconSource::defaultSize()
             }
             HbNvgEngine nvgEngine;
             mDefaultSize = nvgEngine.contentDimensions(*mByteArray);
+#else // HB_NVG_CS_ICON
+            if (byteArray()) {
+                mDefaultSize = nvgContentDimensions(*mByteArray);
+            }
 #endif // HB_NVG_CS_ICON
 #else // HB_BOOTSTRAPPED
 
@@ -278,13 +285,11 @@ void HbIconSource::takeSvgRenderer()
 QByteArray *HbIconSource::byteArray()
 {
     if (!mByteArray) {
-#ifdef HB_NVG_CS_ICON
         QFile file(mFilename);
         if (!file.open(QIODevice::NotOpen | QIODevice::ReadOnly)) {
             return 0;
         }
         mByteArray = new QByteArray(file.readAll());
-#endif
     }
 
     if (mByteArray && !mByteArray->isEmpty()) {
@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "hbnvgrasterizer_p.h"
+#include "hbnvgsoftwarerenderer_p.h"
 
 #if defined (HB_NVG_CS_ICON)
 #include <nvg.h>
@@ -37,7 +38,6 @@ struct HbNvgAspectRatioSettings
     TNvgAlignStatusType nvgAlignStatusAndAspectRatio;
     TNvgMeetOrSliceType type;
 };
-#endif //HB_NVG_CS_ICON
 
 /*!
     \fn mapKeyAspectRatioToNvgAspectRatio()
@@ -107,6 +107,7 @@ VGIColorBufferFormat mapToVgiDisplayFormat(QImage::Format imageFormat)
     }
     return format;
 }
+#endif //HB_NVG_CS_ICON
 
 Q_GLOBAL_STATIC(HbNvgRasterizer, globalNvgRasterizer);
 
@@ -128,6 +129,7 @@ bool HbNvgRasterizer::initialize(int width, int height)
 {
     vgiSymbianInit = false;
 
+#if defined (HB_NVG_CS_ICON)
     TInt err =  VGISymbianInitialize( TSize(width, height), VGI_COLORSPACE_SRGB );
     if( err == KErrAlreadyExists || err == KErrNone) {
         vgiSymbianInit = true;
@@ -139,18 +141,24 @@ bool HbNvgRasterizer::initialize(int width, int height)
             return (vgiSymbianInit = false);
         }
     }
+#else
+    Q_UNUSED(width);
+    Q_UNUSED(height);
+#endif
 
     return vgiSymbianInit;
 }
 
 bool HbNvgRasterizer::terminate()
 {
+#if defined (HB_NVG_CS_ICON)
     if (vgiSymbianInit) {
         delete nvgEngine;
         nvgEngine = 0;
         VGISymbianTerminate();
         vgiSymbianInit = false;
     }
+#endif
 
     return true;
 }
@@ -165,8 +173,8 @@ bool HbNvgRasterizer::rasterize(const QByteArray &nvgData,
         destination = QImage(renderSize.toSize(), imageFormat);
     }
 
-    TUint8 * imageData = destination.bits();
-    TInt stride = destination.bytesPerLine();
+    uchar *imageData = destination.bits();
+    int stride = destination.bytesPerLine();
 
     return rasterize(nvgData, renderSize, aspectRatioMode, imageData, stride, imageFormat);
 }
@@ -176,16 +184,31 @@ bool HbNvgRasterizer::rasterize(const QByteArray &nvgData,
                Qt::AspectRatioMode aspectRatioMode,
                void * destination, int stride,
                QImage::Format imageFormat)
+{
+#if defined (HB_NVG_CS_ICON)
+    if (vgiSymbianInit || initialize(renderSize.width(), renderSize.height())) {
+        return rasterizeWithOpenVg(nvgData, renderSize, aspectRatioMode,
+                                   destination, stride, imageFormat);
+    }
+#endif
+
+    // No OpenVG, render with QPainter directly to the destination buffer.
+    QSize size = renderSize.toSize();
+    QImage image(static_cast<uchar *>(destination), size.width(), size.height(),
+                 stride, imageFormat);
+    return HbNvgSoftwareRenderer().rasterize(nvgData, size, aspectRatioMode, image);
+}
+
+#if defined (HB_NVG_CS_ICON)
+bool HbNvgRasterizer::rasterizeWithOpenVg(const QByteArray &nvgData,
+               const QSizeF &renderSize,
+               Qt::AspectRatioMode aspectRatioMode,
+               void * destination, int stride,
+               QImage::Format imageFormat)
 {
     bool isIconCreated = false;
     TSize surfaceSize(TSize(renderSize.width(), renderSize.height()));
 
-    if (!vgiSymbianInit) {
-        if (!initialize(surfaceSize.iWidth, surfaceSize.iHeight)) {
-            return isIconCreated;
-        }
-    }
-
     TInt err = VGISymbianResize(surfaceSize);
     if(err != KErrNone) {
         return isIconCreated;
@@ -213,4 +236,4 @@ bool HbNvgRasterizer::rasterize(const QByteArray &nvgData,
 
     return isIconCreated;
 }
-
+#endif //HB_NVG_CS_ICON
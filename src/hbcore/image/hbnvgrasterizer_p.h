@@ -55,6 +55,14 @@ public :
     bool terminate();
 
 private:
+#if defined (HB_NVG_CS_ICON)
+    bool rasterizeWithOpenVg(const QByteArray &nvgData,
+                             const QSizeF &renderSize,
+                             Qt::AspectRatioMode aspectRatioMode,
+                             void * destination, int stride,
+                             QImage::Format imageFormat);
+#endif
+
     bool vgiSymbianInit;
     CNvgEngine * nvgEngine;
 };
@@ -0,0 +1,695 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the HbCore module of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include "hbnvgsoftwarerenderer_p.h"
+
+#include <QPainter>
+#include <QPainterPath>
+#include <qmath.h>
+#include <string.h>
+
+/*
+  The NVG-CS format, as read by HbNvgCsIcon. The values are the same as in
+  hbnvgcsicon.cpp and the OpenVG headers, which are not available here.
+ */
+static const char nvg_signature[] = "nvg";
+static const int nvg_version_ofs = 3;
+static const int nvg_headersize_ofs = 4;
+static const int nvg_pathdatatype_ofs = 26;
+static const int nvg_viewbox_x_ofs = 36;
+static const int nvg_viewbox_y_ofs = 40;
+static const int nvg_viewbox_width_ofs = 44;
+static const int nvg_viewbox_height_ofs = 48;
+static const int nvg_version2 = 2;
+
+static const quint32 cmd_set_fill_paint = 4 << 24;
+static const quint32 cmd_set_stroke_paint = 5 << 24;
+static const quint32 cmd_set_color_ramp = 6 << 24;
+static const quint32 cmd_draw_path = 7 << 24;
+static const quint32 cmd_set_transformation = 8 << 24;
+static const quint32 cmd_set_stroke_width = 9 << 24;
+static const quint32 cmd_set_stroke_line_join_cap = 10 << 24;
+static const quint32 cmd_set_stroke_miter_limit = 11 << 24;
+
+static const int paint_flat = 1;
+static const int paint_lgrad = 2;
+static const int paint_rgrad = 3;
+static const int stroke_color_ramp = 4;
+
+static const int cap_square = 2;
+static const int cap_round = 3;
+static const int line_join_bevel = 1;
+static const int line_join_round = 3;
+
+static const int transform_complete = 0;
+static const int transform_identity = 1;
+static const int transform_scaling = 2;
+static const int transform_shearing = 4;
+static const int transform_rotation = 8;
+static const int transform_translation = 16;
+
+static const int path_sixteen_bit_encoding = 2;
+static const int path_thirty_two_bit_encoding = 3;
+
+// OpenVG path segment commands, the lowest bit selects relative coordinates.
+enum {
+    SegmentClose = 0,
+    SegmentMoveTo = 2,
+    SegmentLineTo = 4,
+    SegmentHLineTo = 6,
+    SegmentVLineTo = 8,
+    SegmentQuadTo = 10,
+    SegmentCubicTo = 12,
+    SegmentSQuadTo = 14,
+    SegmentSCubicTo = 16,
+    SegmentSCCWArcTo = 18,
+    SegmentSCWArcTo = 20,
+    SegmentLCCWArcTo = 22,
+    SegmentLCWArcTo = 24
+};
+
+/*
+  Bounds checked access to the icon data. Reading outside the data returns
+  zero and marks the reader failed.
+ */
+class HbNvgReader
+{
+public:
+    HbNvgReader(const QByteArray &data) :
+        mData(reinterpret_cast<const uchar *>(data.constData())),
+        mLength(data.size()),
+        mOk(true)
+    {
+    }
+
+    bool ok() const { return mOk; }
+
+    bool check(int offset, int size)
+    {
+        if (offset < 0 || size < 0 || offset > mLength - size) {
+            mOk = false;
+        }
+        return mOk;
+    }
+
+    quint8 uint8(int offset)
+    {
+        return check(offset, 1) ? mData[offset] : 0;
+    }
+
+    quint16 uint16(int offset)
+    {
+        quint16 value = 0;
+        if (check(offset, sizeof(value))) {
+            memcpy(&value, mData + offset, sizeof(value));
+        }
+        return value;
+    }
+
+    quint32 uint32(int offset)
+    {
+        quint32 value = 0;
+        if (check(offset, sizeof(value))) {
+            memcpy(&value, mData + offset, sizeof(value));
+        }
+        return value;
+    }
+
+    qint32 int32(int offset)
+    {
+        return qint32(uint32(offset));
+    }
+
+    float real32(int offset)
+    {
+        float value = 0;
+        if (check(offset, sizeof(value))) {
+            memcpy(&value, mData + offset, sizeof(value));
+        }
+        return value;
+    }
+
+    const uchar *data(int offset, int size)
+    {
+        return check(offset, size) ? mData + offset : 0;
+    }
+
+private:
+    const uchar *mData;
+    int mLength;
+    bool mOk;
+};
+
+static QColor colorFromRgba(quint32 rgba, int alpha)
+{
+    return QColor((rgba >> 24) & 0xff, (rgba >> 16) & 0xff, (rgba >> 8) & 0xff, alpha);
+}
+
+// Reads the paint to user matrix, given as sx shx tx shy sy ty.
+static QTransform gradientTransform(HbNvgReader &reader, int offset)
+{
+    return QTransform(reader.real32(offset), reader.real32(offset + 12),
+                      reader.real32(offset + 4), reader.real32(offset + 16),
+                      reader.real32(offset + 8), reader.real32(offset + 20));
+}
+
+static qreal vectorAngle(qreal ux, qreal uy, qreal vx, qreal vy)
+{
+    return qAtan2(ux * vy - uy * vx, ux * vx + uy * vy);
+}
+
+/*
+  Appends an elliptical arc given with the end point parameterization of
+  OpenVG and SVG as cubic curves.
+ */
+static void arcTo(QPainterPath &path, const QPointF &from, qreal rx, qreal ry,
+                  qreal angle, bool largeArc, bool sweep, const QPointF &to)
+{
+    if (from == to) {
+        return;
+    }
+    rx = qAbs(rx);
+    ry = qAbs(ry);
+    if (qFuzzyIsNull(rx) || qFuzzyIsNull(ry)) {
+        path.lineTo(to);
+        return;
+    }
+
+    qreal phi = angle * M_PI / 180.0;
+    qreal cosPhi = qCos(phi);
+    qreal sinPhi = qSin(phi);
+    qreal dx2 = (from.x() - to.x()) / 2.0;
+    qreal dy2 = (from.y() - to.y()) / 2.0;
+    qreal x1 = cosPhi * dx2 + sinPhi * dy2;
+    qreal y1 = -sinPhi * dx2 + cosPhi * dy2;
+
+    // Scale the radii up when the end points do not fit.
+    qreal lambda = (x1 * x1) / (rx * rx) + (y1 * y1) / (ry * ry);
+    if (lambda > 1.0) {
+        rx *= qSqrt(lambda);
+        ry *= qSqrt(lambda);
+    }
+
+    qreal num = rx * rx * ry * ry - rx * rx * y1 * y1 - ry * ry * x1 * x1;
+    qreal den = rx * rx * y1 * y1 + ry * ry * x1 * x1;
+    qreal coef = den > 0 ? qSqrt(qMax(qreal(0), num / den)) : 0;
+    if (largeArc == sweep) {
+        coef = -coef;
+    }
+    qreal cx1 = coef * rx * y1 / ry;
+    qreal cy1 = -coef * ry * x1 / rx;
+    qreal cx = cosPhi * cx1 - sinPhi * cy1 + (from.x() + to.x()) / 2.0;
+    qreal cy = sinPhi * cx1 + cosPhi * cy1 + (from.y() + to.y()) / 2.0;
+
+    qreal theta = vectorAngle(1, 0, (x1 - cx1) / rx, (y1 - cy1) / ry);
+    qreal delta = vectorAngle((x1 - cx1) / rx, (y1 - cy1) / ry,
+                              (-x1 - cx1) / rx, (-y1 - cy1) / ry);
+    if (!sweep && delta > 0) {
+        delta -= 2 * M_PI;
+    } else if (sweep && delta < 0) {
+        delta += 2 * M_PI;
+    }
+
+    int segments = qMax(1, qCeil(qAbs(delta) / (M_PI / 2) - 0.001));
+    qreal step = delta / segments;
+    qreal t = 4.0 / 3.0 * qTan(step / 4);
+    for (int i = 0; i < segments; ++i) {
+        qreal cos1 = qCos(theta);
+        qreal sin1 = qSin(theta);
+        theta += step;
+        qreal cos2 = qCos(theta);
+        qreal sin2 = qSin(theta);
+
+        qreal ux[3] = { cos1 - t * sin1, cos2 + t * sin2, cos2 };
+        qreal uy[3] = { sin1 + t * cos1, sin2 - t * cos2, sin2 };
+        QPointF p[3];
+        for (int j = 0; j < 3; ++j) {
+            p[j] = QPointF(cx + rx * cosPhi * ux[j] - ry * sinPhi * uy[j],
+                           cy + rx * sinPhi * ux[j] + ry * cosPhi * uy[j]);
+        }
+        path.cubicTo(p[0], p[1], i == segments - 1 ? to : p[2]);
+    }
+}
+
+QBrush HbNvgSoftwareRenderer::Paint::brush() const
+{
+    if (type == Flat) {
+        return QBrush(color);
+    }
+    QBrush brush(type == LinearGradient
+                 ? static_cast<const QGradient &>(linear)
+                 : static_cast<const QGradient &>(radial));
+    brush.setTransform(gradientTransform);
+    return brush;
+}
+
+/*!
+    \class HbNvgSoftwareRenderer
+    \brief Renders NVG-CS icons with QPainter.
+
+    Used by HbNvgRasterizer when there is no OpenVG context. The command
+    stream is decoded the same way as HbNvgCsIcon does it, but the paths,
+    paints and transformations are mapped to QPainterPath, QBrush and
+    QTransform.
+*/
+
+HbNvgSoftwareRenderer::HbNvgSoftwareRenderer()
+{
+    resetState();
+}
+
+/*!
+    Renders \a nvgData to \a destination, which is cleared first. The icon
+    is fitted to \a size.
+*/
+bool HbNvgSoftwareRenderer::rasterize(const QByteArray &nvgData, const QSize &size,
+                                      Qt::AspectRatioMode aspectRatioMode, QImage &destination)
+{
+    if (destination.isNull()) {
+        destination = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    }
+    destination.fill(0);
+
+    QPainter painter(&destination);
+    painter.setRenderHint(QPainter::Antialiasing);
+    return render(nvgData, size, aspectRatioMode, &painter);
+}
+
+/*!
+    Renders \a nvgData with \a painter, fitted to a rectangle of \a size at
+    the origin of the current painter transformation.
+*/
+bool HbNvgSoftwareRenderer::render(const QByteArray &nvgData, const QSize &size,
+                                   Qt::AspectRatioMode aspectRatioMode, QPainter *painter)
+{
+    if (size.isEmpty()) {
+        return false;
+    }
+
+    HbNvgReader reader(nvgData);
+    const uchar *signature = reader.data(0, 3);
+    if (!signature || memcmp(signature, nvg_signature, 3) != 0) {
+        return false;
+    }
+
+    resetState();
+    int version = reader.uint8(nvg_version_ofs);
+    int headerSize = qint16(reader.uint16(nvg_headersize_ofs));
+    int pathDataType = qint16(reader.uint16(nvg_pathdatatype_ofs));
+    if (pathDataType != path_sixteen_bit_encoding
+        && pathDataType != path_thirty_two_bit_encoding) {
+        return false;
+    }
+
+    painter->save();
+    mBaseTransform = viewBoxTransform(reader, size, aspectRatioMode) * painter->transform();
+    mTransform = mBaseTransform;
+
+    int offsetVectorCount = reader.uint16(headerSize);
+    int offsetVector = headerSize + sizeof(quint16);
+    int pos = offsetVector + offsetVectorCount * sizeof(quint16);
+    // From version 2 onwards the command section starts on a word boundary,
+    // and the command count is followed by padding.
+    if (version >= nvg_version2 && (offsetVectorCount & 0x01) == 0) {
+        pos += 2;
+    }
+    int commandCount = reader.uint16(pos);
+    pos += 2;
+    if (version >= nvg_version2) {
+        pos += 2;
+    }
+
+    for (int i = 0; i < commandCount && reader.ok(); ++i) {
+        quint32 command = reader.uint32(pos);
+        int section = reader.uint16(offsetVector + (command & 0x0000ffff) * sizeof(quint16));
+
+        switch (command & 0xff000000) {
+        case cmd_set_fill_paint:
+            mFill.alpha = (command & 0x00ff0000) >> 16;
+            setPaint(reader, section, mFill, false);
+            break;
+        case cmd_set_color_ramp:
+            setColorRamp(reader, section + 4, (reader.uint32(section) >> 16) & 0xff, mFill);
+            break;
+        case cmd_draw_path:
+            drawPath(reader, section, pathDataType,
+                     command & 0x00020000, command & 0x00010000, painter);
+            break;
+        case cmd_set_transformation:
+            pos += setTransform(reader, pos) * sizeof(quint32);
+            break;
+        case cmd_set_stroke_paint:
+            mStroke.alpha = (command & 0x00ff0000) >> 16;
+            setPaint(reader, section, mStroke, true);
+            break;
+        case cmd_set_stroke_width:
+            pos += sizeof(quint32);
+            mStrokeWidth = reader.real32(pos);
+            break;
+        case cmd_set_stroke_miter_limit:
+            pos += sizeof(quint32);
+            mMiterLimit = reader.real32(pos);
+            break;
+        case cmd_set_stroke_line_join_cap: {
+            int join = (command & 0x0000ff00) >> 8;
+            int cap = command & 0x000000ff;
+            mCapStyle = cap == cap_square ? Qt::SquareCap
+                        : cap == cap_round ? Qt::RoundCap : Qt::FlatCap;
+            mJoinStyle = join == line_join_bevel ? Qt::BevelJoin
+                         : join == line_join_round ? Qt::RoundJoin : Qt::MiterJoin;
+            break;
+        }
+        default:
+            painter->restore();
+            return false;
+        }
+
+        // go to the next command
+        pos += sizeof(quint32);
+    }
+
+    painter->restore();
+    return reader.ok();
+}
+
+void HbNvgSoftwareRenderer::resetState()
+{
+    // The OpenVG defaults
+    mFill.type = Paint::Flat;
+    mFill.color = Qt::black;
+    mFill.alpha = 0xff;
+    mStroke = mFill;
+    mStrokeWidth = 1.0;
+    mMiterLimit = 4.0;
+    mCapStyle = Qt::FlatCap;
+    mJoinStyle = Qt::MiterJoin;
+}
+
+/*
+  Maps the view box of the icon to \a size like HbNvgFitToViewBoxImpl does
+  with the alignment used by HbNvgRasterizer, which is centered.
+ */
+QTransform HbNvgSoftwareRenderer::viewBoxTransform(HbNvgReader &reader, const QSize &size,
+                                                   Qt::AspectRatioMode aspectRatioMode) const
+{
+    qreal viewBoxX = reader.real32(nvg_viewbox_x_ofs);
+    qreal viewBoxY = reader.real32(nvg_viewbox_y_ofs);
+    qreal viewBoxW = reader.real32(nvg_viewbox_width_ofs);
+    qreal viewBoxH = reader.real32(nvg_viewbox_height_ofs);
+    if (viewBoxW <= 0 || viewBoxH <= 0) {
+        return QTransform();
+    }
+
+    qreal sx = size.width() / viewBoxW;
+    qreal sy = size.height() / viewBoxH;
+    if (aspectRatioMode == Qt::KeepAspectRatio) {
+        sx = sy = qMin(sx, sy);
+    } else if (aspectRatioMode == Qt::KeepAspectRatioByExpanding) {
+        sx = sy = qMax(sx, sy);
+    }
+    qreal tx = (size.width() - viewBoxW * sx) / 2 - viewBoxX * sx;
+    qreal ty = (size.height() - viewBoxH * sy) / 2 - viewBoxY * sy;
+    return QTransform(sx, 0, 0, sy, tx, ty);
+}
+
+void HbNvgSoftwareRenderer::setPaint(HbNvgReader &reader, int offset, Paint &paint, bool stroke)
+{
+    quint32 commonData = reader.uint32(offset);
+    int paintType = commonData & 0x07;
+    int specificData = (commonData >> 16) & 0xff;
+
+    if (paintType == paint_lgrad) {
+        paint.type = Paint::LinearGradient;
+        paint.linear = QLinearGradient(reader.real32(offset + 4), reader.real32(offset + 8),
+                                       reader.real32(offset + 12), reader.real32(offset + 16));
+        paint.gradientTransform = specificData & 0x1
+                                  ? gradientTransform(reader, offset + 20) : QTransform();
+    } else if (paintType == paint_rgrad) {
+        paint.type = Paint::RadialGradient;
+        paint.radial = QRadialGradient(QPointF(reader.real32(offset + 4), reader.real32(offset + 8)),
+                                       reader.real32(offset + 20),
+                                       QPointF(reader.real32(offset + 12), reader.real32(offset + 16)));
+        paint.gradientTransform = specificData & 0x1
+                                  ? gradientTransform(reader, offset + 24) : QTransform();
+    } else if (stroke && paintType == stroke_color_ramp) {
+        setColorRamp(reader, offset + 4, specificData, paint);
+    } else if (paintType == paint_flat || stroke) {
+        paint.type = Paint::Flat;
+        paint.color = colorFromRgba(reader.uint32(offset + 4), paint.alpha);
+    }
+}
+
+void HbNvgSoftwareRenderer::setColorRamp(HbNvgReader &reader, int offset, int stopCount, Paint &paint)
+{
+    QGradientStops stops;
+    qreal alpha = paint.alpha / 255.0;
+    for (int i = 0; i < stopCount; ++i) {
+        int stop = offset + i * 5 * sizeof(float);
+        QColor color;
+        color.setRgbF(qBound(qreal(0), qreal(reader.real32(stop + 4)), qreal(1)),
+                      qBound(qreal(0), qreal(reader.real32(stop + 8)), qreal(1)),
+                      qBound(qreal(0), qreal(reader.real32(stop + 12)), qreal(1)),
+                      qBound(qreal(0), reader.real32(stop + 16) * alpha, qreal(1)));
+        stops.append(QGradientStop(qBound(qreal(0), qreal(reader.real32(stop)), qreal(1)), color));
+    }
+    // The spread mode is always pad, which is the default of QGradient.
+    paint.linear.setStops(stops);
+    paint.radial.setStops(stops);
+}
+
+/*
+  Returns the number of words following the command.
+ */
+int HbNvgSoftwareRenderer::setTransform(HbNvgReader &reader, int pos)
+{
+    quint32 commonData = reader.uint32(pos);
+    int transformType = (commonData & 0x00ff0000) >> 16;
+    int counter = 0;
+
+    if (transformType == transform_identity) {
+        mTransform = mBaseTransform;
+        return counter;
+    }
+
+    qreal sx = 1;
+    qreal sy = 1;
+    qreal shx = 0;
+    qreal shy = 0;
+    qreal tx = 0;
+    qreal ty = 0;
+    if (transformType == transform_complete) {
+        sx = reader.real32(pos + (++counter) * sizeof(float));
+        sy = reader.real32(pos + (++counter) * sizeof(float));
+        shx = reader.real32(pos + (++counter) * sizeof(float));
+        shy = reader.real32(pos + (++counter) * sizeof(float));
+        tx = reader.real32(pos + (++counter) * sizeof(float));
+        ty = reader.real32(pos + (++counter) * sizeof(float));
+    } else {
+        if (transformType & (transform_rotation | transform_scaling)) {
+            sx = reader.real32(pos + (++counter) * sizeof(float));
+            sy = reader.real32(pos + (++counter) * sizeof(float));
+        }
+        if (transformType & (transform_rotation | transform_shearing)) {
+            shx = reader.real32(pos + (++counter) * sizeof(float));
+            shy = reader.real32(pos + (++counter) * sizeof(float));
+        }
+        if (transformType & transform_translation) {
+            tx = reader.real32(pos + (++counter) * sizeof(float));
+            ty = reader.real32(pos + (++counter) * sizeof(float));
+        }
+    }
+
+    mTransform = QTransform(sx, shy, shx, sy, tx, ty) * mBaseTransform;
+    return counter;
+}
+
+void HbNvgSoftwareRenderer::drawPath(HbNvgReader &reader, int offset, int pathDataType,
+                                     bool fill, bool stroke, QPainter *painter)
+{
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill);
+    if (!readPath(reader, offset, pathDataType, path)) {
+        return;
+    }
+    if (!fill && !stroke) {
+        fill = true;
+    }
+
+    painter->setTransform(mTransform);
+    painter->setBrush(fill ? mFill.brush() : QBrush(Qt::NoBrush));
+    if (stroke && mStrokeWidth > 0) {
+        QPen pen(mStroke.brush(), mStrokeWidth, Qt::SolidLine, mCapStyle, mJoinStyle);
+        pen.setMiterLimit(mMiterLimit);
+        painter->setPen(pen);
+    } else {
+        painter->setPen(Qt::NoPen);
+    }
+    painter->drawPath(path);
+}
+
+bool HbNvgSoftwareRenderer::readPath(HbNvgReader &reader, int offset, int pathDataType,
+                                     QPainterPath &path)
+{
+    int segmentCount = reader.uint16(offset);
+    const uchar *segments = reader.data(offset + sizeof(quint16), segmentCount);
+    if (!segments) {
+        return false;
+    }
+
+    // The coordinates are aligned according to their size.
+    int dataPos = offset + sizeof(quint16) + segmentCount;
+    int coordinateSize;
+    qreal scale;
+    if (pathDataType == path_sixteen_bit_encoding) {
+        dataPos = (dataPos + 1) & ~1;
+        coordinateSize = sizeof(qint16);
+        scale = 1.0 / 16.0;
+    } else {
+        dataPos = (dataPos + 3) & ~3;
+        coordinateSize = sizeof(qint32);
+        scale = 1.0 / 65536.0;
+    }
+
+    QPointF start;
+    QPointF current;
+    QPointF lastControl;
+    int previous = SegmentClose;
+
+    for (int i = 0; i < segmentCount && reader.ok(); ++i) {
+        int segment = segments[i] & ~1;
+        bool relative = segments[i] & 1;
+
+        int count = 0;
+        switch (segment) {
+        case SegmentHLineTo:
+        case SegmentVLineTo:
+            count = 1;
+            break;
+        case SegmentMoveTo:
+        case SegmentLineTo:
+        case SegmentSQuadTo:
+            count = 2;
+            break;
+        case SegmentQuadTo:
+        case SegmentSCubicTo:
+            count = 4;
+            break;
+        case SegmentSCCWArcTo:
+        case SegmentSCWArcTo:
+        case SegmentLCCWArcTo:
+        case SegmentLCWArcTo:
+            count = 5;
+            break;
+        case SegmentCubicTo:
+            count = 6;
+            break;
+        default:
+            break;
+        }
+
+        qreal c[6];
+        for (int j = 0; j < count; ++j) {
+            c[j] = (coordinateSize == sizeof(qint16)
+                    ? qint16(reader.uint16(dataPos)) : reader.int32(dataPos)) * scale;
+            dataPos += coordinateSize;
+        }
+        QPointF origin = relative ? current : QPointF();
+
+        switch (segment) {
+        case SegmentClose:
+            path.closeSubpath();
+            current = start;
+            break;
+        case SegmentMoveTo:
+            current = start = origin + QPointF(c[0], c[1]);
+            path.moveTo(current);
+            break;
+        case SegmentLineTo:
+            current = origin + QPointF(c[0], c[1]);
+            path.lineTo(current);
+            break;
+        case SegmentHLineTo:
+            current.setX(origin.x() + c[0]);
+            path.lineTo(current);
+            break;
+        case SegmentVLineTo:
+            current.setY(origin.y() + c[0]);
+            path.lineTo(current);
+            break;
+        case SegmentQuadTo:
+        case SegmentSQuadTo: {
+            QPointF control;
+            QPointF end;
+            if (segment == SegmentQuadTo) {
+                control = origin + QPointF(c[0], c[1]);
+                end = origin + QPointF(c[2], c[3]);
+            } else {
+                control = previous == SegmentQuadTo || previous == SegmentSQuadTo
+                          ? 2 * current - lastControl : current;
+                end = origin + QPointF(c[0], c[1]);
+            }
+            path.quadTo(control, end);
+            lastControl = control;
+            current = end;
+            break;
+        }
+        case SegmentCubicTo:
+        case SegmentSCubicTo: {
+            QPointF control1;
+            QPointF control2;
+            QPointF end;
+            if (segment == SegmentCubicTo) {
+                control1 = origin + QPointF(c[0], c[1]);
+                control2 = origin + QPointF(c[2], c[3]);
+                end = origin + QPointF(c[4], c[5]);
+            } else {
+                control1 = previous == SegmentCubicTo || previous == SegmentSCubicTo
+                           ? 2 * current - lastControl : current;
+                control2 = origin + QPointF(c[0], c[1]);
+                end = origin + QPointF(c[2], c[3]);
+            }
+            path.cubicTo(control1, control2, end);
+            lastControl = control2;
+            current = end;
+            break;
+        }
+        case SegmentSCCWArcTo:
+        case SegmentSCWArcTo:
+        case SegmentLCCWArcTo:
+        case SegmentLCWArcTo: {
+            QPointF end = origin + QPointF(c[3], c[4]);
+            bool largeArc = segment == SegmentLCCWArcTo || segment == SegmentLCWArcTo;
+            bool counterClockwise = segment == SegmentSCCWArcTo || segment == SegmentLCCWArcTo;
+            arcTo(path, current, c[0], c[1], c[2], largeArc, counterClockwise, end);
+            current = end;
+            break;
+        }
+        default:
+            return false;
+        }
+        previous = segment;
+    }
+    return reader.ok();
+}
@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the HbCore module of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#ifndef HBNVGSOFTWARERENDERER_P_H
+#define HBNVGSOFTWARERENDERER_P_H
+
+#include <QImage>
+#include <QTransform>
+#include <QLinearGradient>
+#include <QRadialGradient>
+#include <QColor>
+#include <QPen>
+#include <hbglobal.h>
+
+class QPainter;
+class QPainterPath;
+class HbNvgReader;
+
+class HB_CORE_PRIVATE_EXPORT HbNvgSoftwareRenderer
+{
+public:
+    HbNvgSoftwareRenderer();
+
+    bool render(const QByteArray &nvgData, const QSize &size,
+                Qt::AspectRatioMode aspectRatioMode, QPainter *painter);
+
+    bool rasterize(const QByteArray &nvgData, const QSize &size,
+                   Qt::AspectRatioMode aspectRatioMode, QImage &destination);
+
+private:
+    struct Paint {
+        enum Type {
+            Flat,
+            LinearGradient,
+            RadialGradient
+        };
+        Type type;
+        QColor color;
+        QLinearGradient linear;
+        QRadialGradient radial;
+        QTransform gradientTransform;
+        int alpha;
+
+        QBrush brush() const;
+    };
+
+    void resetState();
+    QTransform viewBoxTransform(HbNvgReader &reader, const QSize &size,
+                                Qt::AspectRatioMode aspectRatioMode) const;
+    void setPaint(HbNvgReader &reader, int offset, Paint &paint, bool stroke);
+    void setColorRamp(HbNvgReader &reader, int offset, int stopCount, Paint &paint);
+    int setTransform(HbNvgReader &reader, int pos);
+    void drawPath(HbNvgReader &reader, int offset, int pathDataType,
+                  bool fill, bool stroke, QPainter *painter);
+    bool readPath(HbNvgReader &reader, int offset, int pathDataType, QPainterPath &path);
+
+    QTransform mBaseTransform;
+    QTransform mTransform;
+    Paint mFill;
+    Paint mStroke;
+    qreal mStrokeWidth;
+    qreal mMiterLimit;
+    Qt::PenCapStyle mCapStyle;
+    Qt::PenJoinStyle mJoinStyle;
+};
+
+#endif // HBNVGSOFTWARERENDERER_P_H
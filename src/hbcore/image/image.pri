@@ -55,6 +55,8 @@ PRIVATE_HEADERS += $$PWD/hbframedrawerpool_p.h
 PRIVATE_HEADERS += $$PWD/hbmaskableiconimpl_p.h
 PRIVATE_HEADERS += $$PWD/hbiconimplcreator_p.h
 PRIVATE_HEADERS += $$PWD/hbpixmapiconrenderer_p.h
+PRIVATE_HEADERS += $$PWD/hbnvgrasterizer_p.h
+PRIVATE_HEADERS += $$PWD/hbnvgsoftwarerenderer_p.h
 
 SOURCES += $$PWD/hbframedrawer.cpp
 SOURCES += $$PWD/hbframebackground.cpp
@@ -75,18 +77,18 @@ SOURCES += $$PWD/hbiconsource.cpp
 SOURCES += $$PWD/hbframedrawerpool.cpp
 SOURCES += $$PWD/hbiconimplcreator_p.cpp
 SOURCES += $$PWD/hbpixmapiconrenderer.cpp
+SOURCES += $$PWD/hbnvgrasterizer_p.cpp
+SOURCES += $$PWD/hbnvgsoftwarerenderer_p.cpp
 
 symbian {
     nvg {
         PRIVATE_HEADERS += $$PWD/hbnvgiconimpl_p.h
         PRIVATE_HEADERS += $$PWD/hbeglstate_p.h
         PRIVATE_HEADERS += $$PWD/hbvgimageiconrenderer_p.h
-        PRIVATE_HEADERS += $$PWD/hbnvgrasterizer_p.h
 
         SOURCES += $$PWD/hbnvgiconimpl_p.cpp
         SOURCES += $$PWD/hbeglstate.cpp
         SOURCES += $$PWD/hbvgimageiconrenderer.cpp
-        SOURCES += $$PWD/hbnvgrasterizer_p.cpp
     }
     sgimage {
         SOURCES += $$PWD/hbsgimageiconimpl_p.cpp
@@ -34,6 +34,9 @@
 #include <QSharedMemory>
 #include <QDataStream>
 #include <QBuffer>
+#include <QFileInfo>
+#include <QHash>
+#include <QPair>
 
 #include "hbinpututils.h"
 #include "hbinputmethod.h"
@@ -119,15 +122,18 @@ void HbInputModeCachePrivate::readInputMethodDataFromDisk(QList<HbInputMethodLis
     // First go through all the previously found entries and
     // tag them not refreshed. In case a directory is defined, only marks entries
     // in that directory
+    QHash<QString, QList<int> > pluginEntries;
     for (int i = 0; i < methodList->size(); ++i) {
+        const QString &pluginNameAndPath = methodList->at(i).descriptor.pluginNameAndPath();
         if (readFromSinglePath) {
-            if (methodList->at(i).descriptor.pluginNameAndPath().left(methodList->at(i).descriptor.pluginNameAndPath().lastIndexOf(QDir::separator()))
+            if (pluginNameAndPath.left(pluginNameAndPath.lastIndexOf(QDir::separator()))
                 == readPath.absolutePath()) {
                 (*methodList)[i].toBeRemoved = true;
             }
         } else {
             (*methodList)[i].toBeRemoved = true;
         }
+        pluginEntries[pluginNameAndPath].append(i);
     }
 
     // Query plugin paths and scan the folders.
@@ -141,24 +147,59 @@ void HbInputModeCachePrivate::readInputMethodDataFromDisk(QList<HbInputMethodLis
                     path += QDir::separator();
                 }
                 path += dir[i];
+                const QString pluginNameAndPath = dir.absolutePath() + QDir::separator() + dir[i];
+                const QDateTime modified = QFileInfo(path).lastModified();
+
+                // Plugins that haven't changed since they were read are not loaded again.
+                const QList<int> entries = pluginEntries.value(pluginNameAndPath);
+                bool unchanged = !entries.isEmpty();
+                foreach(int index, entries) {
+                    if (methodList->at(index).pluginModified != modified) {
+                        unchanged = false;
+                    }
+                }
+                if (unchanged) {
+                    foreach(int index, entries) {
+                        (*methodList)[index].toBeRemoved = false;
+                    }
+                    continue;
+                }
+
                 QInputContextPlugin *inputContextPlugin = pluginInstance(path);
                 if (inputContextPlugin) {
                     HbInputMethodListItem listItem;
-                    listItem.descriptor.setPluginNameAndPath(dir.absolutePath() + QDir::separator() + dir[i]);
+                    listItem.descriptor.setPluginNameAndPath(pluginNameAndPath);
+                    listItem.pluginModified = modified;
 
                     // For each found plugin, check if there is already a list item for it.
                     // If not, then add one.
                     QStringList contextKeys = inputContextPlugin->keys();
                     foreach(const QString &key, contextKeys) {
                         listItem.setValues(inputContextPlugin, key);
-
-                        int index = methodList->indexOf(listItem);
+                        listItem.languages = inputContextPlugin->languages(key);
+
+                        int index = -1;
+                        foreach(int entry, entries) {
+                            if (methodList->at(entry).descriptor.key() == key) {
+                                index = entry;
+                                break;
+                            }
+                        }
                         if (index >= 0) {
-                            // The method is already in the list, the situation hasn't changed.
-                            // just tag it not to be removed.
-                            (*methodList)[index].toBeRemoved = false;
+                            // The method is already in the list, tag it not to be removed
+                            // and take the values the plugin gives now.
+                            HbInputMethodListItem &item = (*methodList)[index];
+                            item.toBeRemoved = false;
+                            if (item.pluginModified != modified) {
+                                if (item.languages != listItem.languages
+                                    || item.descriptor.displayName() != listItem.descriptor.displayName()) {
+                                    item.descriptor = listItem.descriptor;
+                                    item.languages = listItem.languages;
+                                    ++item.version;
+                                }
+                                item.pluginModified = modified;
+                            }
                         } else {
-                            listItem.languages = inputContextPlugin->languages(key);
                             methodList->append(listItem);
                         }
                     }
@@ -192,36 +233,94 @@ bool HbInputModeCachePrivate::readInputMethodDataFromSharedMemory()
     mMethodListLastUpdate = *newModTime;
 
     // To start updating the list, first mark all methods for removal
+    QHash<QPair<QString, QString>, int> indexes;
     for (int k = 0; k < mMethods.count(); k++) {
         mMethods[k].toBeRemoved = true;
+        indexes.insert(qMakePair(mMethods.at(k).descriptor.pluginNameAndPath(), mMethods.at(k).descriptor.key()), k);
     }
 
-    // Get a copy of the list from shared memory
+    // Read the entries straight from shared memory. The methods that are in the
+    // internal list with the same version are skipped without deserializing them,
+    // new ones are appended and the rest will be removed by pruneRemovedMethods.
     mSharedMethodList->lock();
-    QByteArray array(static_cast<const char *>(mSharedMethodList->data())+sizeof(int), *static_cast<int *>(mSharedMethodList->data()));
-    // array now has a copy of the data, so we can unlock and detach
-    mSharedMethodList->unlock();
-    mSharedMethodList->detach();
-
-    // Next read the entries from the array to a temporary list
+    const char *data = static_cast<const char *>(mSharedMethodList->data());
+    QByteArray array = QByteArray::fromRawData(data+sizeof(int), *reinterpret_cast<const int *>(data));
     QDataStream in(&array, QIODevice::ReadOnly);
-    QList<HbInputMethodListItem> newMethodList;
-    in >> newMethodList;
-
-    // Go through the temporary list and append new methods to internal list
-    // Duplicates are marked as not to be removed, the rest will be removed by pruneRemovedMethods
-    foreach (const HbInputMethodListItem& item, newMethodList) {
-        int index = mMethods.indexOf(item);
-        if (index >= 0) {
+    quint32 format = 0;
+    quint32 count = 0;
+    in >> format;
+    if (format != HbInputMethodListFormat) {
+        // Written by a server that uses another layout, revert to in-process handling
+        mSharedMethodList->unlock();
+        mSharedMethodList->detach();
+        for (int k = 0; k < mMethods.count(); k++) {
+            mMethods[k].toBeRemoved = false;
+        }
+        qWarning("HbInputModeCache: unsupported shared input method list format %u", format);
+        return false;
+    }
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString pluginNameAndPath;
+        QString key;
+        quint32 version;
+        quint32 length;
+        in >> pluginNameAndPath >> key >> version >> length;
+
+        int index = indexes.value(qMakePair(pluginNameAndPath, key), -1);
+        if (index >= 0 && mMethods.at(index).version == version) {
             mMethods[index].toBeRemoved = false;
+            in.skipRawData(length);
         } else {
-            mMethods.append(item);
+            HbInputMethodListItem item;
+            in >> item;
+            item.version = version;
+            if (index >= 0) {
+                // Keep the method instance, if it has been created already
+                HbInputMethodListItem &existing = mMethods[index];
+                existing.descriptor = item.descriptor;
+                existing.languages = item.languages;
+                existing.version = version;
+                existing.toBeRemoved = false;
+            } else {
+                mMethods.append(item);
+            }
         }
     }
+    bool ok = (in.status() == QDataStream::Ok);
+    mSharedMethodList->unlock();
+    mSharedMethodList->detach();
+
+    if (!ok) {
+        // The list was read while it was being written, read it again on the next refresh
+        for (int k = 0; k < mMethods.count(); k++) {
+            mMethods[k].toBeRemoved = false;
+        }
+        mMethodListLastUpdate = 0;
+        return true;
+    }
     pruneRemovedMethods();
     return true;
 }
 
+/*
+Writes the method list to the format readInputMethodDataFromSharedMemory expects.
+The list starts with the format version and the number of methods. Each method
+is preceded by its plugin, key, version and length, so that the readers can skip
+the methods they already have.
+*/
+void HbInputModeCachePrivate::writeSharedMethodList(QDataStream &out, const QList<HbInputMethodListItem> &methodList)
+{
+    out << quint32(HbInputMethodListFormat) << quint32(methodList.count());
+    foreach (const HbInputMethodListItem &item, methodList) {
+        QByteArray itemData;
+        QDataStream itemOut(&itemData, QIODevice::WriteOnly);
+        itemOut << item;
+        out << item.descriptor.pluginNameAndPath() << item.descriptor.key() << quint32(item.version);
+        out.writeBytes(itemData.constData(), itemData.size());
+    }
+}
+
 void HbInputModeCachePrivate::pruneRemovedMethods()
 {
     // Go through the cache list and find out if some of the previous items need to be
@@ -25,6 +25,7 @@
 
 #include <QString>
 #include <QDir>
+#include <QDateTime>
 
 #include <hbinputmethoddescriptor.h>
 #include <hbinputmethod.h>
@@ -34,11 +35,14 @@ class QSharedMemory;
 
 const char HbInputMethodListKey[] = "HbInputMethodList";
 const char HbInputMethodListModTimeKey[] = "HbInputMethodListModTime";
+// Layout of the shared method list, see HbInputModeCachePrivate::writeSharedMethodList.
+// Increment when the layout changes.
+const quint32 HbInputMethodListFormat = 2;
 
 class HB_CORE_PRIVATE_EXPORT HbInputMethodListItem
 {
 public:
-    HbInputMethodListItem() : cached(0), toBeRemoved(false) {}
+    HbInputMethodListItem() : cached(0), toBeRemoved(false), version(0) {}
     bool operator==(const HbInputMethodListItem &item) const {
         return (descriptor.pluginNameAndPath() == item.descriptor.pluginNameAndPath() &&
                 descriptor.key() == item.descriptor.key());
@@ -51,6 +55,11 @@ public:
     QStringList languages;
     HbInputMethod *cached;
     bool toBeRemoved;
+    // Incremented when the plugin reports different values for an existing method,
+    // lets the clients of the shared list skip the methods they already have.
+    uint version;
+    // Modification time of the plugin file when it was last read
+    QDateTime pluginModified;
 };
 
 HB_CORE_PRIVATE_EXPORT QDataStream &operator<<(QDataStream &stream, const HbInputMethodListItem &item);
@@ -63,6 +72,7 @@ public:
     ~HbInputModeCachePrivate();
     void refresh();
     static void readInputMethodDataFromDisk(QList<HbInputMethodListItem> *methodList, const QDir &readPath = QDir());
+    static void writeSharedMethodList(QDataStream &out, const QList<HbInputMethodListItem> &methodList);
     bool readInputMethodDataFromSharedMemory();
     void pruneRemovedMethods();
     static QInputContextPlugin *pluginInstance(const QString &pluginFileName);
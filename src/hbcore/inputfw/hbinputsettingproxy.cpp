@@ -244,7 +244,10 @@ bool HbInputSettingProxyPrivate::load(HbSettingProxyInternalData *data)
         HbSettingProxyInternalData *ldData = (HbSettingProxyInternalData *)rawData.constData();
         if (ldData) {
             if (ldData->version == HbProxyDataRequiredVersion) {
+                // The sequence belongs to the shared memory, not to the stored settings.
+                int sequence = data->sequence;
                 memcpy((void *)data, (void *)ldData, sizeof(HbSettingProxyInternalData));
+                data->sequence = sequence;
                 return true;
             }
         }
@@ -294,6 +297,77 @@ HbSettingProxyInternalData *HbInputSettingProxyPrivate::proxyData() const
     return static_cast<HbSettingProxyInternalData *>(mSharedMemory->data());
 }
 
+/*
+Marks the data as being modified. Must be called with the shared memory locked.
+If a writer died in the middle of an update, the sequence is already odd and stays so.
+*/
+void HbInputSettingProxyPrivate::beginWrite(HbSettingProxyInternalData *data)
+{
+    if (data) {
+        int sequence = data->sequence;
+        data->sequence.fetchAndStoreOrdered(sequence | 1);
+    }
+}
+
+/*
+Marks the modification done, letting the readers know that the data has changed.
+*/
+void HbInputSettingProxyPrivate::endWrite(HbSettingProxyInternalData *data)
+{
+    if (data) {
+        int sequence = data->sequence;
+        data->sequence.fetchAndStoreOrdered((sequence | 1) + 1);
+    }
+}
+
+/*
+Reads the shared data without taking the shared memory lock. The read is repeated
+until no writer has modified the data in the middle of it:
+
+    HbSettingProxyReader reader(d);
+    do {
+        value = prData->value;
+    } while (reader.retry());
+
+The values read on a pass that is retried may be inconsistent and must not be
+used for anything else than copying. If the data keeps changing, or a writer has
+died in the middle of an update, the last pass is done with the lock held.
+*/
+class HbSettingProxyReader
+{
+public:
+    HbSettingProxyReader(const HbInputSettingProxyPrivate *d)
+        : mPrivate(d), mPasses(1), mLocked(false) {
+        mSequence = mPrivate->proxyData()->sequence.fetchAndAddOrdered(0);
+    }
+
+    bool retry() {
+        if (mLocked) {
+            mPrivate->unlock();
+            return false;
+        }
+        int sequence = mPrivate->proxyData()->sequence.fetchAndAddOrdered(0);
+        if (sequence == mSequence && !(sequence & 1)) {
+            return false;
+        }
+        if (++mPasses > MaxPasses) {
+            mPrivate->lock();
+            mLocked = true;
+        } else {
+            mSequence = sequence;
+        }
+        return true;
+    }
+
+private:
+    enum { MaxPasses = 100 };
+
+    const HbInputSettingProxyPrivate *mPrivate;
+    int mSequence;
+    int mPasses;
+    bool mLocked;
+};
+
 /// @endcond
 
 /*!
@@ -399,12 +473,13 @@ HbInputLanguage HbInputSettingProxy::globalInputLanguage() const
     Q_D(const HbInputSettingProxy);
     HbInputLanguage res;
 
-    d->lock();
     HbSettingProxyInternalData *prData = d->proxyData();
     if (prData) {
-        res = prData->globalPrimaryInputLanguage;
+        HbSettingProxyReader reader(d);
+        do {
+            res = prData->globalPrimaryInputLanguage;
+        } while (reader.retry());
     }
-    d->unlock();
 
     return HbInputLanguage(res);
 }
@@ -420,12 +495,13 @@ HbInputLanguage HbInputSettingProxy::globalSecondaryInputLanguage() const
     Q_D(const HbInputSettingProxy);
     HbInputLanguage res;
 
-    d->lock();
     HbSettingProxyInternalData *prData = d->proxyData();
     if (prData) {
-        res = prData->globalSecondaryInputLanguage;
+        HbSettingProxyReader reader(d);
+        do {
+            res = prData->globalSecondaryInputLanguage;
+        } while (reader.retry());
     }
-    d->unlock();
 
     return HbInputLanguage(res);
 }
@@ -522,12 +598,8 @@ HbKeyboardType HbInputSettingProxy::activeKeyboard(Qt::Orientation orientation)
 
     if (orientation == Qt::Horizontal) {
         HbSettingProxyInternalData *prData = d->proxyData();
-        if (prData) {
-            d->lock();
-            if (prData->flipStatus == true) {
-                return HbKeyboardHardwareLandcape;
-            }
-            d->unlock();
+        if (prData && prData->flipStatus) {
+            return HbKeyboardHardwareLandcape;
         }
         return HbKeyboardTouchLandscape;
     } else {
@@ -549,13 +621,14 @@ HbInputMethodDescriptor HbInputSettingProxy::preferredInputMethod(Qt::Orientatio
 
     HbSettingProxyInternalData *prData = d->proxyData();
     if (prData) {
-        d->lock();
-        if (orientation == Qt::Horizontal) {
-            result = prData->preferredMethodHorizontal.descriptor();
-        } else {
-            result = prData->preferredMethodVertical.descriptor();
-        }
-        d->unlock();
+        HbSettingProxyReader reader(d);
+        do {
+            if (orientation == Qt::Horizontal) {
+                result = prData->preferredMethodHorizontal.descriptor();
+            } else {
+                result = prData->preferredMethodVertical.descriptor();
+            }
+        } while (reader.retry());
     }
 
     return result;
@@ -574,13 +647,14 @@ QByteArray HbInputSettingProxy::preferredInputMethodCustomData(Qt::Orientation o
 
     HbSettingProxyInternalData *prData = d->proxyData();
     if (prData) {
-        d->lock();
-        if (orientation == Qt::Horizontal) {
-            result = prData->preferredMethodHorizontal.data();
-        } else {
-            result = prData->preferredMethodVertical.data();
-        }
-        d->unlock();
+        HbSettingProxyReader reader(d);
+        do {
+            if (orientation == Qt::Horizontal) {
+                result = prData->preferredMethodHorizontal.data();
+            } else {
+                result = prData->preferredMethodVertical.data();
+            }
+        } while (reader.retry());
     }
 
     return result;
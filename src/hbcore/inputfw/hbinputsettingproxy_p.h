@@ -26,13 +26,14 @@
 #define HB_INPUT_SETTING_PROXY_PRIVATE_H
 
 #include <QSharedMemory>
+#include <QAtomicInt>
 #include <QString>
 #include <QVector>
 
 #include "hbinputmethoddescriptor.h"
 #include "hbinputlanguage.h"
 
-const int HbProxyDataRequiredVersion = 25;
+const int HbProxyDataRequiredVersion = 26;
 const char HbInputSettingsSharedMemoryKey[] = "HbInputSettingProxy";
 const unsigned int HbActiveMethodNameMax = 255;
 const unsigned int HbActiveMethodKeyMax = 64;
@@ -64,6 +65,8 @@ public:
 // to this class or change related constants!
 struct HbSettingProxyInternalData {
     int version;
+    // Odd while a writer is modifying the data, incremented again when it is done.
+    QAtomicInt sequence;
     HbInputLanguage globalPrimaryInputLanguage;
     HbInputLanguage globalSecondaryInputLanguage;
     HbKeyboardSettingFlags predictiveInputState;
@@ -98,12 +101,16 @@ public:
     static void save(HbSettingProxyInternalData *data);
     void shutdownDataArea();
     HbSettingProxyInternalData *proxyData() const;
+    static void beginWrite(HbSettingProxyInternalData *data);
+    static void endWrite(HbSettingProxyInternalData *data);
 
     void lock() const {
         mSharedMemory->lock();
+        beginWrite(proxyData());
     }
 
     void unlock() const {
+        endWrite(proxyData());
         mSharedMemory->unlock();
     }
 
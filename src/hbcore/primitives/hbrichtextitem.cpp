@@ -39,19 +39,24 @@
 #include <QApplication>
 #include <QWidget>
 #include <QStyleOptionGraphicsItem>
+#include <QPixmapCache>
 
 const qreal KMinimumRichTextWidth = 6.0;
+const int KSizeCacheSize = 4;
+const int KPaintCacheMaxArea = 256*1024; // in pixels, larger documents are painted directly
 
 static const QString KDefaultColorThemeName = "qtc_view_normal";
 
 HbRichTextItemPrivate::HbRichTextItemPrivate() :
         mTextOption(Qt::AlignLeft|Qt::AlignVCenter),
-        mRtf(0)
+        mRtf(0),
+        mPaintCacheColor(0)
 {
 }
 
 HbRichTextItemPrivate::~HbRichTextItemPrivate()
 {
+    invalidatePaintCache();
 }
 
 /*
@@ -82,6 +87,7 @@ void HbRichTextItemPrivate::setDocumentWidth(qreal newWidth)
 {
     if (!qFuzzyCompare(mRtf->textWidth(), newWidth)) {
         mRtf->setTextWidth(newWidth);
+        invalidatePaintCache();
         calculateOffset();
     }
 }
@@ -137,6 +143,81 @@ void HbRichTextItemPrivate::clearPrefSizeCache()
     mPrefSize.setWidth(-1);
     mMinWidthForAdjust = QWIDGETSIZE_MAX;
     mMaxWidthForAdjust = -1;
+    mSizeCache.clear();
+}
+
+/*
+    Called when the content or the formatting of the document changes.
+ */
+void HbRichTextItemPrivate::invalidateLayoutCache()
+{
+    mSizeCache.clear();
+    invalidatePaintCache();
+}
+
+void HbRichTextItemPrivate::invalidatePaintCache() const
+{
+    QPixmapCache::remove(mPaintCacheKey);
+    mPaintCacheKey = QPixmapCache::Key();
+}
+
+/*
+    Paints the document from a pixmap, which is rendered again only when the
+    document is laid out again, or its color or position inside of the item
+    changes. The pixmap is kept in QPixmapCache, so all rich text items share
+    its limit and the least recently painted ones are rendered again when
+    the cache is full. Returns false if the cache can't be used, for example
+    when the painter scales or rotates the item.
+ */
+bool HbRichTextItemPrivate::paintCached(QPainter *painter, const QRectF &exposedRect)
+{
+    Q_Q(HbRichTextItem);
+
+    if (painter->worldTransform().type() > QTransform::TxTranslate) {
+        return false;
+    }
+
+    const QRect cacheRect = q->boundingRect().toAlignedRect();
+    if (cacheRect.isEmpty()) {
+        return true;
+    }
+    // QPixmapCache doesn't take pixmaps larger than its limit
+    const int area = cacheRect.width()*cacheRect.height();
+    if (area > KPaintCacheMaxArea || area*4 > QPixmapCache::cacheLimit()*1024) {
+        invalidatePaintCache();
+        return false;
+    }
+
+    const QColor color = q->textDefaultColor();
+    QPixmap cache;
+    if (!QPixmapCache::find(mPaintCacheKey, &cache)
+        || mPaintCacheRect != cacheRect
+        || mPaintCacheOffset != mOffset
+        || mPaintCacheColor != color.rgba()) {
+        invalidatePaintCache();
+        cache = QPixmap(cacheRect.size());
+        cache.fill(Qt::transparent);
+
+        QPainter cachePainter(&cache);
+        cachePainter.translate(mOffset - cacheRect.topLeft());
+
+        QAbstractTextDocumentLayout::PaintContext context;
+        context.clip = QRectF(cacheRect).translated(-mOffset);
+        context.palette.setColor(QPalette::Text, color);
+        mRtf->documentLayout()->draw(&cachePainter, context);
+        cachePainter.end();
+
+        mPaintCacheKey = QPixmapCache::insert(cache);
+        mPaintCacheRect = cacheRect;
+        mPaintCacheOffset = mOffset;
+        mPaintCacheColor = color.rgba();
+    }
+
+    const QRect target = exposedRect.toAlignedRect() & cacheRect;
+    if (!target.isEmpty()) {
+        painter->drawPixmap(target.topLeft(), cache, target.translated(-cacheRect.topLeft()));
+    }
+    return true;
 }
 
 QSizeF HbRichTextItemPrivate::preferredSizeHint(const QSizeF &constraint) const
@@ -148,17 +229,42 @@ QSizeF HbRichTextItemPrivate::preferredSizeHint(const QSizeF &constraint) const
 
     QSizeF result;
 
+    // width used for the layout, negative when the current text width is used
+    qreal layoutWidth = -1;
     if (constraint.width()<=0) {
-        mRtf->setTextWidth(QWIDGETSIZE_MAX);
+        layoutWidth = QWIDGETSIZE_MAX;
     } else {
         QTextOption::WrapMode wrapMode = mTextOption.wrapMode();
         // optimization when there is no automatic wrap there is no reason
         // to setTextWidth with width constraint (width measure is not needed)
         if (wrapMode!=QTextOption::NoWrap
             && wrapMode!=QTextOption::ManualWrap) {
-            mRtf->setTextWidth(constraint.width());
+            layoutWidth = constraint.width();
         }
     }
+
+    // Layouts asking the size for a few recurring widths would otherwise
+    // relayout the document every time.
+    if (layoutWidth>0) {
+        for (int i=0; i<mSizeCache.count(); ++i) {
+            const SizeCacheEntry &entry = mSizeCache.at(i);
+            if (qFuzzyCompare(entry.constraintWidth, layoutWidth)) {
+                mMaxWidthForAdjust = entry.maxWidthForAdjust;
+                mMinWidthForAdjust = entry.prefSize.width();
+                mDefaultPrefHeight = entry.prefSize.height();
+                mPrefSize = entry.prefSize;
+                if (i>0) {
+                    mSizeCache.move(i, 0);
+                }
+                return mPrefSize;
+            }
+        }
+        if (!qFuzzyCompare(mRtf->textWidth(), layoutWidth)) {
+            mRtf->setTextWidth(layoutWidth);
+            invalidatePaintCache();
+        }
+    }
+
     result = mRtf->size();
     mMaxWidthForAdjust = result.width();
     result.setWidth(mRtf->idealWidth());
@@ -166,6 +272,17 @@ QSizeF HbRichTextItemPrivate::preferredSizeHint(const QSizeF &constraint) const
     mDefaultPrefHeight = result.height();
     mPrefSize = result;
 
+    if (layoutWidth>0) {
+        SizeCacheEntry entry;
+        entry.constraintWidth = layoutWidth;
+        entry.prefSize = result;
+        entry.maxWidthForAdjust = mMaxWidthForAdjust;
+        mSizeCache.prepend(entry);
+        if (mSizeCache.count()>KSizeCacheSize) {
+            mSizeCache.removeLast();
+        }
+    }
+
     return result;
 }
 
@@ -331,6 +448,7 @@ void HbRichTextItem::setText(const QString &text)
         d->mText = text;
         d->mRtf->setHtml(text);
         d->clearPrefSizeCache();
+        d->invalidatePaintCache();
         update();
         updateGeometry();
     }
@@ -362,6 +480,7 @@ void HbRichTextItem::setAlignment(Qt::Alignment alignment)
         prepareGeometryChange();
         d->mTextOption.setAlignment(alignment);
         d->mRtf->setDefaultTextOption(d->mTextOption);
+        d->invalidateLayoutCache();
         d->calculateOffset();
         update();
     }
@@ -394,6 +513,10 @@ void HbRichTextItem::paint(QPainter *painter,
         return;
     }
 
+    if (d->paintCached(painter, option->exposedRect)) {
+        return;
+    }
+
     painter->translate(d->mOffset);
 
     QAbstractTextDocumentLayout::PaintContext context;
@@ -480,6 +603,7 @@ void HbRichTextItem::changeEvent(QEvent *event)
             prepareGeometryChange();
             d->mTextOption.setTextDirection(layoutDirection());
             d->mRtf->setDefaultTextOption(d->mTextOption);
+            d->invalidateLayoutCache();
             update();
         }
         break;
@@ -487,6 +611,7 @@ void HbRichTextItem::changeEvent(QEvent *event)
     case QEvent::FontChange: {
             d->mRtf->setDefaultFont(font());
             d->clearPrefSizeCache();
+            d->invalidatePaintCache();
             updateGeometry();
         }
         break;
@@ -497,6 +622,7 @@ void HbRichTextItem::changeEvent(QEvent *event)
         if (event->type() == HbEvent::ThemeChanged) {
             Q_D(HbRichTextItem);
             d->mDefaultColor = QColor();
+            d->invalidatePaintCache();
             if (!d->mColor.isValid()) {
                 update();
             }
@@ -549,6 +675,7 @@ void HbRichTextItem::setTextWrapping(Hb::TextWrapping mode)
         prepareGeometryChange();
         d->mTextOption.setWrapMode(textWrapMode);
         d->mRtf->setDefaultTextOption(d->mTextOption);
+        d->invalidateLayoutCache();
         d->calculateOffset();
         if (d->restoreDefaultHeightHint()) {
             updateGeometry();
@@ -41,8 +41,11 @@
 #include "hbrichtextitem.h"
 
 #include <QTextOption>
+#include <QPixmapCache>
+#include <QList>
 
 class QTextDocument;
+class QPainter;
 class HB_CORE_PRIVATE_EXPORT HbRichTextItemPrivate: public HbWidgetBasePrivate {
     Q_DECLARE_PUBLIC(HbRichTextItem)
 
@@ -67,6 +70,9 @@ public:
                                 qreal maxHeight);
 
     bool restoreDefaultHeightHint();
+    void invalidateLayoutCache();
+    void invalidatePaintCache() const;
+    bool paintCached(QPainter *painter, const QRectF &exposedRect);
 
     QString mText;
     QTextOption mTextOption; // used for alignment
@@ -80,6 +86,20 @@ public:
     mutable qreal  mMaxWidthForAdjust;
     mutable qreal  mDefaultPrefHeight;
 
+    // preferred sizes for the last few width constraints
+    struct SizeCacheEntry {
+        qreal constraintWidth;
+        QSizeF prefSize;
+        qreal maxWidthForAdjust;
+    };
+    mutable QList<SizeCacheEntry> mSizeCache;
+
+    // rendered document in QPixmapCache, see paintCached()
+    mutable QPixmapCache::Key mPaintCacheKey;
+    QRect mPaintCacheRect;
+    QPointF mPaintCacheOffset;
+    QRgb mPaintCacheColor;
+
     QColor mColor;
     mutable QColor mDefaultColor;
 };
@@ -68,6 +68,11 @@ static const QString KDefaultColorThemeName = "qtc_view_normal";
 const qreal MinimumWidth = 5.0; // minimum width if there is some text.
 const int KLayoutCacheLimit = 64;
 const qreal KFadeTolerance = 1.0;
+const int KFadeCacheMaxArea = 256*1024; // in pixels, larger faded texts are painted directly
+const int KFadeBufferKeepArea = 32*1024; // in pixels, larger composition buffers are released after use
+
+// Faded texts are composited in this image, it is shared by all text items.
+Q_GLOBAL_STATIC(QImage, fadeBuffer)
 
 HbTextItemPrivate::HbTextItemPrivate () :
     mAlignment(Qt::AlignLeft | Qt::AlignVCenter),
@@ -77,6 +82,10 @@ HbTextItemPrivate::HbTextItemPrivate () :
     mPaintFaded(false),
     mFadeLengthX(30),
     mFadeLengthY(15),
+    mFadeTextColor(0),
+    mFadeRenderHints(0),
+    mFadeMaskOffsetY(0),
+    mPaintingFadeMask(false),
     mMinLines(1),
     mMaxLines(0),
     mMinWidthForAdjust(-1),
@@ -115,6 +124,7 @@ bool HbTextItemPrivate::doLayout(const QString& text, const qreal lineWidth, qre
 {
     bool textTruncated = false;
 
+    releaseFadeCache();
     mTextLayout.setText(text);
 
     qreal yLinePos = 0;
@@ -625,6 +635,27 @@ inline void HbTextItemPrivate::setPainterPen(QPainter *painter,
 #endif // HB_FADE_EFFECT_WORKAROUND_ON_PHONE
 }
 
+/*
+    Draws a line of the text layout. While the fade mask is built the row of
+    the line is filled with the current pen instead, so that the mask gets
+    the same gradients the line would be drawn with.
+ */
+inline void HbTextItemPrivate::drawLine(QPainter *painter, int index, const QTextLine &line) const
+{
+    if (!mPaintingFadeMask) {
+        line.draw(painter, mOffsetPos);
+        return;
+    }
+
+    // rows cover the gaps between lines and the areas above the first and below the last line
+    qreal top = (index == 0) ? mFadeToRect.top() : line.y() + mOffsetPos.y();
+    qreal bottom = (index == mTextLayout.lineCount()-1)
+                   ? mFadeToRect.bottom()
+                   : mTextLayout.lineAt(index+1).y() + mOffsetPos.y();
+    painter->fillRect(QRectF(mFadeToRect.left(), top, mFadeToRect.width(), bottom-top),
+                      painter->pen().brush());
+}
+
 /*
     This method paints single piece of text layout.
     If line contains criticalX value then fadePen is used for painting in other
@@ -659,7 +690,7 @@ void HbTextItemPrivate::paintArea(QPainter *painter,
         }
 #endif // HB_FADE_EFFECT_WORKAROUND_ON_PHONE
 
-        line.draw(painter, mOffsetPos);
+        drawLine(painter, i, line);
     } // for i
 }
 
@@ -694,7 +725,7 @@ int HbTextItemPrivate::paintArea(QPainter *painter,
         setPainterPen(painter, normalPen, gradientOffset);
 #endif // HB_FADE_EFFECT_WORKAROUND_ON_PHONE
 
-        line.draw(painter, mOffsetPos);
+        drawLine(painter, i, line);
 
         if (lineRect.bottom()>lastValidY) {
             return i;
@@ -723,12 +754,12 @@ bool HbTextItemPrivate::setClipPath(QPainter *painter,
     return true;
 }
 
-void HbTextItemPrivate::paintWithFadeEffect(QPainter *painter) const
+void HbTextItemPrivate::paintWithFadeEffect(QPainter *painter, const QColor &color) const
 {
     Q_Q(const HbTextItem);
 
     QLinearGradient gradient;
-    setupGradient(&gradient, q->textColor());
+    setupGradient(&gradient, color);
     const QPainterPath initialClipPath = painter->clipPath();
 
     const QRectF contentRect = q->contentsRect();
@@ -800,7 +831,7 @@ void HbTextItemPrivate::paintWithFadeEffect(QPainter *painter) const
     // paint center part
     {
         int startFrom = i;
-        QPen centerPen(q->textColor());
+        QPen centerPen(color);
         if (setClipPath(painter,
                         QRectF(QPointF(mFadeFromRect.left(), centerRect.top()),
                                QPointF(mFadeFromRect.right(), centerRect.bottom())),
@@ -893,6 +924,130 @@ void HbTextItemPrivate::paintWithFadeEffect(QPainter *painter) const
     painter->setClipPath(initialClipPath);
 }
 
+/*
+    Paints the text with the fade effect by compositing cached images instead
+    of drawing the lines once for each gradient area. The lines are rendered
+    once into an image without fading. The gradients of paintWithFadeEffect()
+    are rendered into an alpha mask, which is rebuilt only when the fade
+    areas or the lines crossing the fade edges change. Moving the text, as
+    HbMarqueeItem does, then only blits the text image at the new offset
+    through the mask.
+
+    Returns false if the cache can't be used, for example when the painter
+    scales or rotates the item. The text must then be painted directly.
+ */
+bool HbTextItemPrivate::paintWithCachedFadeEffect(QPainter *painter, const QColor &color)
+{
+#ifdef HB_FADE_EFFECT_WORKAROUND_ON_PHONE
+    // the work-around moves the gradients to the line origins, which doesn't fit the mask
+    Q_UNUSED(painter)
+    Q_UNUSED(color)
+    return false;
+#else
+    Q_Q(HbTextItem);
+
+    const int n = mTextLayout.lineCount();
+    if (n == 0 || painter->worldTransform().type() > QTransform::TxTranslate) {
+        return false;
+    }
+
+    const QRect maskRect = mFadeToRect.toAlignedRect();
+    if (maskRect.isEmpty()) {
+        // all painting is clipped to the fade areas
+        return true;
+    }
+
+    if (mFadeTextImage.isNull()
+        || mFadeTextColor != color.rgba()
+        || mFadeRenderHints != painter->renderHints()) {
+        // the mask is rendered with the same hints
+        mFadeMask = QImage();
+        // glyphs may extend outside of the natural text rectangles
+        const qreal margin = QFontMetricsF(mTextLayout.font()).height()/2;
+        const QRect textRect = mBoundingRect.adjusted(-margin, -margin, margin, margin).toAlignedRect();
+        if (textRect.isEmpty()
+            || textRect.width()*textRect.height() > KFadeCacheMaxArea
+            || maskRect.width()*maskRect.height() > KFadeCacheMaxArea) {
+            return false;
+        }
+        mFadeTextImage = QImage(textRect.size(), QImage::Format_ARGB32_Premultiplied);
+        mFadeTextImage.fill(0);
+        QPainter textPainter(&mFadeTextImage);
+        textPainter.setRenderHints(painter->renderHints());
+        textPainter.setPen(color);
+        mTextLayout.draw(&textPainter, -textRect.topLeft());
+        mFadeTextOrigin = textRect.topLeft();
+        mFadeTextColor = color.rgba();
+        mFadeRenderHints = painter->renderHints();
+    }
+
+    // Lines crossing the left or right edge are faded horizontally.
+    const QRectF contentRect = q->contentsRect();
+    QBitArray edges(2*n);
+    for (int i=0; i<n; ++i) {
+        const QRectF lineRect = mTextLayout.lineAt(i).naturalTextRect().translated(mOffsetPos);
+        const qreal left = contentRect.left()-KFadeTolerance;
+        const qreal right = contentRect.right()+KFadeTolerance;
+        edges.setBit(2*i, lineRect.left()<left && lineRect.right()>left);
+        edges.setBit(2*i+1, lineRect.left()<right && lineRect.right()>right);
+    }
+
+    if (mFadeMask.isNull()
+        || mFadeMaskToRect != mFadeToRect
+        || mFadeMaskFromRect != mFadeFromRect
+        || mFadeMaskOffsetY != mOffsetPos.y()
+        || mFadeMaskEdges != edges) {
+        mFadeMask = QImage(maskRect.size(), QImage::Format_ARGB32_Premultiplied);
+        mFadeMask.fill(0);
+        QPainter maskPainter(&mFadeMask);
+        maskPainter.setRenderHints(painter->renderHints());
+        maskPainter.translate(-maskRect.topLeft());
+        mPaintingFadeMask = true;
+        paintWithFadeEffect(&maskPainter, Qt::white);
+        mPaintingFadeMask = false;
+        maskPainter.end();
+
+        mFadeMaskToRect = mFadeToRect;
+        mFadeMaskFromRect = mFadeFromRect;
+        mFadeMaskOffsetY = mOffsetPos.y();
+        mFadeMaskEdges = edges;
+    }
+
+    QImage *buffer = fadeBuffer();
+    if (!buffer) {
+        return false;
+    }
+    if (buffer->width() < maskRect.width() || buffer->height() < maskRect.height()) {
+        *buffer = QImage(qMax(buffer->width(), maskRect.width()),
+                         qMax(buffer->height(), maskRect.height()),
+                         QImage::Format_ARGB32_Premultiplied);
+    }
+    const QRect bufferRect(QPoint(0, 0), maskRect.size());
+    QPainter bufferPainter(buffer);
+    bufferPainter.setCompositionMode(QPainter::CompositionMode_Source);
+    bufferPainter.fillRect(bufferRect, Qt::transparent);
+    bufferPainter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    bufferPainter.drawImage(mOffsetPos + mFadeTextOrigin - maskRect.topLeft(), mFadeTextImage);
+    bufferPainter.setCompositionMode(QPainter::CompositionMode_DestinationIn);
+    bufferPainter.drawImage(0, 0, mFadeMask);
+    bufferPainter.end();
+
+    painter->drawImage(maskRect.topLeft(), *buffer, bufferRect);
+
+    // a buffer grown for an unusually large text is not kept around
+    if (buffer->width()*buffer->height() > KFadeBufferKeepArea) {
+        *buffer = QImage();
+    }
+    return true;
+#endif // HB_FADE_EFFECT_WORKAROUND_ON_PHONE
+}
+
+void HbTextItemPrivate::releaseFadeCache()
+{
+    mFadeTextImage = QImage();
+    mFadeMask = QImage();
+}
+
 void HbTextItemPrivate::setFadeLengths(qreal xLength, qreal yLength)
 {
     static const qreal KMinDiff = 0.5;
@@ -1214,15 +1369,18 @@ void HbTextItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option
 
     Q_ASSERT(d->mPaintFaded == d->fadeNeeded(contentsRect()));
     if(d->mPaintFaded ) {
-        // there is issue with restoring state of painter when
-        // setClipPath is used. It is impossible to restore
-        // original clipPath without save and restore whole painter
-        painter->save(); // see comment above
+        if (!d->paintWithCachedFadeEffect(painter, textColor())) {
+            // there is issue with restoring state of painter when
+            // setClipPath is used. It is impossible to restore
+            // original clipPath without save and restore whole painter
+            painter->save(); // see comment above
 
-        d->paintWithFadeEffect(painter);
+            d->paintWithFadeEffect(painter, textColor());
 
-        painter->restore(); // see comment above
+            painter->restore(); // see comment above
+        }
     } else {
+        d->releaseFadeCache();
         d->mTextLayout.draw(painter,
                             d->mOffsetPos,
                             QVector<QTextLayout::FormatRange>(),
@@ -1392,6 +1550,21 @@ void HbTextItem::changeEvent(QEvent *event)
     HbWidgetBase::changeEvent( event );
 }
 
+/*!
+    \reimp
+
+    Releases the cached images of faded text when the item is hidden.
+ */
+QVariant HbTextItem::itemChange(GraphicsItemChange change, const QVariant &value)
+{
+    Q_D(HbTextItem);
+
+    if (change == QGraphicsItem::ItemVisibleHasChanged && !value.toBool()) {
+        d->releaseFadeCache();
+    }
+    return HbWidgetBase::itemChange(change, value);
+}
+
 /*!
     \reimp
  */
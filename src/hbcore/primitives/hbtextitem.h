@@ -85,6 +85,7 @@ protected:
     QSizeF sizeHint(Qt::SizeHint which, const QSizeF &constraint = QSizeF()) const;
     void resizeEvent ( QGraphicsSceneResizeEvent * event );
     void changeEvent(QEvent *event);
+    QVariant itemChange(GraphicsItemChange change, const QVariant &value);
     void  updateGeometry();
     HbTextItem(HbTextItemPrivate &dd, QGraphicsItem *parent );
 
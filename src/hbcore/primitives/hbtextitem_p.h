@@ -38,13 +38,16 @@
 //
 
 #include <QTextLayout>
+#include <QImage>
+#include <QBitArray>
+#include <QPainter>
 #include "hbtextitem.h"
 #include "hbwidgetbase_p.h"
 
 class QFontMetricsF;
 class QLinearGradient;
 
-class HbTextItemPrivate : public HbWidgetBasePrivate
+class HB_AUTOTEST_EXPORT HbTextItemPrivate : public HbWidgetBasePrivate
 {
     Q_DECLARE_PUBLIC(HbTextItem)
 
@@ -99,6 +102,8 @@ public:
                   const QPen& normalPen,
                   qreal lastValidY) const;
 
+    inline void drawLine(QPainter *painter, int index, const QTextLine &line) const;
+
     int paintHorizontalSection(QPainter *painter,
                                int firstItemToPaint,
                                QLinearGradient& gradient,
@@ -116,7 +121,9 @@ public:
                      const QRectF& rect,
                      const QPainterPath& initialCliping) const;
 
-    void paintWithFadeEffect(QPainter *painter) const;
+    void paintWithFadeEffect(QPainter *painter, const QColor &color) const;
+    bool paintWithCachedFadeEffect(QPainter *painter, const QColor &color);
+    void releaseFadeCache();
 
     void setFadeLengths(qreal xLength, qreal yLength);
 
@@ -145,6 +152,18 @@ public:
     QRectF mFadeToRect;
     QRectF mFadeFromRect;
 
+    // cache of the faded text, see paintWithCachedFadeEffect()
+    QImage mFadeTextImage;
+    QPoint mFadeTextOrigin;
+    QRgb mFadeTextColor;
+    QPainter::RenderHints mFadeRenderHints;
+    QImage mFadeMask;
+    QRectF mFadeMaskToRect;
+    QRectF mFadeMaskFromRect;
+    qreal mFadeMaskOffsetY;
+    QBitArray mFadeMaskEdges;
+    bool mPaintingFadeMask;
+
     int mMinLines;
     int mMaxLines;
     mutable QSizeF mAdjustedSize;
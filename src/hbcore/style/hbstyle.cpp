@@ -106,6 +106,8 @@
 #include <QDebug>
 #include <QMetaClassInfo>
 
+#include "hbframeprofiler_p.h"
+
 #ifdef HB_TEXT_MEASUREMENT_UTILITY
 #include "hbinstance_p.h"
 #include "hbtextmeasurementutility_r.h"
@@ -2535,6 +2537,19 @@ void HbStylePrivate::updatePrimitive( QGraphicsItem *item, HbStylePrivate::Primi
     };
 }
 
+/*!
+  Looks up the style rules of \a node, timed by the frame profiler.
+  \internal
+*/
+static inline HbVector<HbCss::StyleRule> styleRulesForNode(
+    HbLayeredStyleLoader *styleLoader,
+    HbCss::StyleSelector::NodePtr node,
+    Qt::Orientation orientation)
+{
+    HbFrameProfilerScope profilerScope(HbFrameProfiler::CssLookup);
+    return styleLoader->styleRulesForNode(node, orientation);
+}
+
 /*!
   From qstylesheetstyle.cpp (declarations(...))
   \internal
@@ -3005,7 +3020,7 @@ void HbStyle::polish(HbWidget *widget, HbStyleParameters &params)
     HbDeviceProfile profile(HbDeviceProfile::profile(widget));
     HbCss::StyleSelector::NodePtr n(widget);
 
-    HbVector<HbCss::StyleRule> styleRules = styleLoader->styleRulesForNode(n, profile.orientation());
+    HbVector<HbCss::StyleRule> styleRules = styleRulesForNode(styleLoader, n, profile.orientation());
 
 #ifdef HBSTYLE_DEBUG
     qDebug() << "HbStyle::polish : Number of style rules:" << styleRules.count();
@@ -3250,7 +3265,7 @@ void HbStyle::updateThemedParams(HbWidget *widget)
     }
     HbCss::StyleSelector::NodePtr n(widget);
     HbDeviceProfile profile(HbDeviceProfile::profile(widget));
-    HbVector<HbCss::StyleRule> styleRules = styleLoader->styleRulesForNode(n, profile.orientation());
+    HbVector<HbCss::StyleRule> styleRules = styleRulesForNode(styleLoader, n, profile.orientation());
     if (!styleRules.count()) {
 #ifdef HBSTYLE_DEBUG
         qDebug() << "HbStyle::updateThemedParams : No style rules found.";
@@ -3459,7 +3474,7 @@ void HbStyle::widgetParameters(HbStyleParameters &params, HbWidget* widget) cons
     HbDeviceProfile profile(HbDeviceProfile::profile(widget));
     HbCss::StyleSelector::NodePtr n(widget);
 
-    HbVector<HbCss::StyleRule> styleRules = styleLoader->styleRulesForNode(n, profile.orientation());
+    HbVector<HbCss::StyleRule> styleRules = styleRulesForNode(styleLoader, n, profile.orientation());
 
 #ifdef HBSTYLE_DEBUG
     qDebug() << "HbStyle::widgetParameters : Number of style rules:" << styleRules.count();
@@ -26,9 +26,14 @@
 
 #include "hbtypefaceinfodatabase_p.h"
 #include <QFontMetrics>
+#include <QFontInfo>
 #include <QDir>
 #include <QDebug>
+#include <QDataStream>
 #include <QXmlStreamWriter>
+#include <QCoreApplication>
+#include <QVector>
+#include <stdio.h>
 
 // internal debug
 #undef HBTYPEFACEINFO_DEBUG_ENABLE
@@ -53,6 +58,10 @@
 #define ALIAS_STRING "alias"
 
 #define TYPEFACE_METRICS_FILE_STEM "typeface_metrics_"
+#define TYPEFACE_METRICS_CACHE_SUFFIX ".bin"
+// 'HBTM' and the format version of the metrics cache.
+static const quint32 METRICS_CACHE_MAGIC = 0x4842544d;
+static const quint32 METRICS_CACHE_VERSION = 1;
 static const int LARGEST_SIZE = 100;
 // Following must be greater than 0
 static const int SMALLEST_SIZE = 1;
@@ -126,6 +135,39 @@ static QString writablePath()
 }
 
 
+/*!
+Returns the file name, without the extension, used for the generated data of \a family.
+*/
+static QString metricsFileBaseName(const QString &family)
+{
+    QString temp = family;
+    temp = temp.toLower().replace(QRegExp("\\s+"), QString("_"));
+    return writablePath() + QDir::separator() + QString(TYPEFACE_METRICS_FILE_STEM) + temp;
+}
+
+/*!
+Identifies the font that the metrics were generated for. Qt does not tell which
+file a family was loaded from, so instead of the file time and size this uses the
+family the font was resolved to and the metrics of the largest size, which are a
+single measurement to check.
+*/
+struct HbTypefaceMetricsFingerprint
+{
+    QString resolvedFamily;
+    qint32 height;
+    qint32 ascent;
+
+    HbTypefaceMetricsFingerprint(const QString &family)
+    {
+        QFont f(family);
+        f.setPixelSize(LARGEST_SIZE);
+        QFontMetrics fm(f);
+        resolvedFamily = QFontInfo(f).family();
+        height = fm.height();
+        ascent = fm.ascent();
+    }
+};
+
 HbTypefaceInfoDatabase *HbTypefaceInfoDatabase::instance(HbMemoryManager::MemoryType type)
 {
     static HbTypefaceInfoDatabase info(type);
@@ -230,9 +272,15 @@ void HbTypefaceInfoDatabase::init()
     for( int i = 0; i < mTypefaceInfoVector->size(); i++ ) {
         HbTypefaceInfoItem *typeFaceInfoItem = &mTypefaceInfoVector->at(i);
 
-        if( !readTypefaceMetricsFile( parser, typeFaceInfoItem ) ) {
+        if( !readTypefaceMetricsFile( parser, typeFaceInfoItem )
+            && !readMetricsCache( typeFaceInfoItem ) ) {
             autoGenerateMetrics( typeFaceInfoItem );
+            writeMetricsCache( typeFaceInfoItem );
+#ifdef HBTYPEFACEINFO_DEBUG_ENABLE
+            // Would be picked up by readTypefaceMetricsFile on the next start,
+            // so only written when debugging.
             outputMetrics( typeFaceInfoItem );
+#endif
         }
     }
 
@@ -362,6 +410,115 @@ void HbTypefaceInfoDatabase::autoGenerateMetrics( HbTypefaceInfoItem *typeFaceIn
 }
 
 
+/*!
+Reads the downsize table generated by an earlier autoGenerateMetrics() call. Returns
+false if there is none, or if the font has changed since.
+*/
+bool HbTypefaceInfoDatabase::readMetricsCache( HbTypefaceInfoItem *typeFaceInfoItem ) const
+{
+    QFile file(metricsFileBaseName(typeFaceInfoItem->mFamily) + TYPEFACE_METRICS_CACHE_SUFFIX);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_4_6);
+    quint32 magic(0);
+    quint32 version(0);
+    QString family;
+    QString resolvedFamily;
+    qint32 height(0);
+    qint32 ascent(0);
+    quint32 count(0);
+    in >> magic >> version >> family >> resolvedFamily >> height >> ascent >> count;
+    if (in.status() != QDataStream::Ok || magic != METRICS_CACHE_MAGIC
+        || version != METRICS_CACHE_VERSION || typeFaceInfoItem->mFamily != family
+        || count == 0 || count > quint32(file.size())) {
+        return false;
+    }
+
+    HbTypefaceMetricsFingerprint fingerprint(family);
+    if (resolvedFamily != fingerprint.resolvedFamily
+        || height != fingerprint.height || ascent != fingerprint.ascent) {
+#ifdef HBTYPEFACEINFO_DEBUG_ENABLE
+        qDebug( "HbDownsizeInfo::readMetricsCache: font changed, regenerating metrics");
+#endif
+        return false;
+    }
+
+    QVector<HbTypefaceInfoItem::HbTypefaceMeasureInfoStruct> table(count);
+    for (quint32 i = 0; i < count; i++) {
+        qint16 textHeight;
+        qint16 pixelSize;
+        qint16 measuredAscent;
+        in >> textHeight >> pixelSize >> measuredAscent;
+        table[i].textHeight = textHeight;
+        table[i].pixelSize = pixelSize;
+        table[i].measuredAscent = measuredAscent;
+    }
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    for (quint32 i = 0; i < count; i++) {
+        typeFaceInfoItem->mDownSizeTable.append(table.at(i));
+    }
+    typeFaceInfoItem->mHighestExtent = table.last().textHeight;
+    return true;
+}
+
+/*!
+Stores the generated downsize table of \a typeFaceInfoItem for the next start. The
+data is written to a temporary file that then replaces the cache, so other processes
+never read a partial file.
+*/
+void HbTypefaceInfoDatabase::writeMetricsCache( HbTypefaceInfoItem *typeFaceInfoItem ) const
+{
+    QString filePath = writablePath();
+    QDir dir(filePath);
+    if(!dir.exists()) {
+        dir.mkpath(filePath + QDir::separator() );
+    }
+
+    QString cachePath = metricsFileBaseName(typeFaceInfoItem->mFamily) + TYPEFACE_METRICS_CACHE_SUFFIX;
+    QString tempPath = cachePath + QString(".%1").arg(QCoreApplication::applicationPid());
+    QFile file(tempPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return;
+    }
+
+    HbTypefaceMetricsFingerprint fingerprint(typeFaceInfoItem->mFamily);
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << METRICS_CACHE_MAGIC << METRICS_CACHE_VERSION
+        << QString(typeFaceInfoItem->mFamily) << fingerprint.resolvedFamily
+        << fingerprint.height << fingerprint.ascent
+        << quint32(typeFaceInfoItem->mDownSizeTable.size());
+    for( int i = 0; i < typeFaceInfoItem->mDownSizeTable.size(); i++ ) {
+        const HbTypefaceInfoItem::HbTypefaceMeasureInfoStruct &metrics =
+            typeFaceInfoItem->mDownSizeTable.at(i);
+        out << qint16(metrics.textHeight) << qint16(metrics.pixelSize)
+            << qint16(metrics.measuredAscent);
+    }
+    file.close();
+
+    if (out.status() != QDataStream::Ok || file.error() != QFile::NoError) {
+        QFile::remove(tempPath);
+        return;
+    }
+#ifdef Q_OS_UNIX
+    // rename() replaces the old file atomically.
+    bool renamed = ::rename(QFile::encodeName(tempPath).constData(),
+                            QFile::encodeName(cachePath).constData()) == 0;
+#else
+    QFile::remove(cachePath);
+    bool renamed = QFile::rename(tempPath, cachePath);
+#endif
+    if (!renamed) {
+        QFile::remove(tempPath);
+    }
+}
+
 void HbTypefaceInfoDatabase::outputMetrics( HbTypefaceInfoItem *typeFaceInfoItem ) const
 {
     QString filePath = writablePath();
@@ -87,6 +87,8 @@ private:
     void init();
     bool readTypefaceMetricsFile( HbTypefaceXmlParser *parser, HbTypefaceInfoItem *typeFaceInfoItem );
     void autoGenerateMetrics( HbTypefaceInfoItem *typeFaceInfoItem );
+    bool readMetricsCache( HbTypefaceInfoItem *typeFaceInfoItem ) const;
+    void writeMetricsCache( HbTypefaceInfoItem *typeFaceInfoItem ) const;
     void outputMetrics( HbTypefaceInfoItem *typeFaceInfoItem ) const;
     Q_DISABLE_COPY(HbTypefaceInfoDatabase)
 
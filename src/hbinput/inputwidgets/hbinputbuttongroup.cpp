@@ -32,6 +32,8 @@
 #include <QTimer>
 #include <QApplication>
 #include <QInputContext>
+#include <QStyleOptionGraphicsItem>
+#include <qmath.h>
 
 #include <hbmainwindow.h>
 #include <hbaction.h>
@@ -111,7 +113,7 @@ HbInputButtonGroupPrivate::HbInputButtonGroupPrivate()
     : mUnitValue(0), mGridSize(1, 1), mButtonBorderSize(1.0), mEnabled(true),
       mButtonPreviewEnabled(false), mCharacterSelectionPreviewEnabled(false),
       mMultiTouchEnabled(true), mCharacterSelectionPreview(0), mBackground(0),
-      mHasMouseGrab(false)
+      mHasMouseGrab(false), mLayerValid(false)
 {
     for (int i = 0; i < HbTextLayoutCount; ++i) {
         mTextLayouts.append(0);
@@ -531,7 +533,7 @@ void HbInputButtonGroupPrivate::pressEvent(const QPointF &position, bool emitSig
         item->setState(HbInputButton::ButtonStatePressed);
         updateGraphics(QSizeF(q->boundingRect().width(), q->boundingRect().height()));
         updateTextLayouts(QSizeF(q->boundingRect().width(), q->boundingRect().height()));
-        q->update();
+        updateButton(index);
 
         showButtonPreview(item);
 
@@ -593,7 +595,7 @@ void HbInputButtonGroupPrivate::doublePressEvent(const QPointF &position, bool e
         item->setState(HbInputButton::ButtonStatePressed);
         updateGraphics(QSizeF(q->boundingRect().width(), q->boundingRect().height()));
         updateTextLayouts(QSizeF(q->boundingRect().width(), q->boundingRect().height()));
-        q->update();
+        updateButton(index);
 
         showButtonPreview(item);
 
@@ -713,7 +715,7 @@ void HbInputButtonGroupPrivate::releaseEvent(const QPointF &position, bool emitS
         item->setState(HbInputButton::ButtonStateReleased);
         updateGraphics(QSizeF(q->boundingRect().width(), q->boundingRect().height()));
         updateTextLayouts(QSizeF(q->boundingRect().width(), q->boundingRect().height()));
-        q->update();
+        updateButton(activeIndex);
 
         if (mCharacterSelectionPreview && mCharacterSelectionPreview->isVisible()) {
             return;
@@ -1131,6 +1133,7 @@ qreal HbInputButtonGroupPrivate::fontSize(HbInputButtonGroup::HbInputButtonTextT
 void HbInputButtonGroupPrivate::setFontSize(HbInputButtonGroup::HbInputButtonTextType textType,qreal size)
 {
     mFontSize[textType] = size;
+    invalidateLayer();
 }
 
 void HbInputButtonGroupPrivate::resetFontSizes()
@@ -1140,6 +1143,124 @@ void HbInputButtonGroupPrivate::resetFontSizes()
     mFontSize[HbInputButtonGroup::ButtonTextTypeSecondaryFirstRow] = HbSecondaryTextSizeInUnits * mUnitValue;
     mFontSize[HbInputButtonGroup::ButtonTextTypeSecondarySecondRow] = HbSecondaryTextSizeInUnits * mUnitValue;
     mFontSize[HbInputButtonGroup::ButtonTextTypeLabel] = HbLabelTextSizeInUnits * mUnitValue;
+    invalidateLayer();
+}
+
+/*
+    Drops the cached keyboard layer, so it is rendered again on the next paint.
+    Needed for all changes other than the state of single buttons.
+*/
+void HbInputButtonGroupPrivate::invalidateLayer()
+{
+    mLayerValid = false;
+    mDirtyButtons.clear();
+}
+
+/*
+    Schedules repainting of the button at \a index only, after its state has changed.
+*/
+void HbInputButtonGroupPrivate::updateButton(int index)
+{
+    Q_Q(HbInputButtonGroup);
+
+    if (!mDirtyButtons.contains(index)) {
+        mDirtyButtons.append(index);
+    }
+    q->update(mButtonData.at(index)->boundingRect());
+}
+
+/*
+    Draws the parts of the button group that intersect \a rect.
+*/
+void HbInputButtonGroupPrivate::paintContent(QPainter *painter, const QRectF &rect)
+{
+    Q_Q(HbInputButtonGroup);
+
+    // Draw button group background
+    if (mBackground) {
+        painter->save();
+        painter->setClipRect(rect, Qt::IntersectClip);
+        mBackground->paint(painter, QRectF(0, 0, q->boundingRect().width(), q->boundingRect().height()));
+        painter->restore();
+    }
+
+    qreal cellWidth = q->boundingRect().width() / mGridSize.width();
+    qreal cellHeight = q->boundingRect().height() / mGridSize.height();
+
+    for (int i = 0; i < mButtonData.count(); ++i) {
+        HbInputButton *item = mButtonData.at(i);
+        if (!item->boundingRect().intersects(rect)) {
+            continue;
+        }
+
+        // Draw button backgrounds
+        if (mButtonDrawers.at(i)) {
+            qreal x = item->position().x() * cellWidth + mButtonBorderSize;
+            qreal y = item->position().y() * cellHeight + mButtonBorderSize;
+            qreal width = item->size().width() * cellWidth - 2 * mButtonBorderSize;
+            qreal height = item->size().height() * cellHeight - 2 * mButtonBorderSize;
+
+            painter->save();
+            painter->translate(x, y);
+            mButtonDrawers.at(i)->paint(painter, QRectF(0, 0, width, height));
+            painter->restore();
+        }
+
+        // Draw primary icons
+        if (!item->icon(HbInputButton::ButtonIconIndexPrimary).isNull()) {
+            qreal x = item->position().x() * cellWidth;
+            qreal y = item->position().y() * cellHeight;
+            qreal width = item->size().width() * cellWidth;
+            qreal height = item->size().height() * cellHeight;
+
+            if (!item->text(HbInputButton::ButtonTextIndexSecondaryFirstRow).isEmpty() ||
+                !item->text(HbInputButton::ButtonTextIndexSecondarySecondRow).isEmpty() ||
+                !item->icon(HbInputButton::ButtonIconIndexSecondaryFirstRow).isNull() ||
+                !item->icon(HbInputButton::ButtonIconIndexSecondarySecondRow).isNull()) {
+                x += HbHorizontalMarginInUnits * mUnitValue + mButtonBorderSize;
+                y += 0.5 * (item->size().height() * cellHeight - HbPrimaryIconSizeInUnits * mUnitValue);
+                width = HbPrimaryIconSizeInUnits * mUnitValue;
+                height = HbPrimaryIconSizeInUnits * mUnitValue;
+            }
+            item->icon(HbInputButton::ButtonIconIndexPrimary).paint(painter, QRectF(x, y, width, height));
+        }
+
+        // Draw secondary icons on first row
+        if (!item->icon(HbInputButton::ButtonIconIndexSecondaryFirstRow).isNull()) {
+            qreal x = (item->position().x() + item->size().width()) * cellWidth -
+                      HbSecondaryIconSizeInUnits * mUnitValue - HbHorizontalMarginInUnits * mUnitValue - mButtonBorderSize;
+            qreal y = (item->position().y() + item->size().height()) * cellHeight -
+                      HbSecondaryIconSizeInUnits * mUnitValue - HbVerticalMarginInUnits * mUnitValue - mButtonBorderSize;
+            qreal width = HbSecondaryIconSizeInUnits * mUnitValue;
+            qreal height = HbSecondaryIconSizeInUnits * mUnitValue;
+
+            Qt::Alignment alignment = static_cast<Qt::Alignment>(Qt::AlignVCenter | Qt::AlignRight);
+            item->icon(HbInputButton::ButtonIconIndexSecondaryFirstRow).paint(painter, QRectF(x, y, width, height), Qt::KeepAspectRatio, alignment);
+        }
+
+        // Draw secondary icons on second row
+        if (!item->icon(HbInputButton::ButtonIconIndexSecondarySecondRow).isNull()) {
+            qreal x = (item->position().x() + item->size().width()) * cellWidth -
+                      HbSecondaryIconSizeInUnits * mUnitValue - HbHorizontalMarginInUnits * mUnitValue - mButtonBorderSize;
+            qreal y = item->position().y() * cellHeight + HbVerticalMarginInUnits * mUnitValue + mButtonBorderSize;
+            qreal width = HbSecondaryIconSizeInUnits * mUnitValue;
+            qreal height = HbSecondaryIconSizeInUnits * mUnitValue;
+
+            Qt::Alignment alignment = static_cast<Qt::Alignment>(Qt::AlignVCenter | Qt::AlignRight);
+            item->icon(HbInputButton::ButtonIconIndexSecondaryFirstRow).paint(painter, QRectF(x, y, width, height), Qt::KeepAspectRatio, alignment);
+        }
+
+    }
+
+    // Draw button texts, only the lines inside the rectangle
+    for (int i = 0; i < HbTextLayoutCount; ++i) {
+        if (mTextLayouts.at(i)) {
+            painter->save();
+            painter->setPen(mColors.at(i % HbTextTypeCount));
+            mTextLayouts.at(i)->draw(painter, QPointF(0, 0), QVector<QTextLayout::FormatRange>(), rect);
+            painter->restore();
+        }
+    }
 }
 
 void HbInputButtonGroupPrivate::startLongPress(int index)
@@ -1188,6 +1309,7 @@ HbInputButtonGroup::HbInputButtonGroup(QGraphicsItem *parent)
     resetFontSizes();
 
     setAcceptedMouseButtons(Qt::LeftButton);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
 }
 
 /*!
@@ -1203,6 +1325,7 @@ HbInputButtonGroup::HbInputButtonGroup(HbInputButtonGroupPrivate &dd, QGraphicsI
     resetFontSizes();
 
     setAcceptedMouseButtons(Qt::LeftButton);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
 }
 
 /*!
@@ -1218,6 +1341,7 @@ HbInputButtonGroup::HbInputButtonGroup(const QSize &size, QGraphicsItem *parent)
     resetFontSizes();
 
     setAcceptedMouseButtons(Qt::LeftButton);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
 
     setGridSize(size);
 }
@@ -1235,6 +1359,7 @@ HbInputButtonGroup::HbInputButtonGroup(HbInputButtonGroupPrivate &dd, const QSiz
     resetFontSizes();
 
     setAcceptedMouseButtons(Qt::LeftButton);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
 
     setGridSize(size);
 }
@@ -1267,6 +1392,7 @@ void HbInputButtonGroup::setGridSize(const QSize &size)
     d->updateButtonGrid(QSizeF(boundingRect().width(), boundingRect().height()));
     d->updateGraphics(QSizeF(boundingRect().width(), boundingRect().height()));
     d->updateTextLayouts(QSizeF(boundingRect().width(), boundingRect().height()));
+    d->invalidateLayer();
     update();
 }
 
@@ -1307,6 +1433,7 @@ void HbInputButtonGroup::setButtons(const QList<HbInputButton *> &data)
     d->updateColorArray();
     d->updateGraphics(QSizeF(boundingRect().width(), boundingRect().height()));
     d->updateTextLayouts(QSizeF(boundingRect().width(), boundingRect().height()));
+    d->invalidateLayer();
     update();
 }
 
@@ -1478,6 +1605,7 @@ void HbInputButtonGroup::setCustomButtonActions(const QList<HbAction *> &actions
     d->updateCustomActions();
     d->updateGraphics(QSizeF(boundingRect().width(), boundingRect().height()));
     d->updateTextLayouts(QSizeF(boundingRect().width(), boundingRect().height()));
+    d->invalidateLayer();
     update();
 }
 
@@ -1518,6 +1646,7 @@ void HbInputButtonGroup::setButtonBorderSize(qreal borderSize)
     d->mButtonBorderSize = borderSize;
 
     d->updateGraphics(QSizeF(boundingRect().width(), boundingRect().height()));
+    d->invalidateLayer();
     update();
 }
 
@@ -1618,6 +1747,8 @@ void HbInputButtonGroup::setBackground(HbFrameDrawer *background)
 
     HbFrameDrawerPool::release(d->mBackground);
     d->mBackground = background;
+    d->invalidateLayer();
+    update();
 }
 
 /*!
@@ -1673,6 +1804,7 @@ void HbInputButtonGroup::setEnabled(bool enabled)
     d->mEnabled = enabled;
     d->updateGraphics(QSizeF(boundingRect().width(), boundingRect().height()));
     d->updateTextLayouts(QSizeF(boundingRect().width(), boundingRect().height()));
+    d->invalidateLayer();
     update();
 }
 
@@ -1688,96 +1820,77 @@ bool HbInputButtonGroup::isEnabled() const
     return d->mEnabled;
 }
 
+/*
+    Returns true if \a transform maps pixels one to one, that is, it only translates,
+    mirrors or rotates by multiples of 90 degrees.
+*/
+static bool mapsPixelsExactly(const QTransform &transform)
+{
+    if (transform.type() == QTransform::TxProject) {
+        return false;
+    }
+    bool axisAligned = qFuzzyIsNull(transform.m12()) && qFuzzyIsNull(transform.m21())
+                       && qFuzzyCompare(qAbs(transform.m11()), qreal(1))
+                       && qFuzzyCompare(qAbs(transform.m22()), qreal(1));
+    bool rotated = qFuzzyIsNull(transform.m11()) && qFuzzyIsNull(transform.m22())
+                   && qFuzzyCompare(qAbs(transform.m12()), qreal(1))
+                   && qFuzzyCompare(qAbs(transform.m21()), qreal(1));
+    return axisAligned || rotated;
+}
+
 /*!
 Draws the button group.
+
+The group is rendered once into a cached layer that is reused until the content, the size
+or the theme changes. When buttons are pressed or released only their rectangles are
+rendered into the layer again.
 */
 void HbInputButtonGroup::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
-    Q_UNUSED(option);
     Q_UNUSED(widget);
 
     Q_D(HbInputButtonGroup);
 
-    // Draw button group background
-    if (d->mBackground) {
-        d->mBackground->paint(painter, QRectF(0, 0, boundingRect().width(), boundingRect().height()));
-    }
-
-    qreal cellWidth = boundingRect().width() / d->mGridSize.width();
-    qreal cellHeight = boundingRect().height() / d->mGridSize.height();
-
-    for (int i = 0; i < d->mButtonData.count(); ++i) {
-        HbInputButton *item = d->mButtonData.at(i);
+    QRectF groupRect(0, 0, boundingRect().width(), boundingRect().height());
+    QRectF exposedRect = option->exposedRect & groupRect;
 
-        // Draw button backgrounds
-        if (d->mButtonDrawers.at(i)) {
-            qreal x = item->position().x() * cellWidth + d->mButtonBorderSize;
-            qreal y = item->position().y() * cellHeight + d->mButtonBorderSize;
-            qreal width = item->size().width() * cellWidth - 2 * d->mButtonBorderSize;
-            qreal height = item->size().height() * cellHeight - 2 * d->mButtonBorderSize;
-
-            painter->save();
-            painter->translate(x, y);
-            d->mButtonDrawers.at(i)->paint(painter, QRectF(0, 0, width, height));
-            painter->restore();
-        }
+    // The layer is drawn without scaling, so it is not used while the group is
+    // scaled or freely rotated, for example during an orientation change animation.
+    if (!mapsPixelsExactly(painter->worldTransform())) {
+        d->paintContent(painter, exposedRect);
+        return;
+    }
 
-        // Draw primary icons
-        if (!item->icon(HbInputButton::ButtonIconIndexPrimary).isNull()) {
-            qreal x = item->position().x() * cellWidth;
-            qreal y = item->position().y() * cellHeight;
-            qreal width = item->size().width() * cellWidth;
-            qreal height = item->size().height() * cellHeight;
+    QSize layerSize(qCeil(groupRect.width()), qCeil(groupRect.height()));
+    if (layerSize.isEmpty()) {
+        return;
+    }
 
-            if (!item->text(HbInputButton::ButtonTextIndexSecondaryFirstRow).isEmpty() ||
-                !item->text(HbInputButton::ButtonTextIndexSecondarySecondRow).isEmpty() ||
-                !item->icon(HbInputButton::ButtonIconIndexSecondaryFirstRow).isNull() ||
-                !item->icon(HbInputButton::ButtonIconIndexSecondarySecondRow).isNull()) {
-                x += HbHorizontalMarginInUnits * d->mUnitValue + d->mButtonBorderSize;
-                y += 0.5 * (item->size().height() * cellHeight - HbPrimaryIconSizeInUnits * d->mUnitValue);
-                width = HbPrimaryIconSizeInUnits * d->mUnitValue;
-                height = HbPrimaryIconSizeInUnits * d->mUnitValue;
+    if (!d->mLayerValid || d->mLayer.size() != layerSize) {
+        d->mLayer = QPixmap(layerSize);
+        d->mLayer.fill(Qt::transparent);
+        QPainter layerPainter(&d->mLayer);
+        layerPainter.setRenderHints(painter->renderHints());
+        d->paintContent(&layerPainter, groupRect);
+        d->mLayerValid = true;
+        d->mDirtyButtons.clear();
+    } else if (!d->mDirtyButtons.isEmpty()) {
+        QPainter layerPainter(&d->mLayer);
+        layerPainter.setRenderHints(painter->renderHints());
+        foreach(int index, d->mDirtyButtons) {
+            if (index < d->mButtonData.count()) {
+                QRect dirtyRect = d->mButtonData.at(index)->boundingRect().toAlignedRect();
+                layerPainter.setClipRect(dirtyRect);
+                layerPainter.setCompositionMode(QPainter::CompositionMode_Source);
+                layerPainter.fillRect(dirtyRect, Qt::transparent);
+                layerPainter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+                d->paintContent(&layerPainter, dirtyRect);
             }
-            item->icon(HbInputButton::ButtonIconIndexPrimary).paint(painter, QRectF(x, y, width, height));
         }
-
-        // Draw secondary icons on first row
-        if (!item->icon(HbInputButton::ButtonIconIndexSecondaryFirstRow).isNull()) {
-            qreal x = (item->position().x() + item->size().width()) * cellWidth -
-                      HbSecondaryIconSizeInUnits * d->mUnitValue - HbHorizontalMarginInUnits * d->mUnitValue - d->mButtonBorderSize;
-            qreal y = (item->position().y() + item->size().height()) * cellHeight -
-                      HbSecondaryIconSizeInUnits * d->mUnitValue - HbVerticalMarginInUnits * d->mUnitValue - d->mButtonBorderSize;
-            qreal width = HbSecondaryIconSizeInUnits * d->mUnitValue;
-            qreal height = HbSecondaryIconSizeInUnits * d->mUnitValue;
-
-            Qt::Alignment alignment = static_cast<Qt::Alignment>(Qt::AlignVCenter | Qt::AlignRight);
-            item->icon(HbInputButton::ButtonIconIndexSecondaryFirstRow).paint(painter, QRectF(x, y, width, height), Qt::KeepAspectRatio, alignment);
-        }
-
-        // Draw secondary icons on second row
-        if (!item->icon(HbInputButton::ButtonIconIndexSecondarySecondRow).isNull()) {
-            qreal x = (item->position().x() + item->size().width()) * cellWidth -
-                      HbSecondaryIconSizeInUnits * d->mUnitValue - HbHorizontalMarginInUnits * d->mUnitValue - d->mButtonBorderSize;
-            qreal y = item->position().y() * cellHeight + HbVerticalMarginInUnits * d->mUnitValue + d->mButtonBorderSize;
-            qreal width = HbSecondaryIconSizeInUnits * d->mUnitValue;
-            qreal height = HbSecondaryIconSizeInUnits * d->mUnitValue;
-
-            Qt::Alignment alignment = static_cast<Qt::Alignment>(Qt::AlignVCenter | Qt::AlignRight);
-            item->icon(HbInputButton::ButtonIconIndexSecondaryFirstRow).paint(painter, QRectF(x, y, width, height), Qt::KeepAspectRatio, alignment);
-        }
-
+        d->mDirtyButtons.clear();
     }
 
-    // Draw button texts
-    for (int i = 0; i < HbTextLayoutCount; ++i) {
-        painter->save();
-        painter->setPen(d->mColors.at(i % HbTextTypeCount));
-
-        if (d->mTextLayouts.at(i)) {
-            d->mTextLayouts.at(i)->draw(painter, QPointF(0, 0));
-        }
-        painter->restore();
-    }
+    painter->drawPixmap(exposedRect, d->mLayer, exposedRect);
 }
 
 /*!
@@ -1926,6 +2039,8 @@ void HbInputButtonGroup::changeEvent(QEvent *event)
                 item->setIcon(icon, HbInputButton::ButtonIconIndexPrimary);
             }
         }
+        d->invalidateLayer();
+        update();
     }
     HbWidget::changeEvent(event);
 }
@@ -2054,6 +2169,7 @@ void HbInputButtonGroup::cancelButtonPress()
     
     d->updateGraphics(QSizeF(boundingRect().width(), boundingRect().height()));
     d->updateTextLayouts(QSizeF(boundingRect().width(), boundingRect().height()));
+    d->invalidateLayer();
     update();
 }
 
@@ -2079,6 +2195,7 @@ void HbInputButtonGroup::updateCustomButtons()
     d->updateCustomActions();
     d->updateGraphics(QSizeF(boundingRect().width(), boundingRect().height()));
     d->updateTextLayouts(QSizeF(boundingRect().width(), boundingRect().height()));
+    d->invalidateLayer();
     update();
 }
 
@@ -28,6 +28,8 @@
 
 #include "hbwidget_p.h"
 
+#include <QPixmap>
+
 #include "hbinputbuttongroup.h"
 #include "hbinputbutton.h"
 
@@ -64,6 +66,10 @@ public:
 
     void _q_customActionDestroyed(QObject *object);
 
+    void invalidateLayer();
+    void updateButton(int index);
+    void paintContent(QPainter *painter, const QRectF &rect);
+
 protected:
     virtual void createPrimarySingleTextLayout(int index, const QHash<int, QString> &textContent, const QSizeF &size);
     virtual void createPrimaryTextLayout(int index, const QHash<int, QString> &textContent, const QSizeF &size);
@@ -113,6 +119,9 @@ public:
     QList<HbKeyPressProbability> mProbabilities;
     qreal mFontSize[HbInputButtonGroup::ButtonTextTypeLabel+1];
     bool mHasMouseGrab;
+    QPixmap mLayer;
+    bool mLayerValid;
+    QList<int> mDirtyButtons;
 };
 
 #endif // HB_INPUT_BUTTON_GROUP_PRIVATE_H
@@ -111,9 +111,12 @@ void HbInputServerMethods::updateSharedMethodList()
     memcpy(static_cast<char*>(mSharedMethods->data())+sizeof(int), mMethodsSerialized->constData(), mMethodsSerialized->size());
     mSharedMethods->unlock();
 
-    // Update modification time
+    // Update modification time, the clients only compare it to the value they have seen
+    // so it must change also when there are several updates within a second
     mSharedMethodsModTime->lock();
-    *static_cast<uint*>(mSharedMethodsModTime->data()) = QDateTime::currentDateTime().toTime_t();
+    uint *modTime = static_cast<uint*>(mSharedMethodsModTime->data());
+    uint now = QDateTime::currentDateTime().toTime_t();
+    *modTime = (now > *modTime) ? now : *modTime + 1;
     mSharedMethodsModTime->unlock();
     mServer->debugPrint("Shared memory for input methods updated");
 }
@@ -147,7 +150,7 @@ void HbInputServerMethods::updateLocalInputMethodList(const QString &path)
     buffer.open(QIODevice::WriteOnly);
 
     QDataStream out(&buffer);
-    out << *mMethods;
+    HbInputModeCachePrivate::writeSharedMethodList(out, *mMethods);
     mServer->debugPrint("Method list updated, new size: " + QString::number(mMethodsSerialized->size()));
 }
 
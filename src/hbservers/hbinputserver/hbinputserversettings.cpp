@@ -63,9 +63,11 @@ bool HbInputServerSettings::initialize()
     }
 
     mSettings->lock();
+    HbInputSettingProxyPrivate::beginWrite(settingsData());
     if (!initializeFromDisk()) {
         initializeWithDefaults();
     }
+    HbInputSettingProxyPrivate::endWrite(settingsData());
     mSettings->unlock();
     mServer->debugPrint("Settings initialized");
     return true;
@@ -360,7 +360,9 @@ bool HbSplashGenServerSymbian::processGetSplash(const RMessage2 &message)
     bool usingAppSpecific = false;
     QString genericName = QString("splash_%1.spl").arg(orientation);
     QString name = genericName;
-    if (cachedEntryListValid) {
+    if (message.Function() == HbSplashSrvGetSplashBaseFile) {
+        // The base of a delta-encoded screen is always the generic one.
+    } else if (cachedEntryListValid) {
         if (!appId.isEmpty() && mSplashScreenDirEntries.contains(appSpecificName, Qt::CaseInsensitive)) {
             name = appSpecificName;
             usingAppSpecific = true;
@@ -428,12 +430,21 @@ void HbSplashGenServerSession::ServiceL(const RMessage2 &message)
           param 1  [in] empty or uid (currently ignored if does not match the client's secure id)
           param 2  [in] empty or screen id
           param 3 [out] CFbsBitmap handle
+
+      EHbSplashSrvGetSplashBaseFile
+          param 0  [in] requested orientation ("prt" or "lsc")
+          param 1  [in] ignored
+          param 2  [in] ignored
+          param 3 [out] RFile handle for the generic screen (file is open for read)
+          Request is completed with RFs handle or KErrNotFound.
+          Used by clients to decode delta-encoded screens.
      */
 
     splDeb() << PRE << "ServiceL" << message.Function() << QString::number(message.SecureId().iId, 16);
     switch (message.Function()) {
     case HbSplashSrvGetSplashFile: // fallthrough
-    case HbSplashSrvGetSplashData:
+    case HbSplashSrvGetSplashData: // fallthrough
+    case HbSplashSrvGetSplashBaseFile:
         if (!mServer->processGetSplash(message)) {
             message.Complete(KErrNotFound);
         }
@@ -26,6 +26,7 @@
 #include "hbsplashgenerator_p.h"
 #include "hbsplashdirs_p.h"
 #include "hbsplashdefs_p.h"
+#include "hbsplashcodec_p.h"
 #include "hbmainwindow.h"
 #include "hbmainwindow_p.h"
 #include "hbinstance.h"
@@ -50,6 +51,9 @@
 #include <QTranslator>
 #include <QLocale>
 #include <QTimer>
+#include <QDateTime>
+#include <QVector>
+#include <QRect>
 
 #if defined(Q_OS_SYMBIAN)
 #include <f32file.h>
@@ -222,6 +226,7 @@ void HbSplashGenerator::regenerate()
             // not finished when a new app is started then it is better to show
             // no splash screen at all.
             delete_splash_screens();
+            mSplBases.clear();
             // Clear the queue, generating screens with a non-current theme is
             // not possible anyway.
             mQueue.clear();
@@ -482,6 +487,62 @@ QString HbSplashGenerator::splashFileName()
     return splashFile;
 }
 
+// Rows of the delta rectangles that are closer than this are merged.
+const int delta_band_gap = 8;
+
+// Returns the rectangles in which `image' differs from `base'. Consecutive
+// differing rows are grouped into bands, each band becomes one rectangle
+// covering the differing columns of its rows.
+static QVector<QRect> deltaRects(const QImage &base, const QImage &image)
+{
+    const int w = image.width();
+    const int h = image.height();
+    QVector<QRect> rects;
+    int top = -1;
+    int bottom = -1;
+    int left = w;
+    int right = -1;
+    for (int y = 0; y < h; ++y) {
+        const quint32 *a = reinterpret_cast<const quint32 *>(base.scanLine(y));
+        const quint32 *b = reinterpret_cast<const quint32 *>(image.scanLine(y));
+        int l = 0;
+        while (l < w && a[l] == b[l]) {
+            ++l;
+        }
+        if (l == w) {
+            continue;
+        }
+        int r = w - 1;
+        while (r > l && a[r] == b[r]) {
+            --r;
+        }
+        if (top >= 0 && y - bottom > delta_band_gap) {
+            rects.append(QRect(left, top, right - left + 1, bottom - top + 1));
+            top = -1;
+            left = w;
+            right = -1;
+        }
+        if (top < 0) {
+            top = y;
+        }
+        bottom = y;
+        left = qMin(left, l);
+        right = qMax(right, r);
+    }
+    if (top >= 0) {
+        rects.append(QRect(left, top, right - left + 1, bottom - top + 1));
+    }
+    if (rects.count() > int(hbsplash_max_delta_rects)) {
+        QRect bounds;
+        foreach (const QRect &rect, rects) {
+            bounds |= rect;
+        }
+        rects.clear();
+        rects.append(bounds);
+    }
+    return rects;
+}
+
 bool HbSplashGenerator::saveSpl(const QString &nameWithoutExt, const QImage &image, quint32 extra)
 {
     QString fn(nameWithoutExt);
@@ -492,27 +553,81 @@ bool HbSplashGenerator::saveSpl(const QString &nameWithoutExt, const QImage &ima
         quint32 h = (quint32) image.height();
         quint32 bpl = (quint32) image.bytesPerLine();
         qint32 fmt = (qint32) image.format();
-        f.write((char *) &w, sizeof(quint32));
-        f.write((char *) &h, sizeof(quint32));
-        f.write((char *) &bpl, sizeof(quint32));
-        f.write((char *) &fmt, sizeof(qint32));
-        f.write((char *) &extra, sizeof(quint32));
+        // The id is the full time of writing, bumped by one when several
+        // screens are written within the same second to keep it unique.
+        static quint32 lastId = 0;
+        quint32 id = qMax(QDateTime::currentDateTime().toTime_t(), lastId + 1);
+        lastId = id;
+        quint32 baseId = 0;
+        const bool isBase = mItem.mAppId.isEmpty();
+        QVector<QRect> rects;
+        QByteArray body;
+#ifdef HB_SPLASH_DELTA_ENCODING
+        // Application-specific screens typically differ from the generic one
+        // only in the title and the content area, so store just those parts
+        // when that is less than half of the image.
+        if (!isBase && mSplBases.contains(mItem.mOrientation)) {
+            const SplBase &base(mSplBases[mItem.mOrientation]);
+            if (base.mImage.size() == image.size()
+                && base.mImage.format() == QImage::Format_ARGB32_Premultiplied
+                && image.format() == QImage::Format_ARGB32_Premultiplied) {
+                rects = deltaRects(base.mImage, image);
+                int deltaSize = 0;
+                foreach (const QRect &rect, rects) {
+                    deltaSize += rect.width() * rect.height() * 4;
+                }
+                if (!rects.isEmpty() && deltaSize < int(bpl * h) / 2) {
+                    baseId = base.mId;
+                    body.reserve(deltaSize);
+                    foreach (const QRect &rect, rects) {
+                        for (int y = rect.top(); y <= rect.bottom(); ++y) {
+                            body.append(reinterpret_cast<const char *>(image.scanLine(y)) + rect.left() * 4,
+                                        rect.width() * 4);
+                        }
+                    }
+                    splDeb() << PRE << "delta encoded" << rects.count() << "rects," << deltaSize << "bytes";
+                } else {
+                    rects.clear();
+                }
+            }
+        }
+#endif
+        if (!baseId) {
+            body = QByteArray::fromRawData(reinterpret_cast<const char *>(image.bits()), bpl * h);
+        }
+        quint32 codec = HbSplashCodecRaw;
 #ifdef HB_SPLASH_COMPRESSION
         QTime t;
         t.start();
-        QByteArray compData = qCompress((const uchar *) image.bits(), bpl * h);
-        quint32 len = compData.size();
-        splDeb() << PRE << "compressed" << bpl * h << "to" << len << "in" << t.elapsed() << "ms";
-        f.write((char *) &len, sizeof(quint32));
-        qint64 wcount = f.write(compData.constData(), len);
-#else
-        quint32 len = 0; // 0 compressed length indicates uncompressed data
-        f.write((char *) &len, sizeof(quint32));
-        len = bpl * h;
-        qint64 wcount = f.write((const char *) image.bits(), len);
+        int uncompressedSize = body.size();
+        body = HbSplashCodec::compress(reinterpret_cast<const uchar *>(body.constData()), body.size());
+        codec = HbSplashCodecLz;
+        splDeb() << PRE << "compressed" << uncompressedSize << "to" << body.size() << "in" << t.elapsed() << "ms";
 #endif
+        quint32 len = body.size();
+        quint32 header[] = {
+            hbsplash_file_magic, 0, hbsplash_file_version,
+            w, h, bpl, (quint32) fmt, extra,
+            codec, codec == HbSplashCodecRaw ? 0 : len, id, baseId, (quint32) rects.count()
+        };
+        f.write((const char *) header, sizeof(header));
+        foreach (const QRect &rect, rects) {
+            quint32 r[] = { (quint32) rect.x(), (quint32) rect.y(),
+                            (quint32) rect.width(), (quint32) rect.height() };
+            f.write((const char *) r, sizeof(r));
+        }
+        qint64 wcount = f.write(body.constData(), len);
         f.close();
-        return wcount == len;
+        if (wcount != len) {
+            return false;
+        }
+        if (isBase) {
+            SplBase base;
+            base.mImage = image;
+            base.mId = id;
+            mSplBases.insert(mItem.mOrientation, base);
+        }
+        return true;
     }
     return false;
 }
@@ -520,6 +635,7 @@ bool HbSplashGenerator::saveSpl(const QString &nameWithoutExt, const QImage &ima
 void HbSplashGenerator::cleanup()
 {
     mQueue.clear();
+    mSplBases.clear();
     delete mMainWindow;
     mMainWindow = 0;
     clearTranslators();
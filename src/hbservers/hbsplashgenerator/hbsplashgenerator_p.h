@@ -144,6 +144,11 @@ private:
     QHash<QString, QueueItem> mParsedSplashmls;
     QSettings *mSettings;
     QFileSystemWatcher mFsWatcher;
+    struct SplBase {
+        QImage mImage;
+        quint32 mId;
+    };
+    QHash<int, SplBase> mSplBases;
 };
 
 QDebug operator<<(QDebug dbg, const HbSplashGenerator::QueueItem &item);
@@ -125,9 +125,7 @@ bool HbPixmapIconProcessor::createIconData(const QString& iconPath)
     } else if (iconType == "PIC") {
         isIconCreated = renderPicToPixmap(iconPath);
     } else if (iconType == "NVG") {
-#if defined (HB_NVG_CS_ICON)
         isIconCreated = renderNvgToPixmap(iconPath);
-#endif //HB_NVG_CS_ICON
     } else {
         isIconCreated = renderOtherFormatsToPixmap(iconPath);
     }
@@ -158,8 +156,6 @@ bool HbPixmapIconProcessor::createIconData(const QString& iconPath)
     return isIconCreated;
 }
 
-#if defined (HB_NVG_CS_ICON)
-
 bool HbPixmapIconProcessor::renderNvgToPixmap(const QString& iconPath)
 {
     bool success = false;
@@ -197,7 +193,6 @@ bool HbPixmapIconProcessor::renderNvgToPixmap(const QString& iconPath)
     return success;
 }
 
-#endif
 /*!
     \fn HbPixmapIconProcessor::renderSvgToPixmap()
     \a iconpath
@@ -28,6 +28,7 @@
 
 #include "hbiconprocessor_p.h"
 #include <QPixmap>
+#include "hbnvgrasterizer_p.h"
 
 #if defined (HB_NVG_CS_ICON) 
 #include <nvg.h>
@@ -36,7 +37,6 @@
 //       match the cases of the corresponding directories in Symbian 4.
 #include <VG/openvg.h>
 #include <vg/vgcontext_symbian.h>
-#include "hbnvgrasterizer_p.h"
 #endif //HB_NVG_CS_ICON
 
 QT_BEGIN_NAMESPACE
@@ -65,9 +65,7 @@ public :
                                   HbMultiIconParams &multiPieceIconParams);
 
 private :
-#if defined (HB_NVG_CS_ICON)
     bool renderNvgToPixmap(const QString& iconPath);
-#endif
     bool renderSvgToPixmap(const QString& iconPath);
     bool renderPicToPixmap(const QString& iconPath);
     bool renderOtherFormatsToPixmap(const QString& iconPath);
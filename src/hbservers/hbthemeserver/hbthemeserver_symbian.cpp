@@ -308,6 +308,7 @@ void HbThemeServerPrivate::HandleThemeSelection( const QString& themeName)
 
     // Clear cached icons and session data
     clearIconCache();
+    HbThemeServerUtils::clearSharedStylesheets();
     iSessionIter.SetToFirst();
     while(iSessionIter) {
         HbThemeServerSession &session = reinterpret_cast<HbThemeServerSession &>(*iSessionIter);
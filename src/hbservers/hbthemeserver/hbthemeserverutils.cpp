@@ -38,6 +38,7 @@
 #include "hbcssparser_p.h"
 #include "hbeffectfxmldata_p.h"
 #include "hbeffectxmlparser_p.h"
+#include "hbeffectbinaryfxml_p.h"
 #include "hbdeviceprofiledatabase_p.h"
 #include "hbthemeperf_p.h"
 #include "hbiconsource_p.h"
@@ -55,6 +56,11 @@ Q_GLOBAL_STATIC(HbServerCache, effCache)
 typedef QHash<QString, int> ServerHashForLayoutDefs;
 Q_GLOBAL_STATIC(ServerHashForLayoutDefs, layoutDefsCache)
 
+// cache at the server side to maintain the offsets of the stylesheets
+// of the operator and theme layers, which are not stored in the shared cache.
+typedef QHash<QString, int> ServerHashForStylesheets;
+Q_GLOBAL_STATIC(ServerHashForStylesheets, stylesheetCache)
+
 // Offset for the cache of the missed CSS files for classes starting 'hb'
 static int missedHbCssFilesOffset = -1;
 static const QString HB_CLASSNAME_PREFIX("hb");
@@ -123,14 +129,28 @@ int HbThemeServerUtils::getSharedStylesheet(const QString &fileName,
 {
     qptrdiff cssOffset = -1;
     HbSharedCache *sharedCache = 0;
+    QString key;
     if (priority == HbLayeredStyleLoader::Priority_Core) {
         sharedCache = HbSharedCache::instance();
         cssOffset = sharedCache->offset(HbSharedCache::Stylesheet, fileName);
         if (inSharedCache) {
             *inSharedCache = (cssOffset >= 0) ? true : false;
         }
-    } else if (inSharedCache) {
-        *inSharedCache = false;
+    } else {
+        if (inSharedCache) {
+            *inSharedCache = false;
+        }
+        // All clients ask for the same operator and theme layer stylesheets,
+        // so each of them is parsed only once.
+        key.reserve(fileName.length() + 2);
+        key.append(QString::number(priority))
+           .append(QChar('\0'))
+           .append(fileName);
+        ServerHashForStylesheets::const_iterator cached = stylesheetCache()->constFind(key);
+        if (cached != stylesheetCache()->constEnd()) {
+            fileExists = true;
+            return cached.value();
+        }
     }
 
     if (cssOffset < 0) {
@@ -143,6 +163,8 @@ int HbThemeServerUtils::getSharedStylesheet(const QString &fileName,
         }
         if (sharedCache) { //sharedCache valid only when priority is Priority_Core
             sharedCache->add(HbSharedCache::Stylesheet, fileName, cssOffset);
+        } else if (cssOffset >= 0) {
+            stylesheetCache()->insert(key, cssOffset);
         }
     }
     return cssOffset;
@@ -332,6 +354,16 @@ bool HbThemeServerUtils::removeSharedEffect(const QString &fileName)
     return false;
 }
 
+/**
+ * Forgets the operator and theme stylesheets parsed so far so that they are
+ * parsed again on the next request. The parsed data is not released as
+ * clients may still refer to it.
+ */
+void HbThemeServerUtils::clearSharedStylesheets()
+{
+    stylesheetCache()->clear();
+}
+
 /**
  * Clears fxml documents from the shared memory and effects cache
  *
@@ -391,13 +423,21 @@ int HbThemeServerUtils::getSharedEffect(const QString &fileName)
 
         if (f.open(QIODevice::ReadOnly)) {
             try {
-                QByteArray arr(f.readAll());
-                fxmlBuffer.setBuffer(&arr);
-                if (fxmlBuffer.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                    parser.read(&fxmlBuffer, data);
+                bool isBinary = false;
+                bool binaryRead = HbEffectBinaryFxml::readFile(&f, data, &isBinary);
+                QByteArray arr;
+                if (isBinary) {
+                    // precompiled effect definition, nothing to parse
+                    fail = !binaryRead;
                 } else {
-                    THEME_GENERIC_DEBUG() << "Cannot open fxmlBuffer from file:" << fileName;
-                    fail = true;
+                    arr = f.readAll();
+                    fxmlBuffer.setBuffer(&arr);
+                    if (fxmlBuffer.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                        parser.read(&fxmlBuffer, data);
+                    } else {
+                        THEME_GENERIC_DEBUG() << "Cannot open fxmlBuffer from file:" << fileName;
+                        fail = true;
+                    }
                 }
 
                 // 3. Mark an entry for this styleSheet into the table
@@ -50,6 +50,7 @@ public:
                                    bool &fileExists,
                                    bool *inSharedCache = 0);
     static int getMissedHbCssFilesOffset();
+    static void clearSharedStylesheets();
     static bool parseCssFile(HbCss::Parser &parser, 
                              const QString &fileName, 
                              int &cssOffset,
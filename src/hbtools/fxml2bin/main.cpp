@@ -0,0 +1,154 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the HbTools module of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QFile>
+#include <QDir>
+#include <QDirIterator>
+#include <QBuffer>
+#include <hbeffectfxmldata_p.h>
+#include <hbeffectxmlparser_p.h>
+#include <hbeffectbinaryfxml_p.h>
+#include <iostream>
+
+static const QString FxmlFileExtension = ".fxml";
+
+void showHelp() {
+    std::cout << "fxml2bin.exe usage:\n\n";
+
+    std::cout << "fxml2bin -s sourceFile [-t targetFile]\n";
+    std::cout << "fxml2bin -i sourceDirectory -o targetDirectory\n\n";
+
+    std::cout << "    Converts fxml effect definition files to the precompiled binary\n";
+    std::cout << "    format. The binary file can be installed with the same name as\n";
+    std::cout << "    the fxml file, it is recognized from its header.\n\n";
+
+    std::cout << "    If target file name is not given creates file named\n";
+    std::cout << "    <source file> + \".bin\".\n\n";
+
+    std::cout << "options:\n\n";
+
+    std::cout << " -s \t\tname of the source file (\"<filename.fxml>\").\n";
+    std::cout << " -t \t\tname of the target file.\n";
+    std::cout << " -i \t\tdirectory searched recursively for fxml files.\n";
+    std::cout << " -o \t\tdirectory where the binary files are written with the\n";
+    std::cout << "    \t\tsame relative paths and names as the fxml files.\n\n";
+
+    std::cout << "Example:\n";
+    std::cout << "fxml2bin.exe -i themes/effects -o c:/resources/themes/effects\n\n";
+}
+
+bool convert(const QString &source, const QString &target)
+{
+    QFile sourceFile(source);
+    if (!sourceFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        std::cout << "Error: cannot open " << source.toStdString() << ".\n";
+        return false;
+    }
+    QByteArray contents(sourceFile.readAll());
+    sourceFile.close();
+
+    QBuffer buffer(&contents);
+    buffer.open(QIODevice::ReadOnly | QIODevice::Text);
+    HbEffectFxmlData data;
+    HbEffectXmlParser parser;
+    if (!parser.read(&buffer, &data)) {
+        std::cout << "Error: parsing of " << source.toStdString() << " failed: "
+                  << parser.errorString().toStdString() << "\n";
+        return false;
+    }
+
+    QFile targetFile(target);
+    if (!targetFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::cout << "Error: cannot write " << target.toStdString() << ".\n";
+        return false;
+    }
+    bool ok = HbEffectBinaryFxml::write(&targetFile, data);
+    targetFile.close();
+    if (!ok) {
+        std::cout << "Error: writing of " << target.toStdString() << " failed.\n";
+        QFile::remove(target);
+    }
+    return ok;
+}
+
+bool convertDirectory(const QString &sourceDir, const QString &targetDir)
+{
+    bool ok = true;
+    QDir source(sourceDir);
+    QDirIterator iterator(sourceDir, QStringList() << ('*' + FxmlFileExtension),
+                          QDir::Files, QDirIterator::Subdirectories);
+    while (iterator.hasNext()) {
+        QString file = iterator.next();
+        QString target = QDir(targetDir).filePath(source.relativeFilePath(file));
+        QDir().mkpath(QFileInfo(target).absolutePath());
+        ok = convert(file, target) && ok;
+    }
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    if (argc <= 2) {
+        showHelp();
+        return 0;
+    }
+
+    QString source, target, sourceDir, targetDir;
+    QStringList args(app.arguments());
+
+    for (int n = 1; n < args.count() - 1; n++) {
+        if (args[n].toLower() == "-s") {
+            source = args[++n];
+        } else if (args[n].toLower() == "-t") {
+            target = args[++n];
+        } else if (args[n].toLower() == "-i") {
+            sourceDir = args[++n];
+        } else if (args[n].toLower() == "-o") {
+            targetDir = args[++n];
+        }
+    }
+
+    bool ok = false;
+    if (!sourceDir.isEmpty() && !targetDir.isEmpty()) {
+        ok = convertDirectory(sourceDir, targetDir);
+    } else if (!source.isEmpty()) {
+        if (!QFile::exists(source)) {
+            std::cout << "Error: file " << source.toStdString() << " does not exist.\n";
+        } else {
+            if (target.isEmpty()) {
+                target = source + ".bin";
+            }
+            ok = convert(source, target);
+        }
+    } else {
+        showHelp();
+        return 0;
+    }
+    return ok ? 0 : 1;
+}
@@ -30,6 +30,7 @@ TEMPLATE = subdirs
 SUBDIRS += hbthemeindexer
 SUBDIRS += hbbincssmaker
 SUBDIRS += docml2bin
+SUBDIRS += fxml2bin
 
 include($${HB_SOURCE_DIR}/src/hbcommon.pri)
 
@@ -422,6 +422,11 @@ this method.
 */
 void HbDataForm::scrollTo(const QModelIndex &index, ScrollHint hint)
 {
+    Q_D(HbDataForm);
+    // The items are created only when they come near the visible area
+    if (index.isValid() && index.model() == model()) {
+        static_cast<HbDataItemContainer*>(d->mContainer)->createItemsUntil(index);
+    }
     HbAbstractItemView::scrollTo(index, hint);
 }
 
@@ -691,7 +696,28 @@ void HbDataForm::initStyleOption(HbStyleOptionDataForm *option)
 */
 void HbDataForm::rowsInserted(const QModelIndex &parent, int start, int end)
 {
+    Q_D(HbDataForm);
     HbAbstractItemView::rowsInserted(parent, start, end);
+
+    // Pages are added to the combo boxes also when their items are not created yet
+    for (int i = start; i <= end; i++) {
+        QModelIndex childIndex = model()->index(i, 0, parent);
+        if (itemByIndex(childIndex)) {
+            continue;
+        }
+        HbDataFormModelItem::DataItemType itemType = static_cast<HbDataFormModelItem::DataItemType>(
+            childIndex.data(HbDataFormModelItem::ItemTypeRole).toInt());
+        QString label = childIndex.data(HbDataFormModelItem::LabelRole).toString();
+
+        if (itemType == HbDataFormModelItem::FormPageItem && !parent.isValid()) {
+            d->addFormPage(label);
+        } else if (itemType == HbDataFormModelItem::GroupPageItem) {
+            HbDataGroup *groupItem = static_cast<HbDataGroup*>(itemByIndex(parent));
+            if (groupItem) {
+                HbDataGroupPrivate::d_ptr(groupItem)->setGroupPage(label);
+            }
+        }
+    }
 }
 
 /*!
@@ -76,6 +76,8 @@ void HbDataFormPrivate::init()
     protos.append(new HbDataGroup());
     q->setItemPrototypes(protos);
     q->setClampingStyle(HbScrollArea::BounceBackClamping);
+    // View items are not recycled, since they are different kinds of widgets.
+    // HbDataItemContainer creates them only when they come near the visible area.
     q->setItemRecycling(false);
     treeModelIterator()->setItemContainer(mContainer);
 }
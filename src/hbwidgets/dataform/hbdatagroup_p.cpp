@@ -696,6 +696,16 @@ void HbDataGroup::updateChildItems()
             static_cast<HbDataFormModelItem*>( data_model->itemFromIndex( d->mIndex ) );
         d->setEnabled( model_item->isEnabled( ) );
 
+        // The items of the group pages are created only when they are scrolled near,
+        // but all the pages need to be in the combo box.
+        int childCount = model_item->childCount();
+        for (int i = 0; i < childCount; ++i) {
+            HbDataFormModelItem *child = model_item->childAt(i);
+            if (child->type() == HbDataFormModelItem::GroupPageItem) {
+                d->setGroupPage(child->label());
+            }
+        }
+
         if(container) {
             if(container->itemTransientState(d->mIndex).value("expanded").toBool()) {
                 container->setItemTransientStateValue(d->mIndex, "expanded", false);
@@ -28,12 +28,16 @@
 #include <hbdataformviewitem.h>
 #include <hbdataformmodelitem.h>
 #include "hbdatagroup_p.h"
+#include "hbdataform_p.h"
 #include <hbdataform.h>
 #include "hblistlayout_p.h"
 #include "hbmodeliterator.h"
 
 #include <QCoreApplication>
 #include <QGraphicsScene>
+#include <qmath.h>
+
+const int CreateMoreItemsEvent = QEvent::registerEventType();
 
 class HbDataItemContainerPrivate: public HbAbstractItemContainerPrivate
 {
@@ -44,16 +48,66 @@ public:
 
     virtual ~HbDataItemContainerPrivate();
 
+    int neededItemCount() const;
+    void requestMoreItems();
+
+    bool mMoreItemsRequested;
 };
 
 HbDataItemContainerPrivate::HbDataItemContainerPrivate() :
-    HbAbstractItemContainerPrivate()
+    HbAbstractItemContainerPrivate(),
+    mMoreItemsRequested(false)
 {
 }
 
 HbDataItemContainerPrivate::~HbDataItemContainerPrivate()
 {
 }
+
+/*
+    View items are created only for the beginning of the form, down to one view
+    height below the visible area. Returns the item count needed for that. The
+    items are never removed because of scrolling, so the count is never less
+    than the current one.
+*/
+int HbDataItemContainerPrivate::neededItemCount() const
+{
+    Q_Q(const HbDataItemContainer);
+
+    int itemCount = mItems.count();
+    if (itemCount == 0) {
+        return mBufferSize;
+    }
+
+    qreal viewHeight = mItemView->size().height();
+    qreal shortfall = 2 * viewHeight - itemBoundingRect(mItems.last()).bottom();
+    if (shortfall <= 0) {
+        return itemCount;
+    }
+
+    int moreItems = mBufferSize;
+    qreal averageItemHeight = q->layout()->effectiveSizeHint(Qt::PreferredSize).height() / itemCount;
+    if (averageItemHeight > 0) {
+        moreItems = qMax(moreItems, qCeil(shortfall / averageItemHeight));
+    }
+    return itemCount + moreItems;
+}
+
+/*
+    Creates more items from the event loop, if the items don't reach far enough
+    below the visible area.
+*/
+void HbDataItemContainerPrivate::requestMoreItems()
+{
+    Q_Q(HbDataItemContainer);
+
+    if (!mMoreItemsRequested
+        && mItemView
+        && mItems.count() < q->maxItemCount()) {
+        mMoreItemsRequested = true;
+        QCoreApplication::postEvent(q, new QEvent(QEvent::Type(CreateMoreItemsEvent)));
+    }
+}
 HbDataItemContainer::HbDataItemContainer(QGraphicsItem *parent) :
     HbAbstractItemContainer(*new HbDataItemContainerPrivate, parent),
     mLayout(0),
@@ -89,7 +143,7 @@ void HbDataItemContainer::setFormHeading(HbWidget *headingWidget)
 
 void HbDataItemContainer::reset()
 {
-    Q_D(HbAbstractItemContainer);
+    Q_D(HbDataItemContainer);
     removeItems();
 
     HbDataForm *form = static_cast<HbDataForm*>(itemView());
@@ -111,6 +165,19 @@ void HbDataItemContainer::reset()
         }
     }
     d->updateItemBuffer();
+
+    // The form pages further down may not have items yet, but they need to be
+    // in the page combo box anyway.
+    int rowCount = form->model()->rowCount();
+    for (int row = 0; row < rowCount; ++row) {
+        QModelIndex pageIndex = form->model()->index(row, 0);
+        if (pageIndex.data(HbDataFormModelItem::ItemTypeRole).toInt() == HbDataFormModelItem::FormPageItem
+            && !itemByIndex(pageIndex)) {
+            HbDataFormPrivate::d_ptr(form)->addFormPage(
+                pageIndex.data(HbDataFormModelItem::LabelRole).toString());
+        }
+    }
+    d->requestMoreItems();
 }
 
 /*!
@@ -142,43 +209,101 @@ void HbDataItemContainer::itemRemoved( HbAbstractViewItem *item, bool animate )
 */
 void HbDataItemContainer::viewResized(const QSizeF &viewSize)
 {
+    Q_D(HbDataItemContainer);
     mLayout->setMinimumWidth(viewSize.width());
     mLayout->activate();
+    d->requestMoreItems();
 }
 
+/*!
+    Updates the items following \a startIndex after it has been expanded or collapsed.
+
+    The items always cover the beginning of the form, so the items of an expanded
+    item are created only as far as the buffer reaches. The rest are created when
+    they are scrolled near.
+*/
 void HbDataItemContainer::setModelIndexes(const QModelIndex &startIndex )
 {
-   Q_D(HbAbstractItemContainer);
+    Q_D(HbDataItemContainer);
 
-   QModelIndex index = startIndex;
+    QModelIndex index = startIndex;
     if (!index.isValid() && !d->mItems.isEmpty()) {
         index = d->mItems.first()->modelIndex();
     }
     if (!d->mItemView) {
         return;
     }
-    int targetCount = maxItemCount();
+    HbModelIterator *modelIterator = d->mItemView->modelIterator();
     HbAbstractViewItem *startItem = d->mItemView->itemByIndex(index);
+    if (!startItem && index.isValid()) {
+        // Nothing after the start index has been created yet
+        d->requestMoreItems();
+        return;
+    }
+
+    int pos = d->mItems.indexOf(startItem) + 1;
+    QModelIndex nextIndex = modelIterator->nextIndex(index);
 
-    int startItemIndex = d->mItems.indexOf(startItem);
-    if (d->mItems.count() < targetCount) {
-        // New items needs to be added.
-        while (d->mItems.count() < targetCount) {       
-            index = d->mItemView->modelIterator()->nextIndex(index);
-            if (!index.isValid()) {
+    // When the start index was collapsed, its children are followed by the item of the next index
+    int nextPos = -1;
+    if (nextIndex.isValid()) {
+        for (int i = pos; i < d->mItems.count(); ++i) {
+            if (d->mItems.at(i)->modelIndex() == nextIndex) {
+                nextPos = i;
                 break;
-            }              
-            insertItem(startItemIndex + 1, index);
-            startItemIndex++;
+            }
         }
-        
-    } else if(d->mItems.count() > targetCount) {
-        while (d->mItems.count() > targetCount) {
-            HbAbstractViewItem *nextItem = d->mItems.takeAt(startItemIndex + 1);
-            delete nextItem;
-            nextItem = 0;            
+    }
+    if (nextPos >= 0) {
+        while (nextPos > pos) {
+            d->deleteItem(d->mItems.at(--nextPos));
+        }
+    } else {
+        // Insert the items for the children of the expanded start index. They can take
+        // the place of the items after them, which get pushed out of the buffer.
+        int itemCount = d->mItems.count();
+        int targetCount = qMax(maxItemCount(), itemCount + (itemCount - pos) + d->mBufferSize);
+        while (nextIndex.isValid()
+               && d->mItems.count() < targetCount
+               && (pos >= d->mItems.count() || d->mItems.at(pos)->modelIndex() != nextIndex)) {
+            insertItem(pos, nextIndex);
+            ++pos;
+            nextIndex = modelIterator->nextIndex(nextIndex);
+        }
+        if (pos < d->mItems.count()
+            && (!nextIndex.isValid() || d->mItems.at(pos)->modelIndex() != nextIndex)) {
+            // The buffer ran full before reaching the following items. They would not
+            // be contiguous with the rest, so they are created again when needed.
+            while (d->mItems.count() > pos) {
+                d->deleteItem(d->mItems.last());
+            }
         }
     }
+    d->requestMoreItems();
+}
+
+/*!
+    Creates the items down to \a index, for example to scroll to it.
+*/
+void HbDataItemContainer::createItemsUntil(const QModelIndex &index)
+{
+    Q_D(HbDataItemContainer);
+
+    if (!d->mItemView || !index.isValid() || itemByIndex(index)) {
+        return;
+    }
+
+    QModelIndex nextIndex;
+    if (!d->mItems.isEmpty()) {
+        nextIndex = d->mItems.last()->modelIndex();
+    }
+    do {
+        nextIndex = d->mItemView->modelIterator()->nextIndex(nextIndex);
+        if (!nextIndex.isValid()) {
+            break;
+        }
+        insertItem(d->mItems.count(), nextIndex);
+    } while (nextIndex != index);
 }
 
 HbAbstractViewItem *HbDataItemContainer::createDefaultPrototype() const
@@ -186,6 +311,54 @@ HbAbstractViewItem *HbDataItemContainer::createDefaultPrototype() const
     return new HbDataFormViewItem();
 }
 
+/*!
+    \reimp
+
+    The view items are different kinds of widgets, so they are not recycled. Instead
+    they are created only when they come near the visible area.
+*/
+int HbDataItemContainer::maxItemCount() const
+{
+    Q_D(const HbDataItemContainer);
+
+    int targetCount = HbAbstractItemContainer::maxItemCount();
+    if (targetCount > 0) {
+        targetCount = qMin(targetCount, d->neededItemCount());
+    }
+    return targetCount;
+}
+
+/*!
+    \reimp
+*/
+bool HbDataItemContainer::event(QEvent *e)
+{
+    if (e->type() == CreateMoreItemsEvent) {
+        Q_D(HbDataItemContainer);
+        d->mMoreItemsRequested = false;
+        int itemCount = d->mItems.count();
+        d->updateItemBuffer();
+        if (d->mItems.count() > itemCount) {
+            // The new items may still not reach far enough
+            d->requestMoreItems();
+        }
+        return true;
+    }
+    return HbAbstractItemContainer::event(e);
+}
+
+/*!
+    \reimp
+*/
+QVariant HbDataItemContainer::itemChange(GraphicsItemChange change, const QVariant &value)
+{
+    if (change == QGraphicsItem::ItemPositionHasChanged) {
+        Q_D(HbDataItemContainer);
+        d->requestMoreItems();
+    }
+    return HbAbstractItemContainer::itemChange(change, value);
+}
+
 /*!
     \reimp
 
@@ -46,14 +46,19 @@ public:
 
     virtual void resizeContainer();
 
+    void createItemsUntil(const QModelIndex &index);
+
 protected:
     virtual void itemAdded(int index, HbAbstractViewItem *item, bool animate = false);
     virtual void itemRemoved(HbAbstractViewItem *item, bool animate = false);
     virtual void viewResized(const QSizeF &size);
     virtual void setModelIndexes(const QModelIndex &startIndex = QModelIndex());
     virtual HbAbstractViewItem *createDefaultPrototype() const;
+    virtual int maxItemCount() const;
 
     virtual QSizeF sizeHint(Qt::SizeHint which, const QSizeF &constraint) const;
+    virtual bool event(QEvent *e);
+    QVariant itemChange(GraphicsItemChange change, const QVariant &value);
 private:
     Q_DECLARE_PRIVATE_D(d_ptr, HbDataItemContainer)
     Q_DISABLE_COPY(HbDataItemContainer)
@@ -1613,6 +1613,9 @@ void HbAbstractEdit::setSmileysEnabled(bool enabled)
     Q_D(HbAbstractEdit);
     if(d->smileysEnabled != enabled) {
         d->smileysEnabled = enabled;
+        if (d->smileyEngine) {
+            d->smileyEngine->setEditRescanEnabled(enabled);
+        }
         HbEditorInterface editorInterface(this);
         if(enabled) {
             editorInterface.setSmileyTheme(d->smileyEngineInstance()->theme());
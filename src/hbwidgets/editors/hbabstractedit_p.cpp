@@ -1321,6 +1321,7 @@ HbSmileyEngine* HbAbstractEditPrivate::smileyEngineInstance() const
     if(smileyEngine == 0) {
         smileyEngine = new HbSmileyEngine(const_cast <HbAbstractEdit*>(q));
         smileyEngine->setDocument(doc);
+        smileyEngine->setEditRescanEnabled(smileysEnabled);
 
         HbEditorInterface editorInterface(const_cast<HbAbstractEdit*>(q));
 
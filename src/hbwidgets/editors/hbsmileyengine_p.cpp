@@ -28,6 +28,7 @@
 #include <hbiconanimator.h>
 #include <hbicon.h>
 #include <QTextDocument>
+#include <QTextBlock>
 #include <QFontMetricsF>
 #include <QChar>
 #include <QPainter>
@@ -81,9 +82,110 @@ void HbIconTextObject::drawObject(QPainter *painter, const QRectF &rect,
     painter->setTransform(matrix);
 }
 
+HbSmileyMatcher::HbSmileyMatcher()
+    : mMaxLength(0)
+{
+}
+
+/*
+    Builds an Aho-Corasick automaton from the given patterns, so that all the
+    patterns of a smiley theme are matched in a single pass over the text.
+*/
+void HbSmileyMatcher::build(const QStringList &patterns)
+{
+    mNodes.clear();
+    mNodes.append(Node());
+    mMaxLength = 0;
+
+    foreach (const QString &pattern, patterns) {
+        if (pattern.isEmpty()) {
+            continue;
+        }
+        int node = 0;
+        for (int i = 0; i < pattern.length(); ++i) {
+            ushort c = pattern.at(i).unicode();
+            int child = mNodes.at(node).next.value(c, -1);
+            if (child < 0) {
+                child = mNodes.count();
+                mNodes.append(Node());
+                mNodes[node].next.insert(c, child);
+            }
+            node = child;
+        }
+        mNodes[node].length = pattern.length();
+        mMaxLength = qMax(mMaxLength, pattern.length());
+    }
+
+    // Breadth-first pass for the failure and output links.
+    QList<int> queue;
+    queue << 0;
+    while (!queue.isEmpty()) {
+        int node = queue.takeFirst();
+        QHash<ushort, int>::const_iterator it = mNodes.at(node).next.constBegin();
+        for (; it != mNodes.at(node).next.constEnd(); ++it) {
+            ushort c = it.key();
+            int child = it.value();
+            int fail = 0;
+            if (node) {
+                fail = mNodes.at(node).fail;
+                while (fail && !mNodes.at(fail).next.contains(c)) {
+                    fail = mNodes.at(fail).fail;
+                }
+                fail = mNodes.at(fail).next.value(c, 0);
+            }
+            mNodes[child].fail = fail;
+            mNodes[child].output = mNodes.at(fail).length ? fail : mNodes.at(fail).output;
+            queue << child;
+        }
+    }
+}
+
+/*
+    Finds the leftmost, longest pattern occurrence in \a text starting at or
+    after \a from. This is the match QRegExp gives for the alternation of
+    all patterns.
+*/
+bool HbSmileyMatcher::find(const QString &text, int from, int *start, int *length) const
+{
+    int bestStart = -1;
+    int bestLength = 0;
+    int state = 0;
+
+    for (int i = from; i < text.length(); ++i) {
+        if (bestStart >= 0 && i - mMaxLength + 1 > bestStart) {
+            // No later match can start at or before the one found.
+            break;
+        }
+        ushort c = text.at(i).unicode();
+        while (state && !mNodes.at(state).next.contains(c)) {
+            state = mNodes.at(state).fail;
+        }
+        state = mNodes.at(state).next.value(c, 0);
+
+        int match = mNodes.at(state).length ? state : mNodes.at(state).output;
+        for (; match > 0; match = mNodes.at(match).output) {
+            int matchLength = mNodes.at(match).length;
+            int matchStart = i - matchLength + 1;
+            if (bestStart < 0 || matchStart < bestStart
+                || (matchStart == bestStart && matchLength > bestLength)) {
+                bestStart = matchStart;
+                bestLength = matchLength;
+            }
+        }
+    }
+
+    if (bestStart < 0) {
+        return false;
+    }
+    *start = bestStart;
+    *length = bestLength;
+    return true;
+}
+
 HbSmileyEnginePrivate::HbSmileyEnginePrivate()
     :mDocument(0),
      mEdited(true),
+     mEditRescan(false),
      mIconTextObject(new HbIconTextObject),
      mScaleFactor(1)
 {
@@ -122,6 +224,7 @@ void HbSmileyEnginePrivate::cleanUp()
     mAnimatorToCursors.clear();
     mCursorToAnimator.clear();
     mSmileyAnimator.clear();
+    mCursors.clear();
 }
 
 void HbSmileyEnginePrivate::setDocument(QTextDocument *doc)
@@ -154,26 +257,110 @@ void HbSmileyEnginePrivate::insertSmiley( QTextCursor cursor, const QString& nam
     tmpCursor->setPosition(tmpCursor->position()-1);
     mAnimatorToCursors[animator] << tmpCursor;
     mCursorToAnimator[tmpCursor] = animator;
+    mCursors.insert(lowerBound(tmpCursor->position()), tmpCursor);
 }
 
 void HbSmileyEnginePrivate::insertSmileys( QTextCursor cursor, bool insertOne)
 {
-    QTextCursor initialCursor = cursor;
+    insertSmileys(cursor.isNull() ? 0 : cursor.selectionEnd(), -1, insertOne);
+}
+
+/*
+    Replaces the smiley patterns in the blocks between document positions
+    \a from and \a to with smileys. A negative \a to scans to the end of
+    the document.
+*/
+void HbSmileyEnginePrivate::insertSmileys(int from, int to, bool insertOne)
+{
+    const HbSmileyMatcher &smileyMatcher = matcher();
+    if (smileyMatcher.isEmpty()) {
+        return;
+    }
+
+    QTextCursor initialCursor(mDocument);
     initialCursor.beginEditBlock();
 
-    const QRegExp &rx = mSmileyTheme.regExp();
+    bool done = false;
+    QTextBlock block = mDocument->findBlock(from);
+    while (!done && block.isValid() && (to < 0 || block.position() <= to)) {
+        const QString text = block.text();
+        const int blockPosition = block.position();
+        int offset = qMax(0, from - blockPosition);
+        int shift = 0;
+        int start;
+        int length;
+
+        while (smileyMatcher.find(text, offset, &start, &length)) {
+            QTextCursor cursor(mDocument);
+            cursor.setPosition(blockPosition + start - shift);
+            cursor.setPosition(blockPosition + start - shift + length, QTextCursor::KeepAnchor);
+            insertSmiley(cursor, mSmileyTheme.smiley(text.mid(start, length)));
+            if (insertOne) {
+                done = true;
+                break;
+            }
+            // Each pattern collapses into a single replacement character.
+            shift += length - 1;
+            offset = start + length;
+        }
 
-    cursor = mDocument->find(rx, cursor);
-    while ( !cursor.isNull()){
-        insertSmiley(cursor, mSmileyTheme.smiley(cursor.selectedText()));
-        if (insertOne) {
-            break;
+        if (to >= 0) {
+            to -= shift;
         }
-        cursor = mDocument->find(rx, cursor);
+        block = block.next();
     }
     initialCursor.endEditBlock();
 }
 
+/*
+    Returns the matcher for the current theme. The automaton is rebuilt only
+    when the patterns of the theme change.
+*/
+const HbSmileyMatcher &HbSmileyEnginePrivate::matcher()
+{
+    const QString key = mSmileyTheme.regExp().pattern();
+    if (key != mMatcherKey) {
+        mMatcher.build(mSmileyTheme.patterns());
+        mMatcherKey = key;
+    }
+    return mMatcher;
+}
+
+/*
+    Returns the index of the first smiley cursor at or after \a position.
+*/
+int HbSmileyEnginePrivate::lowerBound(int position) const
+{
+    int low = 0;
+    int high = mCursors.count();
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (mCursors.at(mid)->position() < position) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/*
+    Drops a smiley whose replacement character has been removed from the
+    document. The caller removes the cursor from mCursors.
+*/
+void HbSmileyEnginePrivate::removeSmiley(QTextCursor *cursor)
+{
+    HbIconAnimator *animator = mCursorToAnimator.take(cursor);
+    QList<QTextCursor*> &cursorList = mAnimatorToCursors[animator];
+    cursorList.removeOne(cursor);
+    if (!cursorList.count()) {
+        mAnimatorToCursors.remove(animator);
+        mSmileyAnimator.remove(mSmileyAnimator.key(animator));
+        animator->deleteLater();
+    }
+    delete cursor;
+}
+
 
 HbIconAnimator* HbSmileyEnginePrivate::lookupAnimator(const QString& name)
 {
@@ -254,26 +441,29 @@ void HbSmileyEnginePrivate::_q_animationProgressed()
 
 void HbSmileyEnginePrivate::_q_documentContentsChanged(int position, int charsRemoved, int charsAdded)
 {
-    Q_UNUSED(position);
-    Q_UNUSED(charsRemoved);
-    Q_UNUSED(charsAdded);
-
-    if(charsRemoved > 0 && mEdited) {
-        foreach (QTextCursor* cursor, mCursorToAnimator.keys()) {          
+    if (!mEdited) {
+        return;
+    }
+    int end = position + charsAdded;
+    if(charsRemoved > 0) {
+        // Cursors of removed smileys collapse into the edited range, so only
+        // the cursors within it need to be validated.
+        int i = lowerBound(position);
+        while (i < mCursors.count() && mCursors.at(i)->position() <= end) {
+            QTextCursor *cursor = mCursors.at(i);
             if (!isCursorValid(cursor)) {
-                HbIconAnimator * animator = mCursorToAnimator.value(cursor);
-                mCursorToAnimator.remove(cursor);
-                QList<QTextCursor*> & cursorList = mAnimatorToCursors[animator];
-                cursorList.removeFirst();
-                if (!cursorList.count()) {
-                    mAnimatorToCursors.remove(animator);
-                    mSmileyAnimator.remove(mSmileyAnimator.key(animator));
-                    animator->deleteLater();
-                }
-                delete cursor;
+                mCursors.removeAt(i);
+                removeSmiley(cursor);
+            } else {
+                ++i;
             }
         }
     }
+    if (mEditRescan) {
+        // A pattern may have been completed or joined by the edit, so the
+        // edited blocks are scanned from their beginning.
+        insertSmileys(mDocument->findBlock(position).position(), end, false);
+    }
 }
 
 
@@ -344,6 +534,16 @@ QString HbSmileyEngine::toHtml() const
     return htmlString;
 }
 
+/*
+    Sets whether the smiley patterns are replaced also when the document is edited.
+    Only the blocks touched by an edit are scanned. It is disabled by default.
+*/
+void HbSmileyEngine::setEditRescanEnabled(bool enabled)
+{
+    Q_D(HbSmileyEngine);
+    d->mEditRescan = enabled;
+}
+
 void HbSmileyEngine::setSmileyScaleFactor(qreal scaleFactor)
 {
     Q_D(HbSmileyEngine);
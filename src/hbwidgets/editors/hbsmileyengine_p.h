@@ -53,6 +53,7 @@ public:
     void setSmileyScaleFactor(qreal scaleFactor);
     qreal smileyScaleFactor() const;
     void updateSmileys(QList<QTextCursor*> cursors);
+    void setEditRescanEnabled(bool enabled);
 
 public slots:
     void insertSmileys();
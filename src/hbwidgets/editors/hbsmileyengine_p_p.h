@@ -31,6 +31,8 @@
 #include <QTextObjectInterface>
 #include <QObject>
 #include <QPair>
+#include <QHash>
+#include <QVector>
 
 class HbIconAnimator;
 QT_FORWARD_DECLARE_CLASS(QTextDocument)
@@ -58,6 +60,28 @@ public:
                     int posInDocument, const QTextFormat &format);
 };
 
+class HB_AUTOTEST_EXPORT HbSmileyMatcher
+{
+public:
+    HbSmileyMatcher();
+
+    void build(const QStringList &patterns);
+    bool isEmpty() const { return mNodes.count() <= 1; }
+    bool find(const QString &text, int from, int *start, int *length) const;
+
+private:
+    struct Node {
+        Node() : fail(0), output(-1), length(0) {}
+        QHash<ushort, int> next;
+        int fail;
+        int output;
+        int length;
+    };
+
+    QVector<Node> mNodes;
+    int mMaxLength;
+};
+
 class HbSmileyEnginePrivate
 {
     Q_DECLARE_PUBLIC(HbSmileyEngine)
@@ -70,6 +94,10 @@ public:
     void setDocument(QTextDocument *doc);
     void insertSmiley( QTextCursor cursor, const QString& name);
     void insertSmileys( QTextCursor cursor, bool insertOne = false);
+    void insertSmileys(int from, int to, bool insertOne);
+    const HbSmileyMatcher &matcher();
+    int lowerBound(int position) const;
+    void removeSmiley(QTextCursor *cursor);
     HbIconAnimator* lookupAnimator(const QString& name);
     bool isCursorValid(QTextCursor* cursor) const;
 
@@ -85,6 +113,7 @@ public:
     QTextDocument *mDocument;
     HbSmileyTheme mSmileyTheme;
     bool mEdited;
+    bool mEditRescan;
     QObject *mIconTextObject;
     qreal mScaleFactor;
 
@@ -93,6 +122,13 @@ public:
     QHash<QTextCursor*,HbIconAnimator*> mCursorToAnimator;
     QHash<QString, HbIconAnimator*> mSmileyAnimator;
 
+    // Smiley cursors in document order. Cursors never cross each other when
+    // the document is edited, so the list stays sorted by position.
+    QList<QTextCursor*> mCursors;
+
+    HbSmileyMatcher mMatcher;
+    QString mMatcherKey;
+
     static HbSmileyTheme mDefaultTheme;
 };
 
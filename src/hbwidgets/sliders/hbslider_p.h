@@ -36,6 +36,10 @@ class QGraphicsItem;
 class HbSliderTickmarksLabel;
 class HbSliderTickmarks;
 
+// With more ticks than this, HbSliderTickmarks and HbSliderTickmarksLabel paint the
+// ticks and labels themselves instead of creating one primitive for each of them.
+const int HbSliderMaxTickPrimitives = 20;
+
 struct ItemPrimitive
 {
     QGraphicsItem* item;
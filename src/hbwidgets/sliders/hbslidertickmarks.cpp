@@ -27,6 +27,8 @@
 #include "hbwidget_p.h"
 #include "hbsliderhandle_p.h"
 #include "hbslider_p.h"
+#include "hbiconitem_p.h"
+#include "hbicon_p.h"
 #include <hbstyle.h>
 #include <hbstyleoptionslider_p.h>
 #include <hbapplication.h>
@@ -36,6 +38,8 @@
 #include <QGraphicsItem>
 #include <QGraphicsSceneEvent>
 #include <QGraphicsScene>
+#include <QStyleOptionGraphicsItem>
+#include <QPainter>
 
 
 #ifdef HB_EFFECTS
@@ -51,6 +55,9 @@ class HbSliderTickmarksPrivate : public HbWidgetPrivate
 
 public:
     HbSliderTickmarksPrivate();
+    void updateTickIcons();
+    void paintTickIcons(QPainter *painter, const QRectF &exposedRect,
+                        const HbIcon &icon, QGraphicsWidget *item, const QList<QRectF> &rects);
     QList<QGraphicsWidget *> tickmarkmajorIcons;
     QList<QGraphicsWidget *> tickmarkminorIcons;
     HbSlider *slider;
@@ -60,6 +67,11 @@ public:
     qreal majorTickHeight;
     qreal minorTickHeight;
     Qt::Orientation sliderOrientation;
+    bool paintTicks;
+    HbIcon majorTickIcon;
+    HbIcon minorTickIcon;
+    QList<QRectF> majorTickRects;
+    QList<QRectF> minorTickRects;
 };
 
 
@@ -71,11 +83,54 @@ HbSliderTickmarksPrivate::HbSliderTickmarksPrivate() :
     minorTickWidth(0),
     majorTickHeight(0),
     minorTickHeight(0),
-    sliderOrientation(Qt::Vertical)
- 
+    sliderOrientation(Qt::Vertical),
+    paintTicks(false)
 {
 }
 
+/*
+    Takes the icons for painting the ticks from the hidden primitives, which
+    get the icon names and colors from the theme.
+*/
+void HbSliderTickmarksPrivate::updateTickIcons()
+{
+    Q_Q(HbSliderTickmarks);
+    HbStyleOptionSlider opt;
+    q->initStyleOption(&opt);
+    opt.orientation = slider->orientation();
+    if (!tickmarkmajorIcons.isEmpty()) {
+        HbIconItem *iconItem = static_cast<HbIconItem *>(tickmarkmajorIcons.first());
+        HbStylePrivate::updatePrimitive(iconItem, HbStylePrivate::P_SliderTickMark_majoricon, &opt);
+        majorTickIcon = iconItem->icon();
+        majorTickIcon.setSize(QSizeF(majorTickWidth, majorTickHeight));
+        HbIconPrivate::d_ptr_detached(&majorTickIcon)->setThemedColor(HbIconItemPrivate::d_ptr(iconItem)->mThemedColor);
+    }
+    if (!tickmarkminorIcons.isEmpty()) {
+        // Minor ticks are laid out with the major tick size, as the primitives are.
+        HbIconItem *iconItem = static_cast<HbIconItem *>(tickmarkminorIcons.first());
+        HbStylePrivate::updatePrimitive(iconItem, HbStylePrivate::P_SliderTickMark_minoricon, &opt);
+        minorTickIcon = iconItem->icon();
+        minorTickIcon.setSize(QSizeF(majorTickWidth, majorTickHeight));
+        HbIconPrivate::d_ptr_detached(&minorTickIcon)->setThemedColor(HbIconItemPrivate::d_ptr(iconItem)->mThemedColor);
+    }
+}
+
+void HbSliderTickmarksPrivate::paintTickIcons(QPainter *painter, const QRectF &exposedRect,
+                                              const HbIcon &icon, QGraphicsWidget *item,
+                                              const QList<QRectF> &rects)
+{
+    if (icon.isNull()) {
+        return;
+    }
+    HbIconItem *iconItem = static_cast<HbIconItem *>(item);
+    foreach (const QRectF &rect, rects) {
+        if (rect.intersects(exposedRect)) {
+            icon.paint(painter, rect, Qt::IgnoreAspectRatio, Qt::AlignCenter,
+                       iconItem->mode(), iconItem->state());
+        }
+    }
+}
+
 void  HbSliderTickmarks::createTicks(  )
 {
     Q_D ( HbSliderTickmarks );
@@ -83,22 +138,13 @@ void  HbSliderTickmarks::createTicks(  )
     int maximum =d->slider->maximum();
     int majorTickInterval = d->slider->majorTickInterval ( );
     int minorTickInterval =d-> slider->minorTickInterval ( );
+    int totalMajorTicks = 0;
+    int totalMinorTicks = 0;
     if (majorTickInterval) {
-        int totalMajorTicks = ((maximum-minimum)/majorTickInterval)+1;
-        int majorIconListLength =  d->tickmarkmajorIcons.length();
-        for (int i=majorIconListLength;i<totalMajorTicks;i++) {
-            QGraphicsItem *iconItem =HbStylePrivate::createPrimitive(HbStylePrivate::P_SliderTickMark_majoricon, this);
-            Q_ASSERT(iconItem->isWidget());
-            d->tickmarkmajorIcons.append(static_cast<QGraphicsWidget *>(iconItem));//add newly defind primitive
-        }
-        while ( totalMajorTicks < d->tickmarkmajorIcons.length() ) {
-            QGraphicsWidget *iconItem = d->tickmarkmajorIcons.at(totalMajorTicks);
-            d->tickmarkmajorIcons.removeAll(iconItem);
-            delete iconItem;
-        }
+        totalMajorTicks = ((maximum-minimum)/majorTickInterval)+1;
     }
     if ( minorTickInterval > 0) {
-        int totalMinorTicks = ((maximum-minimum)/minorTickInterval)+1;
+        totalMinorTicks = ((maximum-minimum)/minorTickInterval)+1;
         if ( majorTickInterval ) {
             int maximumMinorTicks = totalMinorTicks;
             for (int i=0;i< maximumMinorTicks;i++ ) {
@@ -107,24 +153,46 @@ void  HbSliderTickmarks::createTicks(  )
                 }
             }
         }
-        int minorIconListLength =  d->tickmarkminorIcons.length();
-        for (int i=minorIconListLength;i<totalMinorTicks;i++) {
-            QGraphicsItem *iconItem = HbStylePrivate::createPrimitive(HbStylePrivate::P_SliderTickMark_minoricon, this);
+    }
+
+    // With many ticks they are painted by this item. One hidden primitive of each
+    // type is still kept, so that the theme applies to the painted ticks.
+    d->paintTicks = (totalMajorTicks + totalMinorTicks > HbSliderMaxTickPrimitives);
+    if (d->paintTicks) {
+        totalMajorTicks = qMin(totalMajorTicks, 1);
+        totalMinorTicks = qMin(totalMinorTicks, 1);
+    } else {
+        d->majorTickRects.clear();
+        d->minorTickRects.clear();
+    }
+
+    if (majorTickInterval) {
+        int majorIconListLength =  d->tickmarkmajorIcons.length();
+        for (int i=majorIconListLength;i<totalMajorTicks;i++) {
+            QGraphicsItem *iconItem =HbStylePrivate::createPrimitive(HbStylePrivate::P_SliderTickMark_majoricon, this);
             Q_ASSERT(iconItem->isWidget());
-            d->tickmarkminorIcons.append(static_cast<QGraphicsWidget *>(iconItem));//add newly defind primitive
-        }
-        while (totalMinorTicks < d->tickmarkminorIcons.length() ){
-            QGraphicsWidget *iconItem = d->tickmarkminorIcons.at(totalMinorTicks);
-            d->tickmarkminorIcons.removeAll(iconItem);
-            delete iconItem;
+            d->tickmarkmajorIcons.append(static_cast<QGraphicsWidget *>(iconItem));//add newly defind primitive
         }
-    } else {
-        while (d->tickmarkminorIcons.length() > 0 ){
-            QGraphicsWidget *iconItem = d->tickmarkminorIcons.at(0);
-            d->tickmarkminorIcons.removeAll(iconItem);
+        while ( totalMajorTicks < d->tickmarkmajorIcons.length() ) {
+            QGraphicsWidget *iconItem = d->tickmarkmajorIcons.at(totalMajorTicks);
+            d->tickmarkmajorIcons.removeAll(iconItem);
             delete iconItem;
         }
     }
+    int minorIconListLength =  d->tickmarkminorIcons.length();
+    for (int i=minorIconListLength;i<totalMinorTicks;i++) {
+        QGraphicsItem *iconItem = HbStylePrivate::createPrimitive(HbStylePrivate::P_SliderTickMark_minoricon, this);
+        Q_ASSERT(iconItem->isWidget());
+        d->tickmarkminorIcons.append(static_cast<QGraphicsWidget *>(iconItem));//add newly defind primitive
+    }
+    while (totalMinorTicks < d->tickmarkminorIcons.length() ){
+        QGraphicsWidget *iconItem = d->tickmarkminorIcons.at(totalMinorTicks);
+        d->tickmarkminorIcons.removeAll(iconItem);
+        delete iconItem;
+    }
+    foreach (QGraphicsWidget *iconItem, d->tickmarkmajorIcons + d->tickmarkminorIcons) {
+        iconItem->setVisible(!d->paintTicks);
+    }
     setProperty("state", "normal"); 
 }
 
@@ -153,6 +221,8 @@ HbSliderTickmarks::HbSliderTickmarks(HbSlider *parent)
     d->slider = parent;
     createTicks();
     d->sliderOrientation = d->slider->orientation( );
+    // paint() only draws the ticks inside the exposed rectangle
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
 }
 
 /*!
@@ -192,14 +262,14 @@ void HbSliderTickmarks::updateTicks( )
         span = boundingRect().height();
         span-=handleSize.height();
     }
+    if (d->paintTicks) {
+        d->updateTickIcons();
+        d->majorTickRects.clear();
+        d->minorTickRects.clear();
+    }
     if (majorTickInterval) {
         int totalMajorTicks = ((maximum-minimum)/majorTickInterval)+1;
         for (int i=0;i<totalMajorTicks;i++) {
-             QGraphicsWidget *iconItem = d->tickmarkmajorIcons.at ( i);
-             HbStyleOptionSlider opt;
-             initStyleOption(&opt);
-             opt.orientation = d->slider->orientation();
-             HbStylePrivate::updatePrimitive(iconItem,HbStylePrivate::P_SliderTickMark_majoricon,&opt);
             int pos = QStyle::sliderPositionFromValue( minimum, maximum,
                 minimum+majorTickInterval*i,static_cast<int>( span ), rtlLayout );
 
@@ -210,7 +280,17 @@ void HbSliderTickmarks::updateTicks( )
             } else {
                 correctedPosY = handleSize.height()/2+pos;
             }
-            iconItem->setGeometry (QRectF( correctedPosX,correctedPosY ,d->majorTickWidth,d->majorTickHeight));
+            QRectF tickRect( correctedPosX,correctedPosY ,d->majorTickWidth,d->majorTickHeight);
+            if (d->paintTicks) {
+                d->majorTickRects.append(tickRect);
+                continue;
+            }
+            QGraphicsWidget *iconItem = d->tickmarkmajorIcons.at ( i);
+            HbStyleOptionSlider opt;
+            initStyleOption(&opt);
+            opt.orientation = d->slider->orientation();
+            HbStylePrivate::updatePrimitive(iconItem,HbStylePrivate::P_SliderTickMark_majoricon,&opt);
+            iconItem->setGeometry (tickRect);
             iconItem->update();
         }
     }
@@ -223,12 +303,6 @@ void HbSliderTickmarks::updateTicks( )
                     continue;
                 }
             }
-            QGraphicsWidget *iconItem = d->tickmarkminorIcons.at ( minorIndex);
-            minorIndex++;
-            HbStyleOptionSlider opt;
-            initStyleOption(&opt);
-            opt.orientation = d->slider->orientation();
-            HbStylePrivate::updatePrimitive(iconItem,HbStylePrivate::P_SliderTickMark_minoricon,&opt);
             int pos = QStyle::sliderPositionFromValue( minimum, maximum,
                 minimum+minorTickInterval*i,static_cast<int>( span ), rtlLayout );
             qreal correctedPosX = 0;
@@ -239,13 +313,44 @@ void HbSliderTickmarks::updateTicks( )
             } else {
                 correctedPosY = handleSize.height()/2+pos;
             }
-            iconItem->setGeometry (QRectF( correctedPosX,correctedPosY ,d->majorTickWidth,d->majorTickHeight));
+            QRectF tickRect( correctedPosX,correctedPosY ,d->majorTickWidth,d->majorTickHeight);
+            if (d->paintTicks) {
+                d->minorTickRects.append(tickRect);
+                continue;
+            }
+            QGraphicsWidget *iconItem = d->tickmarkminorIcons.at ( minorIndex);
+            minorIndex++;
+            HbStyleOptionSlider opt;
+            initStyleOption(&opt);
+            opt.orientation = d->slider->orientation();
+            HbStylePrivate::updatePrimitive(iconItem,HbStylePrivate::P_SliderTickMark_minoricon,&opt);
+            iconItem->setGeometry (tickRect);
             iconItem->update();
         }
     }
     update(boundingRect());
  }
 
+/*!
+    Paints the ticks when there are too many of them for a primitive each.
+*/
+void HbSliderTickmarks::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_D(HbSliderTickmarks);
+    HbWidget::paint(painter, option, widget);
+    if (!d->paintTicks) {
+        return;
+    }
+    if (!d->tickmarkmajorIcons.isEmpty()) {
+        d->paintTickIcons(painter, option->exposedRect, d->majorTickIcon,
+                          d->tickmarkmajorIcons.first(), d->majorTickRects);
+    }
+    if (!d->tickmarkminorIcons.isEmpty()) {
+        d->paintTickIcons(painter, option->exposedRect, d->minorTickIcon,
+                          d->tickmarkminorIcons.first(), d->minorTickRects);
+    }
+}
+
 /* !
     Sets the position of current tick
 */
@@ -296,6 +401,11 @@ void HbSliderTickmarks::polish( HbStyleParameters& params )
         HbWidget::polish(params);
         //updateTicks();
     }
+    if (d->paintTicks) {
+        // The theme may have changed the tick colors.
+        d->updateTickIcons();
+        update();
+    }
 }
 
  //end of file
@@ -48,6 +48,7 @@ public:
     void setTickPosition(Hb::SliderTickPositions position);
     virtual QVariant itemChange(GraphicsItemChange change, const QVariant &value);  
     void createTicks( );
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = 0);
 
 
 protected:
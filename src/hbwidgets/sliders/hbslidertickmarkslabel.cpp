@@ -37,6 +37,9 @@
 #include <QStringList>
 #include <QEvent>
 #include <QGraphicsItem>
+#include <QStyleOptionGraphicsItem>
+#include <QTextLayout>
+#include <QPainter>
 
 
 class HbSliderTickmarksLabelPrivate : public HbWidgetPrivate
@@ -45,12 +48,22 @@ class HbSliderTickmarksLabelPrivate : public HbWidgetPrivate
 
 public:
     HbSliderTickmarksLabelPrivate();
+    ~HbSliderTickmarksLabelPrivate();
     void createTickLabels( );
+    void clearLabelLayouts();
+    QTextLayout *createLabelLayout(const QString &text, const QRectF &rect, QGraphicsWidget *item) const;
+    void paintLabelLayouts(QPainter *painter, const QRectF &exposedRect,
+                           const QList<QTextLayout *> &layouts, QGraphicsWidget *item) const;
     QList<QGraphicsWidget *> tickmarkmajorIconItemsLabel;
     QList<QGraphicsWidget *> tickmarkminorIconItemsLabel;
     HbSlider *slider;
     Hb::SliderTickPositions tickPosition;
     bool createText;
+    bool paintLabels;
+    int majorLabelCount;
+    int minorLabelCount;
+    QList<QTextLayout *> majorLabelLayouts;
+    QList<QTextLayout *> minorLabelLayouts;
 };
 
 
@@ -58,10 +71,81 @@ HbSliderTickmarksLabelPrivate::HbSliderTickmarksLabelPrivate()  :
     HbWidgetPrivate(),
     slider(0),
     tickPosition(Hb::NoSliderTicks),
-    createText(true)
+    createText(true),
+    paintLabels(false),
+    majorLabelCount(0),
+    minorLabelCount(0)
 {
 }
 
+HbSliderTickmarksLabelPrivate::~HbSliderTickmarksLabelPrivate()
+{
+    clearLabelLayouts();
+}
+
+void HbSliderTickmarksLabelPrivate::clearLabelLayouts()
+{
+    qDeleteAll(majorLabelLayouts);
+    majorLabelLayouts.clear();
+    qDeleteAll(minorLabelLayouts);
+    minorLabelLayouts.clear();
+}
+
+/*
+    Lays out a label painted by the widget itself, with the font and alignment
+    the theme gives to the hidden label primitive \a item.
+*/
+QTextLayout *HbSliderTickmarksLabelPrivate::createLabelLayout(const QString &text, const QRectF &rect,
+                                                              QGraphicsWidget *item) const
+{
+    Q_Q(const HbSliderTickmarksLabel);
+    HbTextItem *textItem = static_cast<HbTextItem *>(item);
+    QFont font = textItem->font();
+    QFontMetricsF metrics(font);
+
+    QTextLayout *layout = new QTextLayout(metrics.elidedText(text, Qt::ElideRight, rect.width()), font);
+    QTextOption textOption;
+    textOption.setWrapMode(QTextOption::NoWrap);
+    textOption.setTextDirection(q->layoutDirection());
+    layout->setTextOption(textOption);
+    layout->beginLayout();
+    QTextLine line = layout->createLine();
+    layout->endLayout();
+    if (!line.isValid()) {
+        return layout;
+    }
+
+    Qt::Alignment alignment = QStyle::visualAlignment(q->layoutDirection(), textItem->alignment());
+    QPointF position(rect.left(), rect.top());
+    if (alignment & Qt::AlignHCenter) {
+        position.rx() += (rect.width() - line.naturalTextWidth()) / 2;
+    } else if (alignment & Qt::AlignRight) {
+        position.rx() += rect.width() - line.naturalTextWidth();
+    }
+    if (alignment & Qt::AlignVCenter) {
+        position.ry() += (rect.height() - line.height()) / 2;
+    } else if (alignment & Qt::AlignBottom) {
+        position.ry() += rect.height() - line.height();
+    }
+    line.setPosition(QPointF());
+    layout->setPosition(position);
+    return layout;
+}
+
+void HbSliderTickmarksLabelPrivate::paintLabelLayouts(QPainter *painter, const QRectF &exposedRect,
+                                                      const QList<QTextLayout *> &layouts,
+                                                      QGraphicsWidget *item) const
+{
+    painter->save();
+    painter->setPen(static_cast<HbTextItem *>(item)->textColor());
+    foreach (QTextLayout *layout, layouts) {
+        if (layout->boundingRect().translated(layout->position()).intersects(exposedRect)) {
+            layout->draw(painter, QPointF());
+        }
+    }
+    painter->restore();
+}
+
 
 void  HbSliderTickmarksLabelPrivate::createTickLabels(  )
 {
@@ -77,57 +161,70 @@ void  HbSliderTickmarksLabelPrivate::createTickLabels(  )
     QStringList minorLabelList = slider->minorTickLabels( );
     int majorTickInterval = slider->majorTickInterval ( );
     int minorTickInterval = slider->minorTickInterval ( );
+    majorLabelCount = 0;
+    minorLabelCount = 0;
     if (majorTickInterval) {
-        int totalMajorTicksLabel = ((maximum-minimum)/majorTickInterval)+1;
-        if (majorLabelList.length( ) < totalMajorTicksLabel ) {
-            totalMajorTicksLabel = majorLabelList.length( );
-        }
-        int majorLabelListLength =  tickmarkmajorIconItemsLabel.length();
-        for (int i=majorLabelListLength;i<totalMajorTicksLabel;i++) {
-            QGraphicsItem *textItem = HbStylePrivate::createPrimitive(HbStylePrivate::P_SliderTickMark_majorlabel, q);
-            textItemCreated = true;
-            Q_ASSERT(textItem->isWidget());
-            tickmarkmajorIconItemsLabel.append(static_cast<QGraphicsWidget *>(textItem));//add newly defind primitive
-        }
-        while ( totalMajorTicksLabel < tickmarkmajorIconItemsLabel.length() ) {
-            QGraphicsWidget *textItem = tickmarkmajorIconItemsLabel.at(totalMajorTicksLabel);
-            tickmarkmajorIconItemsLabel.removeAll(textItem);
-            delete textItem;
+        majorLabelCount = ((maximum-minimum)/majorTickInterval)+1;
+        if (majorLabelList.length( ) < majorLabelCount ) {
+            majorLabelCount = majorLabelList.length( );
         }
     }
     if ( minorTickInterval > 0) {
-        int totalMinorTicksLabel = ((maximum-minimum)/minorTickInterval)+1;
+        minorLabelCount = ((maximum-minimum)/minorTickInterval)+1;
         if ( majorTickInterval ) {
-            int maximumMinorTicksLabel = totalMinorTicksLabel;
+            int maximumMinorTicksLabel = minorLabelCount;
             for (int i=0;i< maximumMinorTicksLabel;i++ ) {
                 if ((i*minorTickInterval)%majorTickInterval==0) {
-                    totalMinorTicksLabel--;
+                    minorLabelCount--;
                 }
             }
         }
-        if (minorLabelList.length( ) < totalMinorTicksLabel ) {
-            totalMinorTicksLabel = minorLabelList.length( );
+        if (minorLabelList.length( ) < minorLabelCount ) {
+            minorLabelCount = minorLabelList.length( );
         }
+    }
+
+    // With many labels they are painted by the widget. One hidden primitive of each
+    // type is still kept, so that the theme applies to the painted labels.
+    paintLabels = (majorLabelCount + minorLabelCount > HbSliderMaxTickPrimitives);
+    int totalMajorTicksLabel = majorLabelCount;
+    int totalMinorTicksLabel = minorLabelCount;
+    if (paintLabels) {
+        totalMajorTicksLabel = qMin(totalMajorTicksLabel, 1);
+        totalMinorTicksLabel = qMin(totalMinorTicksLabel, 1);
+    } else {
+        clearLabelLayouts();
+    }
 
-        int minorIconLabelListLength =  tickmarkminorIconItemsLabel.length();
-        for (int i=minorIconLabelListLength;i<totalMinorTicksLabel;i++) {
-            QGraphicsItem *textItem = HbStylePrivate::createPrimitive(HbStylePrivate::P_SliderTickMark_minorlabel, q);
+    if (majorTickInterval) {
+        int majorLabelListLength =  tickmarkmajorIconItemsLabel.length();
+        for (int i=majorLabelListLength;i<totalMajorTicksLabel;i++) {
+            QGraphicsItem *textItem = HbStylePrivate::createPrimitive(HbStylePrivate::P_SliderTickMark_majorlabel, q);
             textItemCreated = true;
             Q_ASSERT(textItem->isWidget());
-            tickmarkminorIconItemsLabel.append(static_cast<QGraphicsWidget *>(textItem));//add newly defind primitive
-        }
-        while (totalMinorTicksLabel < tickmarkminorIconItemsLabel.length() ){
-            QGraphicsWidget *textItem = tickmarkminorIconItemsLabel.at(totalMinorTicksLabel);
-            tickmarkminorIconItemsLabel.removeAll(textItem);
-            delete textItem;
+            tickmarkmajorIconItemsLabel.append(static_cast<QGraphicsWidget *>(textItem));//add newly defind primitive
         }
-    }else {
-        while (tickmarkminorIconItemsLabel.length() > 0){
-            QGraphicsWidget *textItem = tickmarkminorIconItemsLabel.at(0);
-            tickmarkminorIconItemsLabel.removeAll(textItem);
+        while ( totalMajorTicksLabel < tickmarkmajorIconItemsLabel.length() ) {
+            QGraphicsWidget *textItem = tickmarkmajorIconItemsLabel.at(totalMajorTicksLabel);
+            tickmarkmajorIconItemsLabel.removeAll(textItem);
             delete textItem;
         }
     }
+    int minorIconLabelListLength =  tickmarkminorIconItemsLabel.length();
+    for (int i=minorIconLabelListLength;i<totalMinorTicksLabel;i++) {
+        QGraphicsItem *textItem = HbStylePrivate::createPrimitive(HbStylePrivate::P_SliderTickMark_minorlabel, q);
+        textItemCreated = true;
+        Q_ASSERT(textItem->isWidget());
+        tickmarkminorIconItemsLabel.append(static_cast<QGraphicsWidget *>(textItem));//add newly defind primitive
+    }
+    while (totalMinorTicksLabel < tickmarkminorIconItemsLabel.length() ){
+        QGraphicsWidget *textItem = tickmarkminorIconItemsLabel.at(totalMinorTicksLabel);
+        tickmarkminorIconItemsLabel.removeAll(textItem);
+        delete textItem;
+    }
+    foreach (QGraphicsWidget *textItem, tickmarkmajorIconItemsLabel + tickmarkminorIconItemsLabel) {
+        textItem->setVisible(!paintLabels);
+    }
     q->setProperty("state","normal");
     if( textItemCreated ) {
        q->repolish();
@@ -148,6 +245,7 @@ void HbSliderTickmarksLabel::updateTickLabels( )
         return;
     }
     d->createTickLabels();
+    d->clearLabelLayouts();
     int totalMajorTicksLabel = d->tickmarkmajorIconItemsLabel.length();
     for (int i=0;i<totalMajorTicksLabel;i++) {
          QGraphicsWidget *textItem = d->tickmarkmajorIconItemsLabel.at ( i);
@@ -191,28 +289,39 @@ void HbSliderTickmarksLabel::updateTickLabels( )
     qreal totalMinorTextWidth = abs(firstMinorIntervalPos-minPos);
 
     if (majorTickInterval) {
-        int totalMajorTicksLabel = d->tickmarkmajorIconItemsLabel.length();
-        for (int i=0;i<totalMajorTicksLabel;i++) {
-             QGraphicsWidget *textItem = d->tickmarkmajorIconItemsLabel.at ( i);
+        for (int i=0;i<d->majorLabelCount;i++) {
+             QGraphicsWidget *textItem = d->tickmarkmajorIconItemsLabel.at ( d->paintLabels ? 0 : i);
+             // A painted label is as high as the primitive would be with its text.
+             qreal tickHeight = d->paintLabels
+                 ? textItem->effectiveSizeHint(Qt::PreferredSize).height()
+                 : textItem->boundingRect().size().height();
              int pos = QStyle::sliderPositionFromValue( minimum, maximum,
                 minimum+majorTickInterval*i,static_cast<int>( span ), rtlLayout );
 
+             QRectF labelRect;
              if ( d->slider->orientation() == Qt::Horizontal) {
-                textItem->update();
                 qreal correctedPosX = handleSize.width()/2+pos;
                 qreal tickWidth = totalMajorTextWidth;
                 correctedPosX -= tickWidth/2;
                 qreal correctedPosY = 0;
-                qreal tickHeight = textItem->boundingRect().size().height();
-                textItem->setGeometry( QRectF(correctedPosX,correctedPosY,tickWidth,tickHeight));
+                labelRect = QRectF(correctedPosX,correctedPosY,tickWidth,tickHeight);
             } else {
                 qreal correctedPosY = handleSize.height()/2+pos;
-                qreal tickHeight = textItem->boundingRect().size().height();
                 correctedPosY-=tickHeight/2;
                 qreal correctedPosX =0;
                 qreal tickWidth = boundingRect().width();
-                textItem->setGeometry ( QRectF(correctedPosX,correctedPosY,tickWidth,tickHeight ));
-                textItem->setLayoutDirection (layoutDirection());
+                labelRect = QRectF(correctedPosX,correctedPosY,tickWidth,tickHeight );
+            }
+            if (d->paintLabels) {
+                d->majorLabelLayouts.append(d->createLabelLayout(
+                    d->slider->majorTickLabels().at(i), labelRect, textItem));
+            } else {
+                if ( d->slider->orientation() == Qt::Horizontal) {
+                    textItem->update();
+                } else {
+                    textItem->setLayoutDirection (layoutDirection());
+                }
+                textItem->setGeometry( labelRect );
             }
         }
     }
@@ -225,41 +334,72 @@ void HbSliderTickmarksLabel::updateTickLabels( )
                     continue;
                 }
             }
-            if ( minorIndex >= d->tickmarkminorIconItemsLabel.length() ) {
+            if ( minorIndex >= d->minorLabelCount ) {
                 continue;
             } else {
-                QGraphicsWidget *textItem = d->tickmarkminorIconItemsLabel.at ( minorIndex);
+                QGraphicsWidget *textItem = d->tickmarkminorIconItemsLabel.at ( d->paintLabels ? 0 : minorIndex);
                 HbStyleOptionSlider opt;
                 initStyleOption(&opt);
                 opt.orientation = d->slider->orientation();
                 opt.text = (d->slider->minorTickLabels( )).at(minorIndex);
-                HbStylePrivate::updatePrimitive(textItem,HbStylePrivate::P_SliderTickMark_minorlabel,&opt);
+                if (!d->paintLabels || minorIndex == 0) {
+                    HbStylePrivate::updatePrimitive(textItem,HbStylePrivate::P_SliderTickMark_minorlabel,&opt);
+                }
                 minorIndex++;
+                qreal tickHeight = d->paintLabels
+                    ? textItem->effectiveSizeHint(Qt::PreferredSize).height()
+                    : textItem->boundingRect().size().height();
                 int pos = QStyle::sliderPositionFromValue( minimum, maximum,
                     minimum+minorTickInterval*i,static_cast<int>( span ), rtlLayout );
+                QRectF labelRect;
                  if ( d->slider->orientation() == Qt::Horizontal) {
                     qreal correctedPosX = handleSize.width()/2+pos; 
                     correctedPosX -= totalMinorTextWidth/2;
                     qreal correctedPosY = 0;
-                    qreal tickHeight = textItem->boundingRect().size().height();
-                    textItem->setGeometry( QRectF(correctedPosX,correctedPosY,totalMinorTextWidth,tickHeight));
- 
+                    labelRect = QRectF(correctedPosX,correctedPosY,totalMinorTextWidth,tickHeight);
                 } else {
                     qreal correctedPosY = handleSize.height()/2+pos;
-                    qreal tickHeight = textItem->boundingRect().size().height();
                     correctedPosY-=tickHeight/2;
-                    textItem->setLayoutDirection (layoutDirection());
                     qreal correctedPosX =0;
                     qreal tickWidth = boundingRect().width();
-                    textItem->setGeometry ( QRectF(correctedPosX,correctedPosY,tickWidth,tickHeight ));
-
-  
+                    labelRect = QRectF(correctedPosX,correctedPosY,tickWidth,tickHeight );
+                }
+                if (d->paintLabels) {
+                    d->minorLabelLayouts.append(d->createLabelLayout(opt.text, labelRect, textItem));
+                } else {
+                    if ( d->slider->orientation() == Qt::Vertical) {
+                        textItem->setLayoutDirection (layoutDirection());
+                    }
+                    textItem->setGeometry( labelRect );
                 }
             }
         }
     }
+    if (d->paintLabels) {
+        update();
+    }
  }
 
+/*!
+    Paints the labels when there are too many of them for a primitive each.
+*/
+void HbSliderTickmarksLabel::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_D(HbSliderTickmarksLabel);
+    HbWidget::paint(painter, option, widget);
+    if (!d->paintLabels) {
+        return;
+    }
+    if (!d->tickmarkmajorIconItemsLabel.isEmpty()) {
+        d->paintLabelLayouts(painter, option->exposedRect, d->majorLabelLayouts,
+                             d->tickmarkmajorIconItemsLabel.first());
+    }
+    if (!d->tickmarkminorIconItemsLabel.isEmpty()) {
+        d->paintLabelLayouts(painter, option->exposedRect, d->minorLabelLayouts,
+                             d->tickmarkminorIconItemsLabel.first());
+    }
+}
+
 
 
  void HbSliderTickmarksLabel::setTickPosition(Hb::SliderTickPositions position)
@@ -295,6 +435,8 @@ HbSliderTickmarksLabel::HbSliderTickmarksLabel(HbSlider *parent)
 #if QT_VERSION >= 0x040600
     setFlag(QGraphicsItem::ItemSendsGeometryChanges,true);
 #endif
+    // paint() only draws the labels inside the exposed rectangle
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
 }
 
 /*!
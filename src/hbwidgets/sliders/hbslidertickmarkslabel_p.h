@@ -52,6 +52,7 @@ public:
     void updateTickLabels( );
     void setTickPosition(Hb::SliderTickPositions position);
     virtual bool event ( QEvent * event );
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = 0);
 
 
 
@@ -37,6 +37,112 @@
 #include <QDebug>
 #endif
 
+//////////HbDateTimePickerModel//////////////
+
+HbDateTimePickerModel::HbDateTimePickerModel(HbDateTimePickerPrivate *picker, LocaleFunc localeFunc, QObject *parent)
+    : QAbstractListModel(parent),
+      mPicker(picker),
+      mLocaleFunc(localeFunc),
+      mStart(0),
+      mCount(0),
+      mInterval(1),
+      mCache(64)
+{
+}
+
+int HbDateTimePickerModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : mCount;
+}
+
+QVariant HbDateTimePickerModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= mCount
+        || (role != Qt::DisplayRole && role != Qt::EditRole)) {
+        return QVariant();
+    }
+
+    const int key = value(index.row());
+    if (QString *cached = mCache.object(key)) {
+        return *cached;
+    }
+
+    QString text = (mPicker->*mLocaleFunc)(key);
+#ifdef HB_TEXT_MEASUREMENT_UTILITY
+    if ( mLocaleFunc == &HbDateTimePickerPrivate::localeMonth &&
+         HbTextMeasurementUtility::instance()->locTestMode() ) {
+        text.append(QChar(LOC_TEST_START));
+        text.append("qtl_datetimepicker_popup_month_sec");
+        text.append(QChar(LOC_TEST_END));
+    }
+#endif
+    mCache.insert(key, new QString(text));
+    return text;
+}
+
+/*
+   changes the range to [start, end] with the given step. rows which stay in
+   the range are kept, so the views only see the rows added or removed at
+   either end, like with the string list model used before.
+*/
+void HbDateTimePickerModel::setRange(int start, int end, int interval)
+{
+    if (interval < 1) {
+        interval = 1;
+    }
+    const int newCount = end >= start ? (end - start) / interval + 1 : 0;
+
+    if (!mCount || interval != mInterval || (start - mStart) % interval) {
+        clear();
+        mStart = start;
+        mInterval = interval;
+        if (newCount) {
+            beginInsertRows(QModelIndex(), 0, newCount - 1);
+            mCount = newCount;
+            endInsertRows();
+        }
+        return;
+    }
+
+    if (start < mStart) {
+        const int count = (mStart - start) / interval;
+        beginInsertRows(QModelIndex(), 0, count - 1);
+        mStart = start;
+        mCount += count;
+        endInsertRows();
+    } else if (start > mStart) {
+        const int count = qMin((start - mStart) / interval, mCount);
+        beginRemoveRows(QModelIndex(), 0, count - 1);
+        mCount -= count;
+        mStart = start;
+        endRemoveRows();
+    }
+
+    if (newCount > mCount) {
+        beginInsertRows(QModelIndex(), mCount, newCount - 1);
+        mCount = newCount;
+        endInsertRows();
+    } else if (newCount < mCount) {
+        beginRemoveRows(QModelIndex(), newCount, mCount - 1);
+        mCount = newCount;
+        endRemoveRows();
+    }
+}
+
+/*
+   removes all rows. the formatted strings are dropped as well, because the
+   picker calls this when the display format changes.
+*/
+void HbDateTimePickerModel::clear()
+{
+    mCache.clear();
+    if (mCount) {
+        beginRemoveRows(QModelIndex(), 0, mCount - 1);
+        mCount = 0;
+        endRemoveRows();
+    }
+}
+
 //////////HbDateTimeParser - Implementaion may change in future.//////////////
 
 static inline int countRepeat(const QString &str, int index, int maxCount)
@@ -559,7 +665,7 @@ void HbDateTimePickerPrivate::rearrangeTumbleViews()
             case HbDateTimeParser::DayOfWeekSection:
             if(!mDayPicker) {
                 mDayPicker = new VIEWER(q);
-                mDayModel = static_cast<QStringListModel*>(mDayPicker->model());
+                mDayModel = createModel(mDayPicker, &HbDateTimePickerPrivate::localeDay);
                 mDayPicker->setLoopingEnabled(true);
             }
 
@@ -575,7 +681,7 @@ void HbDateTimePickerPrivate::rearrangeTumbleViews()
             case HbDateTimeParser::MonthSection:
             if(!mMonthPicker) {
                 mMonthPicker = new VIEWER(q);
-                mMonthModel = static_cast<QStringListModel*>(mMonthPicker->model());
+                mMonthModel = createModel(mMonthPicker, &HbDateTimePickerPrivate::localeMonth);
                 mMonthPicker->setLoopingEnabled(true);
             }
 
@@ -592,7 +698,7 @@ void HbDateTimePickerPrivate::rearrangeTumbleViews()
             case HbDateTimeParser::YearSection2Digits:
             if(!mYearPicker) {
                 mYearPicker = new VIEWER(q);
-                mYearModel = static_cast<QStringListModel*>(mYearPicker->model());
+                mYearModel = createModel(mYearPicker, &HbDateTimePickerPrivate::localeYear);
                 mYearPicker->setLoopingEnabled(true);
             }
 
@@ -608,7 +714,7 @@ void HbDateTimePickerPrivate::rearrangeTumbleViews()
             case HbDateTimeParser::SecondSection:
             if(!mSecondPicker) {
                 mSecondPicker = new VIEWER(q);
-                mSecondModel = static_cast<QStringListModel*>(mSecondPicker->model());
+                mSecondModel = createModel(mSecondPicker, &HbDateTimePickerPrivate::localeSecond);
                 mSecondPicker->setLoopingEnabled(true);
             }
 
@@ -624,7 +730,7 @@ void HbDateTimePickerPrivate::rearrangeTumbleViews()
             case HbDateTimeParser::MinuteSection:
             if(!mMinutePicker) {
                 mMinutePicker = new VIEWER(q);
-                mMinuteModel = static_cast<QStringListModel*>(mMinutePicker->model());
+                mMinuteModel = createModel(mMinutePicker, &HbDateTimePickerPrivate::localeMinute);
                 mMinutePicker->setLoopingEnabled(true);
             }
                 if(mLabelMinute.isNull()){
@@ -639,7 +745,7 @@ void HbDateTimePickerPrivate::rearrangeTumbleViews()
             case HbDateTimeParser::Hour24Section:
             if(!mHourPicker) {
                 mHourPicker = new VIEWER(q);
-                mHourModel = static_cast<QStringListModel*>(mHourPicker->model());
+                mHourModel = createModel(mHourPicker, &HbDateTimePickerPrivate::localeHour);
                 mHourPicker->setLoopingEnabled(true);
             }
 
@@ -741,7 +847,7 @@ void HbDateTimePickerPrivate::removeConnections()
 void HbDateTimePickerPrivate::setRanges() 
 {
     //clear all data before inserting
-    if(mYearModel) mYearModel->removeRows(0,mYearModel->rowCount());    
+    if(mYearModel) mYearModel->clear();    
     //insert data
     if(mIsTwoDigitYearFormat) {
         mYearOffset = mMinimumDate.date().year()%100;
@@ -751,23 +857,23 @@ void HbDateTimePickerPrivate::setRanges()
         setYearRange(mMinimumDate.date().year(),mMaximumDate.date().year()); 
     }
 
-    if(mMonthModel) mMonthModel->removeRows(0,mMonthModel->rowCount());
+    if(mMonthModel) mMonthModel->clear();
     mMonthOffset = 1;
     setMonthRange(1,12);//default all months
 
-    if(mDayModel) mDayModel->removeRows(0,mDayModel->rowCount());
+    if(mDayModel) mDayModel->clear();
     mDayOffset = 1;
     setDayRange(1,31);//default all days
 
-    if(mHourModel) mHourModel->removeRows(0,mHourModel->rowCount());
+    if(mHourModel) mHourModel->clear();
     mHourOffset = 0;
     setHourRange(0,23);
 
-    if(mMinuteModel) mMinuteModel->removeRows(0,mMinuteModel->rowCount());
+    if(mMinuteModel) mMinuteModel->clear();
     mMinuteOffset = 0;
     setMinuteRange(0,59);
 
-    if(mSecondModel) mSecondModel->removeRows(0,mSecondModel->rowCount());
+    if(mSecondModel) mSecondModel->clear();
     mSecondOffset = 0;
     setSecondRange(0,59);
 
@@ -941,7 +1047,7 @@ void HbDateTimePickerPrivate::setDateTime(const QDateTime &newDate)
             if(mIntervals[QDateTimeEdit::MinuteSection] > 1){
                 for(int i = 0; i < mMinuteModel->rowCount(); i++){
 
-                    if(mMinuteModel->index(i,0).data().toInt() <= newDateTime.time().minute()){
+                    if(mMinuteModel->value(i) <= newDateTime.time().minute()){
                         index = i;
                     }
                     else{
@@ -1014,9 +1120,7 @@ void HbDateTimePickerPrivate::setYearRange(int start,int end)
 
 
 
-    resizeModel(mYearModel, mYearOffset, 
-                mYearOffset+mYearModel->rowCount()-1, start,
-                end, &HbDateTimePickerPrivate::localeYear);
+    resizeModel(mYearModel, start, end);
 
     mYearOffset = start;
 
@@ -1041,10 +1145,7 @@ void HbDateTimePickerPrivate::setMonthRange(int start,int end)
     if(newIndex > (end-start)) {
         newIndex = end-start;
     }
-    resizeModel(mMonthModel,
-                mMonthOffset,mMonthOffset+mMonthModel->rowCount()-1,
-                start,end,
-                &HbDateTimePickerPrivate::localeMonth);
+    resizeModel(mMonthModel, start, end);
     mMonthOffset = start;
 
     mMonthPicker->setSelected(newIndex);
@@ -1078,10 +1179,7 @@ void HbDateTimePickerPrivate::setDayRange(int start,int end)
         newIndex = end-start;
     }
 
-    resizeModel(mDayModel,
-                mDayOffset,mDayOffset+mDayModel->rowCount()-1,
-                start,end,
-                &HbDateTimePickerPrivate::localeDay);
+    resizeModel(mDayModel, start, end);
     mDayOffset = start;
 
     mDayPicker->setSelected(newIndex);
@@ -1116,10 +1214,7 @@ void HbDateTimePickerPrivate::setHourRange(int start,int end)
         newIndex = end-start;
     }
 
-    resizeModel(mHourModel,
-                mHourOffset,mHourOffset+mHourModel->rowCount()-1,
-                start,end,
-                &HbDateTimePickerPrivate::localeHour);
+    resizeModel(mHourModel, start, end);
     mHourOffset = start;
 
     mHourPicker->setSelected(newIndex);
@@ -1153,10 +1248,7 @@ void HbDateTimePickerPrivate::setMinuteRange(int start,int end)
         newIndex = end-start;
     }
 
-    resizeModel(mMinuteModel, 
-                mMinuteOffset,mMinuteModel->index(mMinuteModel->rowCount() - 1).data().toInt(),
-                start,end,
-                &HbDateTimePickerPrivate::localeMinute,
+    resizeModel(mMinuteModel, start, end,
                 mIntervals[QDateTimeEdit::MinuteSection]);
     mMinuteOffset = start;
 
@@ -1201,10 +1293,7 @@ void HbDateTimePickerPrivate::setSecondRange(int start,int end)
         newIndex = end-start;
     }
 
-    resizeModel(mSecondModel,
-                mSecondOffset,mSecondOffset+mSecondModel->rowCount()-1,
-                start,end,
-                &HbDateTimePickerPrivate::localeSecond);
+    resizeModel(mSecondModel, start, end);
     mSecondOffset = start;
 
     mSecondPicker->setSelected(newIndex);
@@ -1286,16 +1375,22 @@ QString HbDateTimePickerPrivate::localeAmPm(bool isAm)
 }
 
 
-/* there are seven different models for seven pickers. insertion and removal
-   to each of the models to resize them its the same logic. but to populate the
-   data need the appropriate locale and format converted data. which is passed
-   as a function pointer instead of creating seven different QStringListModel derived
-   model classes with one interface/virtual function specialization.
+/* the six numeric pickers share one model class. the model only holds the
+   range, the display strings are produced by the locale function of the
+   picker when a row is shown.
 */
-void HbDateTimePickerPrivate::resizeModel(QStringListModel *model,
-                                          int oldStart, int oldEnd,
-                                          int newStart, int newEnd,
-                                          QString (HbDateTimePickerPrivate::*localeFunc)(int), int interval)
+HbDateTimePickerModel *HbDateTimePickerPrivate::createModel(VIEWER *picker,
+                                                            HbDateTimePickerModel::LocaleFunc localeFunc)
+{
+    QAbstractItemModel *defaultModel = picker->model();
+    HbDateTimePickerModel *model = new HbDateTimePickerModel(this, localeFunc, picker);
+    picker->setModel(model);
+    delete defaultModel;
+    return model;
+}
+
+void HbDateTimePickerPrivate::resizeModel(HbDateTimePickerModel *model,
+                                          int newStart, int newEnd, int interval)
 {
     class ConnectionRemover {
     public:
@@ -1310,132 +1405,10 @@ void HbDateTimePickerPrivate::resizeModel(QStringListModel *model,
     }Obj(this);
 
 #ifdef HBDATETIMEPICKER_DEBUG
-    qDebug() << "resizeModel: oldStart=" << oldStart
-            << " oldEnd=" << oldEnd << " newStart="
-            << newStart << " newEnd=" << newEnd
+    qDebug() << "resizeModel: newStart=" << newStart << " newEnd=" << newEnd
             << " interval=" << interval;
 #endif
-    bool b1=false,b2=false;
-    int oldinterval=model->rowCount()>1 ? (model->index(1,0).data().toInt(&b1)-model->index(0,0).data().toInt(&b2)):0;
-#ifdef HBDATETIMEPICKER_DEBUG
-    qDebug() << "resizeModel:sameoldInterval=" << oldinterval;
-#endif
-    if(b1 && b2 && (oldinterval == interval) && (newStart == oldStart)) {
-        if(newEnd>oldEnd) {
-            int rowCount=model->rowCount();
-#ifdef HBDATETIMEPICKER_DEBUG
-            qDebug() << "resizeModel:sameinserting(" << rowCount << "," <<(newEnd-oldEnd)/interval << ")";
-#endif
-            model->insertRows(rowCount,(newEnd-oldEnd)/interval);
-            for(int i=0;i<((newEnd-oldEnd)/interval);++i) {
-                QModelIndex index=model->index(i+rowCount,0);
-                if(index.isValid()) {
-                    model->setData(index,(this->*localeFunc)(((i+1)*interval)+oldEnd));
-#ifdef HBDATETIMEPICKER_DEBUG
-                    qDebug() << "resizeModel:samesetData(" << ((i+1)*interval)+oldEnd << "," << (this->*localeFunc)((i+1)*interval+oldEnd) << ")";
-#endif
-                }
-            }
-        }
-        if(oldEnd>newEnd) {
-            //if the start offset is preset more items can fit at end
-            int stay=((newEnd-newStart)/interval)+1;
-            int count=model->rowCount()-stay;
-#ifdef HBDATETIMEPICKER_DEBUG
-            qDebug() << "resizeModel:removing(" <<model->rowCount()-count << "," << count << ")"
-                    << " data=" << model->index((model->rowCount()-count),0).data().toString();
-#endif
-            model->removeRows((model->rowCount()-count),count);
-        }
-        return;//optimizing inserts when interval is set
-    } else {
-        if(b1 && b2) {
-            model->removeRows(0,model->rowCount());
-            oldStart = oldEnd = 0;
-        }
-    }
-
-    if((model->rowCount() == 0) && (newEnd-newStart>=0)) {
-#ifdef HBDATETIMEPICKER_DEBUG
-        qDebug() << "resizeModel:default addition inserting(0," << (newEnd-newStart+1)/interval << ")";
-#endif
-
-        model->insertRows(0,((newEnd-newStart)/interval)+1);
-        for(int i=0;i<=((newEnd-newStart)/interval);++i) {
-            QString text=(this->*localeFunc)((i*interval)+newStart);
-#ifdef HB_TEXT_MEASUREMENT_UTILITY
-            if ( localeFunc == &HbDateTimePickerPrivate::localeMonth &&
-                 HbTextMeasurementUtility::instance()->locTestMode() ) {
-                text.append(QChar(LOC_TEST_START));
-                text.append("qtl_datetimepicker_popup_month_sec");
-                text.append(QChar(LOC_TEST_END));
-            }
-#endif
-            QModelIndex index=model->index(i,0);
-            if(index.isValid()) {
-                model->setData(index,text);
-#ifdef HBDATETIMEPICKER_DEBUG
-                qDebug() << "resizeModel:setData(" << i << "," << text << ")";
-#endif
-            }
-        }
-        return;
-    }
-
-    if(newStart<oldStart) {
-#ifdef HBDATETIMEPICKER_DEBUG
-        qDebug() << "resizeModel:inserting(0," << (oldStart-newStart)/interval << ")";
-#endif
-        model->insertRows(0,(oldStart-newStart)/interval);
-        for(int i=0;i<((oldStart-newStart)/interval);++i) {
-            QModelIndex index=model->index(i,0);
-            if(index.isValid()) {
-                model->setData(index,(this->*localeFunc)((i*interval)+newStart));
-#ifdef HBDATETIMEPICKER_DEBUG
-                qDebug() << "resizeModel:setData(" << i << "," << (this->*localeFunc)((i*interval)+newStart) << ")";
-#endif
-            }
-        }
-    }
-
-    if(newEnd>oldEnd) {
-        int rowCount=model->rowCount();
-#ifdef HBDATETIMEPICKER_DEBUG
-        qDebug() << "resizeModel:inserting(" << rowCount << "," <<(newEnd-oldEnd)/interval << ")";
-#endif
-        model->insertRows(rowCount,(newEnd-oldEnd)/interval);
-        for(int i=0;i<((newEnd-oldEnd)/interval);++i) {
-            QModelIndex index=model->index(i+rowCount,0);
-            if(index.isValid()) {
-                model->setData(index,(this->*localeFunc)(((i+1)*interval)+oldEnd));
-#ifdef HBDATETIMEPICKER_DEBUG
-                qDebug() << "resizeModel:setData(" << i << "," << (this->*localeFunc)((i+1)*interval+oldEnd) << ")";
-#endif
-            }
-        }
-    }
-    if(newStart>oldStart) {
-#ifdef HBDATETIMEPICKER_DEBUG
-        qDebug() << "resizeModel:removing(0," << (newStart-oldStart)/interval << ")"
-                << " data=" << model->index((newStart-oldStart)/interval,0).data().toString();
-#endif
-        model->removeRows(0,(newStart-oldStart)/interval);
-    }
-
-    if(oldEnd>newEnd) {
-        //#ifdef HBDATETIMEPICKER_DEBUG
-        //            qDebug() << "resizeModel:removing(" <<model->rowCount()-((oldEnd-newEnd)/interval)<<"," << (oldEnd-newEnd)/interval << ")";
-        //#endif
-        //            model->removeRows((model->rowCount()-((oldEnd-newEnd)/interval)),(oldEnd-newEnd)/interval);
-        //if the start offset is preset more items can fit at end
-        int stay=((newEnd-newStart)/interval)+1;
-        int count=model->rowCount()-stay;
-#ifdef HBDATETIMEPICKER_DEBUG
-        qDebug() << "resizeModel:removing(" <<model->rowCount()-count << "," << count << ")"
-                << " data=" << model->index((model->rowCount()-count),0).data().toString();
-#endif
-        model->removeRows((model->rowCount()-count),count);
-    }
+    model->setRange(newStart, newEnd, interval);
 }  
 
 
@@ -32,6 +32,8 @@
 #include "hbextendedlocale.h"
 
 #include <QStringListModel>
+#include <QAbstractListModel>
+#include <QCache>
 #include <QGraphicsGridLayout>
 #include <QDateTime>
 #include <QGraphicsWidget>
@@ -110,6 +112,36 @@ public:
 
 ///////////////////////HbDatePickerViewLabel//////////////////////////
 
+class HbDateTimePickerPrivate;
+
+/*
+   read-only model for one picker column. the display strings are formatted
+   on demand with the locale function of the picker and cached by value, so
+   setting a range costs nothing until the rows become visible.
+*/
+class HbDateTimePickerModel : public QAbstractListModel
+{
+public:
+    typedef QString (HbDateTimePickerPrivate::*LocaleFunc)(int);
+
+    HbDateTimePickerModel(HbDateTimePickerPrivate *picker, LocaleFunc localeFunc, QObject *parent = 0);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+    int value(int row) const { return mStart + row * mInterval; }
+    void setRange(int start, int end, int interval = 1);
+    void clear();
+
+private:
+    HbDateTimePickerPrivate *mPicker;
+    LocaleFunc mLocaleFunc;
+    int mStart;
+    int mCount;
+    int mInterval;
+    mutable QCache<int, QString> mCache;
+};
+
 class HbDatePickerViewLabel : public HbWidget
 {
     Q_OBJECT
@@ -187,10 +219,9 @@ public:
     QString localeAmPm(bool getAm);
 
     //helper routine
-    void resizeModel(QStringListModel *model,
-        int oldStart, int oldEnd,
-        int newStart, int newEnd,
-        QString (HbDateTimePickerPrivate::*localeFuncPtr)(int), int interval = 1);
+    void resizeModel(HbDateTimePickerModel *model,
+        int newStart, int newEnd, int interval = 1);
+    HbDateTimePickerModel *createModel(VIEWER *picker, HbDateTimePickerModel::LocaleFunc localeFunc);
 
     void createPrimitives();
     void deleteAndNull(VIEWER*& t) {
@@ -218,12 +249,12 @@ public:
     VIEWER *mSecondPicker;
     VIEWER *mAmPmPicker;
 
-    QStringListModel *mDayModel;
-    QStringListModel *mMonthModel;
-    QStringListModel *mYearModel;
-    QStringListModel *mHourModel;
-    QStringListModel *mMinuteModel;
-    QStringListModel *mSecondModel;
+    HbDateTimePickerModel *mDayModel;
+    HbDateTimePickerModel *mMonthModel;
+    HbDateTimePickerModel *mYearModel;
+    HbDateTimePickerModel *mHourModel;
+    HbDateTimePickerModel *mMinuteModel;
+    HbDateTimePickerModel *mSecondModel;
     QStringListModel *mAmPmModel;
 
     int mYearOffset; 
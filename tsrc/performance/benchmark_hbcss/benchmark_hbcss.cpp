@@ -0,0 +1,149 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QGraphicsWidget>
+#include <hbapplication.h>
+#include <hbwidget.h>
+#include <hbcssparser_p.h>
+#include <hbstyleselector_p.h>
+
+using namespace HbCss;
+
+// Synthetic widget classes for the selector matching workload. The names
+// are used as CSS type selectors, so each class gets a stack of its own.
+class BenchmarkBase : public HbWidget
+{
+    Q_OBJECT
+};
+
+class BenchmarkItem : public BenchmarkBase
+{
+    Q_OBJECT
+};
+
+/*
+    Returns a style sheet with \a ruleCount rule sets in the same shape as the
+    theme widget css files: one main rule, a sub-element rule with a pseudo
+    state and an attribute selector, and a child combinator rule. Every tenth
+    rule set targets the benchmark classes, the rest only populate the stacks.
+*/
+static QString syntheticStyleSheet(int ruleCount)
+{
+    QString css;
+    QTextStream stream(&css);
+    for (int i = 0; i < ruleCount; ++i) {
+        QString type;
+        if (i % 10 == 0) {
+            type = (i % 20 == 0) ? QLatin1String("BenchmarkItem") : QLatin1String("BenchmarkBase");
+        } else {
+            type = QString("SyntheticWidget%1").arg(i);
+        }
+        stream << type << " {\n"
+               << "    layout: layout_" << i << ";\n"
+               << "    min-width: " << (i % 50) << "un;\n"
+               << "    text-height: var(hb-param-text-height-primary);\n"
+               << "}\n"
+               << type << "::text:pressed[orientation=\"" << (i % 2) << "\"] {\n"
+               << "    font-variant: primary;\n"
+               << "    fixed-height: expr(var(hb-param-margin-gene-top)+" << (i % 7) << "un);\n"
+               << "}\n"
+               << type << " > " << type << " {\n"
+               << "    top: -var(hb-param-margin-gene-top);\n"
+               << "    color: #" << QString::number(0x100000 + i, 16) << ";\n"
+               << "}\n";
+    }
+    return css;
+}
+
+class BenchmarkHbCss : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parse_data();
+    void parse();
+    void styleRulesForNode_data();
+    void styleRulesForNode();
+};
+
+void BenchmarkHbCss::parse_data()
+{
+    QTest::addColumn<int>("ruleCount");
+    QTest::newRow("50 rule sets") << 50;
+    QTest::newRow("200 rule sets") << 200;
+    QTest::newRow("800 rule sets") << 800;
+}
+
+void BenchmarkHbCss::parse()
+{
+    QFETCH(int, ruleCount);
+    const QString css = syntheticStyleSheet(ruleCount);
+
+    QBENCHMARK {
+        StyleSheet styleSheet;
+        Parser parser;
+        parser.init(css);
+        QVERIFY(parser.parse(&styleSheet));
+    }
+}
+
+void BenchmarkHbCss::styleRulesForNode_data()
+{
+    parse_data();
+}
+
+void BenchmarkHbCss::styleRulesForNode()
+{
+    QFETCH(int, ruleCount);
+
+    StyleSheet *styleSheet = new StyleSheet;
+    Parser parser;
+    parser.init(syntheticStyleSheet(ruleCount));
+    QVERIFY(parser.parse(styleSheet));
+
+    // The selector owns the style sheet from here on.
+    HbStyleSelector selector;
+    selector.addStyleSheet(styleSheet);
+
+    BenchmarkItem parent;
+    BenchmarkItem *item = new BenchmarkItem;
+    item->setParentItem(&parent);
+
+    HbVector<StyleRule> rules;
+    QBENCHMARK {
+        rules = selector.styleRulesForNode(item, Qt::Vertical);
+    }
+    QVERIFY(!rules.isEmpty());
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    BenchmarkHbCss benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "benchmark_hbcss.moc"
@@ -0,0 +1,176 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <hbapplication.h>
+#include <hbmainwindow.h>
+#include <hbview.h>
+#include <hbdataform.h>
+#include <hbdataformmodel.h>
+#include <hbdataformmodelitem.h>
+
+class BenchmarkHbDataForm : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void cleanup();
+    void openForm_data();
+    void openForm();
+    void scrollToEnd_data();
+    void scrollToEnd();
+
+private:
+    void populate(int itemCount);
+    HbDataForm *showForm();
+    void closeForm();
+
+    HbMainWindow *mWindow;
+    HbView *mView;
+    HbDataFormModel *mModel;
+    QModelIndex mGroup;
+    QModelIndex mLastItem;
+};
+
+void BenchmarkHbDataForm::initTestCase()
+{
+    mWindow = new HbMainWindow;
+    mWindow->show();
+    QTest::qWaitForWindowShown(mWindow);
+    mView = 0;
+    mModel = 0;
+}
+
+void BenchmarkHbDataForm::cleanupTestCase()
+{
+    delete mWindow;
+    mWindow = 0;
+}
+
+void BenchmarkHbDataForm::cleanup()
+{
+    delete mModel;
+    mModel = 0;
+}
+
+/*
+    Builds a settings form with one group of \a itemCount items of the
+    common kinds.
+*/
+void BenchmarkHbDataForm::populate(int itemCount)
+{
+    static const HbDataFormModelItem::DataItemType itemTypes[] = {
+        HbDataFormModelItem::TextItem,
+        HbDataFormModelItem::ToggleValueItem,
+        HbDataFormModelItem::SliderItem,
+        HbDataFormModelItem::CheckBoxItem
+    };
+    const int typeCount = sizeof(itemTypes) / sizeof(itemTypes[0]);
+
+    mModel = new HbDataFormModel;
+    HbDataFormModelItem *group = mModel->appendDataFormGroup("Settings");
+    HbDataFormModelItem *item = 0;
+    for (int i = 0; i < itemCount; ++i) {
+        item = mModel->appendDataFormItem(itemTypes[i % typeCount],
+                                          QString("Setting %1").arg(i), group);
+    }
+    mGroup = mModel->indexFromItem(group);
+    mLastItem = mModel->indexFromItem(item);
+}
+
+/*
+    Shows a new form with the group expanded and lets it create the items
+    near the visible area.
+*/
+HbDataForm *BenchmarkHbDataForm::showForm()
+{
+    HbDataForm *form = new HbDataForm;
+    mView = mWindow->addView(form);
+    mWindow->setCurrentView(mView);
+    form->setModel(mModel);
+    form->setExpanded(mGroup, true);
+    QCoreApplication::processEvents();
+    return form;
+}
+
+void BenchmarkHbDataForm::closeForm()
+{
+    mWindow->removeView(mView);
+    delete mView;
+    mView = 0;
+}
+
+void BenchmarkHbDataForm::openForm_data()
+{
+    QTest::addColumn<int>("itemCount");
+
+    // The items are created only near the visible area, so opening the
+    // larger form should cost about the same.
+    QTest::newRow("100 items") << 100;
+    QTest::newRow("1000 items") << 1000;
+}
+
+void BenchmarkHbDataForm::openForm()
+{
+    QFETCH(int, itemCount);
+    populate(itemCount);
+
+    QBENCHMARK {
+        showForm();
+        closeForm();
+    }
+}
+
+void BenchmarkHbDataForm::scrollToEnd_data()
+{
+    openForm_data();
+}
+
+/*
+    Jumps to the last setting, which creates the items down to it.
+*/
+void BenchmarkHbDataForm::scrollToEnd()
+{
+    QFETCH(int, itemCount);
+    populate(itemCount);
+
+    QBENCHMARK {
+        HbDataForm *form = showForm();
+        form->scrollTo(mLastItem);
+        QCoreApplication::processEvents();
+        closeForm();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    BenchmarkHbDataForm benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "benchmark_hbdataform.moc"
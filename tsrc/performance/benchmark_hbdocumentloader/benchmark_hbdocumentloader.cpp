@@ -0,0 +1,137 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QBuffer>
+#include <hbapplication.h>
+#include <hbmainwindow.h>
+#include <hbdocumentloader.h>
+
+/*
+    Returns a docml document with a view holding \a labelCount labels in an
+    anchor layout, each anchored to the view edges and to the previous label.
+*/
+static QByteArray syntheticDocument(int labelCount)
+{
+    QByteArray docml;
+    QTextStream stream(&docml);
+    stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           << "<hbdocument version=\"1.1\">\n"
+           << "    <widget name=\"view\" type=\"HbView\">\n"
+           << "        <widget name=\"content\" role=\"HbView:widget\" type=\"HbWidget\">\n";
+    for (int i = 0; i < labelCount; ++i) {
+        stream << "            <widget name=\"label_" << i << "\" type=\"HbLabel\">\n"
+               << "                <sizehint height=\"4un\" type=\"PREFERRED\" width=\"" << 20 + i % 10 << "un\"/>\n"
+               << "                <string name=\"plainText\" value=\"Label " << i << "\"/>\n"
+               << "            </widget>\n";
+    }
+    stream << "            <layout type=\"anchor\">\n";
+    for (int i = 0; i < labelCount; ++i) {
+        const QString previous = i ? QString("label_%1").arg(i - 1) : QString();
+        stream << "                <anchoritem dst=\"label_" << i << "\" dstEdge=\"LEFT\" spacing=\"1un\" src=\"\" srcEdge=\"LEFT\"/>\n"
+               << "                <anchoritem dst=\"label_" << i << "\" dstEdge=\"RIGHT\" spacing=\"-1un\" src=\"\" srcEdge=\"RIGHT\"/>\n"
+               << "                <anchoritem dst=\"label_" << i << "\" dstEdge=\"TOP\" spacing=\"1un\" src=\""
+               << previous << "\" srcEdge=\"" << (i ? "BOTTOM" : "TOP") << "\"/>\n";
+    }
+    stream << "            </layout>\n"
+           << "        </widget>\n"
+           << "        <string name=\"title\" value=\"Benchmark\"/>\n"
+           << "    </widget>\n"
+           << "</hbdocument>\n";
+    stream.flush();
+    return docml;
+}
+
+class BenchmarkHbDocumentLoader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void load_data();
+    void load();
+
+private:
+    HbMainWindow *mWindow;
+};
+
+void BenchmarkHbDocumentLoader::initTestCase()
+{
+    mWindow = new HbMainWindow;
+}
+
+void BenchmarkHbDocumentLoader::cleanupTestCase()
+{
+    delete mWindow;
+    mWindow = 0;
+}
+
+void BenchmarkHbDocumentLoader::load_data()
+{
+    QTest::addColumn<int>("labelCount");
+    QTest::addColumn<bool>("binary");
+    QTest::newRow("10 labels, text") << 10 << false;
+    QTest::newRow("10 labels, binary") << 10 << true;
+    QTest::newRow("100 labels, text") << 100 << false;
+    QTest::newRow("100 labels, binary") << 100 << true;
+}
+
+void BenchmarkHbDocumentLoader::load()
+{
+    QFETCH(int, labelCount);
+    QFETCH(bool, binary);
+
+    QByteArray document = syntheticDocument(labelCount);
+    if (binary) {
+        QBuffer source(&document);
+        QByteArray converted;
+        QBuffer destination(&converted);
+        source.open(QIODevice::ReadOnly);
+        destination.open(QIODevice::WriteOnly);
+        HbDocumentLoader converter(mWindow);
+        QVERIFY(converter.createBinary(&source, &destination));
+        document = converted;
+    }
+
+    QBENCHMARK {
+        QBuffer buffer(&document);
+        buffer.open(QIODevice::ReadOnly);
+        HbDocumentLoader loader(mWindow);
+        bool ok = false;
+        QObjectList roots = loader.load(&buffer, &ok);
+        QVERIFY(ok);
+        qDeleteAll(roots);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    BenchmarkHbDocumentLoader benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "benchmark_hbdocumentloader.moc"
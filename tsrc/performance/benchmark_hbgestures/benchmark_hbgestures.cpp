@@ -0,0 +1,172 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QMouseEvent>
+#include <hbapplication.h>
+#include <hbpangesture.h>
+#include <hbswipegesture.h>
+#include <hbpangesturelogic_p.h>
+#include <hbswipegesturelogic_p.h>
+
+struct TraceEvent
+{
+    QEvent::Type type;
+    QPoint pos;
+    qint64 time;
+};
+
+typedef QList<TraceEvent> Trace;
+Q_DECLARE_METATYPE(Trace)
+
+static void appendEvent(Trace &trace, QEvent::Type type, const QPointF &pos, qint64 time)
+{
+    TraceEvent event;
+    event.type = type;
+    event.pos = pos.toPoint();
+    event.time = time;
+    trace.append(event);
+}
+
+/*
+    Builds a touch trace of \a strokes presses, each followed by \a moves
+    move events every \a interval milliseconds. \a wobble adds a sideways
+    shake that changes the direction of one axis every few events.
+*/
+static Trace makeTrace(int strokes, int moves, int interval, qreal speed, int wobble)
+{
+    Trace trace;
+    qint64 time = 0;
+    for (int stroke = 0; stroke < strokes; ++stroke) {
+        QPointF pos(180, 320);
+        const qreal direction = stroke % 2 ? -1 : 1;
+        appendEvent(trace, QEvent::MouseButtonPress, pos, time);
+        for (int i = 0; i < moves; ++i) {
+            time += interval;
+            pos.ry() += direction * speed * interval;
+            if (wobble) {
+                pos.rx() = 180 + ((i / 3) % 2 ? wobble : -wobble);
+            }
+            appendEvent(trace, QEvent::MouseMove, pos, time);
+        }
+        time += interval;
+        appendEvent(trace, QEvent::MouseButtonRelease, pos, time);
+        time += 300;
+    }
+    return trace;
+}
+
+// Gesture state as QGestureManager would track it from the recognizer results.
+static Qt::GestureState nextState(Qt::GestureState state, QGestureRecognizer::Result result)
+{
+    switch (result & QGestureRecognizer::ResultState_Mask) {
+    case QGestureRecognizer::TriggerGesture:
+        return state == Qt::NoGesture ? Qt::GestureStarted : Qt::GestureUpdated;
+    case QGestureRecognizer::FinishGesture:
+        return Qt::GestureFinished;
+    case QGestureRecognizer::CancelGesture:
+        return Qt::GestureCanceled;
+    default:
+        return state;
+    }
+}
+
+class BenchmarkHbGestures : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void replay_data();
+    void replay();
+};
+
+void BenchmarkHbGestures::replay_data()
+{
+    QTest::addColumn<Trace>("trace");
+    // Slow list scrolling, fast flicks and a shaking finger, which makes the
+    // point recorders drop their history on every direction change.
+    QTest::newRow("drag") << makeTrace(10, 400, 8, 0.2, 0);
+    QTest::newRow("flick") << makeTrace(200, 12, 8, 3.0, 0);
+    QTest::newRow("wobble") << makeTrace(10, 400, 4, 0.5, 6);
+}
+
+/*
+    Replays the trace through the pan and swipe recognizer logic, which is
+    the per event work of gesture recognition without the event delivery.
+*/
+void BenchmarkHbGestures::replay()
+{
+    QFETCH(Trace, trace);
+
+    QObject watched;
+    HbPanGesture pan;
+    HbSwipeGesture swipe;
+    HbPanGestureLogic panLogic;
+    HbSwipeGestureLogic swipeLogic;
+    int pans = 0;
+    int swipes = 0;
+    qreal speed = 0;
+
+    QBENCHMARK {
+        Qt::GestureState panState = Qt::NoGesture;
+        Qt::GestureState swipeState = Qt::NoGesture;
+        pans = swipes = 0;
+        foreach (const TraceEvent &e, trace) {
+            const Qt::MouseButton button = e.type == QEvent::MouseMove ? Qt::NoButton : Qt::LeftButton;
+            const Qt::MouseButtons buttons = e.type == QEvent::MouseButtonRelease ? Qt::NoButton : Qt::LeftButton;
+            QMouseEvent event(e.type, e.pos, e.pos, button, buttons, Qt::NoModifier);
+
+            panState = nextState(panState, panLogic.recognize(panState, &pan, &watched, &event, e.time));
+            if (panState == Qt::GestureFinished) {
+                speed += pan.velocity().manhattanLength();
+                ++pans;
+            }
+            if (panState == Qt::GestureFinished || panState == Qt::GestureCanceled) {
+                panLogic.resetGesture(&pan);
+                panState = Qt::NoGesture;
+            }
+
+            swipeState = nextState(swipeState, swipeLogic.recognize(swipeState, &swipe, &watched, &event, e.time));
+            if (swipeState == Qt::GestureFinished) {
+                ++swipes;
+            }
+            if (swipeState == Qt::GestureFinished || swipeState == Qt::GestureCanceled) {
+                swipeLogic.resetGesture(&swipe);
+                swipeState = Qt::NoGesture;
+            }
+        }
+    }
+    QVERIFY(pans > 0);
+    qDebug("%d pans, %d swipes, total pan speed %f", pans, swipes, speed);
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    BenchmarkHbGestures benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "benchmark_hbgestures.moc"
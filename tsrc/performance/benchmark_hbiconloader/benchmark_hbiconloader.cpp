@@ -0,0 +1,108 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <hbapplication.h>
+#include <hbiconloader_p.h>
+#include <hbiconimpl_p.h>
+
+class BenchmarkHbIconLoader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void loadIconCold_data();
+    void loadIconCold();
+    void loadIconWarm_data();
+    void loadIconWarm();
+};
+
+void BenchmarkHbIconLoader::loadIconCold_data()
+{
+    QTest::addColumn<QString>("iconName");
+    QTest::newRow("svg") << QString("qtg_mono_settings");
+    QTest::newRow("frame graphics") << QString("qtg_fr_btn_normal_c");
+    QTest::newRow("unknown icon") << QString("benchmark_no_such_icon");
+}
+
+/*
+    Loads the icon in a size that has not been requested before on every
+    iteration, so that neither the local nor the theme server cache can
+    serve the request.
+*/
+void BenchmarkHbIconLoader::loadIconCold()
+{
+    QFETCH(QString, iconName);
+    HbIconLoader *loader = HbIconLoader::global();
+
+    int extent = 16;
+    QBENCHMARK {
+        const QSizeF size(extent, extent);
+        ++extent;
+        HbIconImpl *icon = loader->loadIcon(iconName, HbIconLoader::AnyType,
+                                            HbIconLoader::AnyPurpose, size);
+        if (icon) {
+            loader->unLoadIcon(icon, false, true);
+        }
+    }
+}
+
+void BenchmarkHbIconLoader::loadIconWarm_data()
+{
+    loadIconCold_data();
+}
+
+/*
+    Keeps one reference to the icon loaded for the whole run and loads the
+    same icon again on every iteration, which measures the cache lookup.
+*/
+void BenchmarkHbIconLoader::loadIconWarm()
+{
+    QFETCH(QString, iconName);
+    HbIconLoader *loader = HbIconLoader::global();
+    const QSizeF size(48, 48);
+
+    HbIconImpl *keepAlive = loader->loadIcon(iconName, HbIconLoader::AnyType,
+                                             HbIconLoader::AnyPurpose, size);
+    QBENCHMARK {
+        HbIconImpl *icon = loader->loadIcon(iconName, HbIconLoader::AnyType,
+                                            HbIconLoader::AnyPurpose, size);
+        if (icon) {
+            loader->unLoadIcon(icon);
+        }
+    }
+    if (keepAlive) {
+        loader->unLoadIcon(keepAlive);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    BenchmarkHbIconLoader benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "benchmark_hbiconloader.moc"
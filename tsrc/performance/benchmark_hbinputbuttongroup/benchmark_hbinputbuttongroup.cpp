@@ -0,0 +1,137 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <hbapplication.h>
+#include <hbinputbutton.h>
+#include <hbinputbuttongroup.h>
+#include <hbinputbuttongroup_p.h>
+
+static const QSize groupGrid(10, 4);
+static const QSize groupSize(640, 240);
+static const int tapCount = 1000;
+
+class BenchmarkButtonGroup : public HbInputButtonGroup
+{
+public:
+    explicit BenchmarkButtonGroup(HbInputButtonGroupPrivate *d)
+        : HbInputButtonGroup(*d, groupGrid), d(d)
+    {
+    }
+
+    using HbInputButtonGroup::paint;
+
+    HbInputButtonGroupPrivate *d;
+};
+
+class BenchmarkHbInputButtonGroup : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void taps_data();
+    void taps();
+};
+
+void BenchmarkHbInputButtonGroup::taps_data()
+{
+    QTest::addColumn<bool>("cached");
+
+    // Without the layer every update repaints the whole group, as it did
+    // when press and release updated all of it.
+    QTest::newRow("direct") << false;
+    QTest::newRow("cached") << true;
+}
+
+/*
+    Simulates tapCount taps, each a press and a release followed by the
+    paint the view would do, and reports the paint time per tap.
+*/
+void BenchmarkHbInputButtonGroup::taps()
+{
+    QFETCH(bool, cached);
+
+    BenchmarkButtonGroup group(new HbInputButtonGroupPrivate);
+    QList<HbInputButton *> buttons;
+    for (int i = 0; i < groupGrid.width() * groupGrid.height(); ++i) {
+        HbInputButton *button = new HbInputButton('a' + i, QPoint(i % groupGrid.width(), i / groupGrid.width()));
+        button->setText(QString(QChar('a' + i)), HbInputButton::ButtonTextIndexPrimary);
+        button->setText(QString::number(i % 10), HbInputButton::ButtonTextIndexSecondaryFirstRow);
+        buttons.append(button);
+    }
+    group.setButtons(buttons);
+    group.setGeometry(QRectF(QPointF(0, 0), groupSize));
+
+    QImage image(groupSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(0);
+    QPainter painter(&image);
+    QStyleOptionGraphicsItem option;
+    option.exposedRect = QRectF(QPointF(0, 0), groupSize);
+    group.paint(&painter, &option, 0);
+
+    qint64 paintTime = 0;
+    int taps = 0;
+    QElapsedTimer timer;
+    QBENCHMARK {
+        for (int i = 0; i < tapCount; ++i) {
+            QRectF buttonRect = buttons.at(i % buttons.count())->boundingRect();
+            for (int phase = 0; phase < 2; ++phase) {
+                if (phase == 0) {
+                    group.d->pressEvent(buttonRect.center(), false);
+                } else {
+                    group.d->releaseEvent(buttonRect.center(), false);
+                }
+                timer.start();
+                if (cached) {
+                    option.exposedRect = buttonRect;
+                    painter.setClipRect(buttonRect);
+                    group.paint(&painter, &option, 0);
+                } else {
+                    painter.setClipRect(option.exposedRect);
+                    group.d->paintContent(&painter, QRectF(QPointF(0, 0), groupSize));
+                }
+#if QT_VERSION >= 0x040800
+                paintTime += timer.nsecsElapsed();
+#else
+                paintTime += timer.elapsed() * Q_INT64_C(1000000);
+#endif
+            }
+            ++taps;
+        }
+    }
+
+    qDebug("%d taps, %.1f us paint time per tap", taps, paintTime / 1000.0 / taps);
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    BenchmarkHbInputButtonGroup benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "benchmark_hbinputbuttongroup.moc"
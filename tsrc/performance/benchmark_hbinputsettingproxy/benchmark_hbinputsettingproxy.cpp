@@ -0,0 +1,153 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QProcess>
+#include <stdio.h>
+#include <hbapplication.h>
+#include <hbinputsettingproxy.h>
+#include <hbinputsettingproxy_p.h>
+
+static const char writerOption[] = "-writer";
+// The writer process exits by itself after this long, in case the
+// benchmark does not get to kill it.
+static const int writerLifetime = 120000;
+
+/*
+    Runs in the writer process. Keeps changing the global input language
+    under the lock, as a settings application or the input server would.
+*/
+static int runWriter()
+{
+    HbInputSettingProxyPrivate writer;
+    HbSettingProxyInternalData *prData = writer.proxyData();
+    if (!prData) {
+        return 1;
+    }
+    printf("ready\n");
+    fflush(stdout);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; timer.elapsed() < writerLifetime; ++i) {
+        writer.lock();
+        prData->globalPrimaryInputLanguage = HbInputLanguage(i & 1 ? QLocale::Finnish : QLocale::English);
+        writer.unlock();
+    }
+    return 0;
+}
+
+class BenchmarkHbInputSettingProxy : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void getters_data();
+    void getters();
+
+private:
+    HbInputSettingProxyPrivate *mPrivate;
+};
+
+void BenchmarkHbInputSettingProxy::initTestCase()
+{
+    HbInputSettingProxy::instance();
+    mPrivate = new HbInputSettingProxyPrivate;
+    if (!mPrivate->proxyData()) {
+        QSKIP("The input settings shared memory is not available", SkipAll);
+    }
+}
+
+void BenchmarkHbInputSettingProxy::getters_data()
+{
+    QTest::addColumn<bool>("locked");
+    QTest::addColumn<bool>("concurrentWriter");
+
+    // The locked rows read the way the getters did before the sequence
+    // counter was added.
+    QTest::newRow("locked") << true << false;
+    QTest::newRow("sequence") << false << false;
+    QTest::newRow("locked, concurrent writer") << true << true;
+    QTest::newRow("sequence, concurrent writer") << false << true;
+}
+
+/*
+    Measures 1000 reads of the global input language.
+*/
+void BenchmarkHbInputSettingProxy::getters()
+{
+    QFETCH(bool, locked);
+    QFETCH(bool, concurrentWriter);
+
+    QProcess writer;
+    if (concurrentWriter) {
+        writer.start(QCoreApplication::applicationFilePath(), QStringList() << writerOption);
+        QVERIFY(writer.waitForStarted());
+        QVERIFY(writer.waitForReadyRead());
+    }
+
+    HbInputSettingProxy *proxy = HbInputSettingProxy::instance();
+    HbSettingProxyInternalData *prData = mPrivate->proxyData();
+    HbInputLanguage original = prData->globalPrimaryInputLanguage;
+    int english = 0;
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i) {
+            HbInputLanguage language;
+            if (locked) {
+                mPrivate->lock();
+                language = prData->globalPrimaryInputLanguage;
+                mPrivate->unlock();
+            } else {
+                language = proxy->globalInputLanguage();
+            }
+            if (language.language() == QLocale::English) {
+                ++english;
+            }
+        }
+    }
+
+    if (concurrentWriter) {
+        writer.kill();
+        writer.waitForFinished();
+        // The writer may have been killed in the middle of an update.
+        mPrivate->lock();
+        prData->globalPrimaryInputLanguage = original;
+        mPrivate->unlock();
+    }
+    qDebug("%d reads of English", english);
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    if (app.arguments().contains(writerOption)) {
+        return runWriter();
+    }
+    BenchmarkHbInputSettingProxy benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "benchmark_hbinputsettingproxy.moc"
@@ -0,0 +1,124 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QGraphicsScene>
+#include <QPainter>
+#include <QPixmapCache>
+#include <hbapplication.h>
+#include <hbrichtextitem.h>
+
+static const int itemCount = 500;
+static const QSizeF itemSize(340, 64);
+static const QSize viewportSize(360, 640);
+static const qreal scrollStep = 24;
+
+static const char *const itemTexts[] = {
+    "<b>Meeting</b> with <i>the design team</i> about the new home screen layout",
+    "<font color=\"#3060c0\">Reminder:</font> pick up the parcel before <u>6 pm</u>",
+    "Call back <b>Anna</b> about the <a href=\"x\">holiday plans</a>",
+    "<i>Weather:</i> mostly sunny, <b>22&deg;</b> in the afternoon with light wind",
+    "Flight <b>AY 123</b> departs at 10:45 from <font color=\"#c03030\">gate 32</font>"
+};
+
+class BenchmarkHbRichTextItem : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void scrollList_data();
+    void scrollList();
+
+private:
+    QGraphicsScene mScene;
+    int mDefaultCacheLimit;
+};
+
+/*
+    Builds a list of rich text items, one below the other, in the scene.
+*/
+void BenchmarkHbRichTextItem::initTestCase()
+{
+    mDefaultCacheLimit = QPixmapCache::cacheLimit();
+    const int textCount = sizeof(itemTexts) / sizeof(itemTexts[0]);
+    for (int i = 0; i < itemCount; ++i) {
+        HbRichTextItem *item = new HbRichTextItem(QString::fromLatin1(itemTexts[i % textCount]));
+        item->setTextWrapping(Hb::TextWordWrap);
+        item->setGeometry(QRectF(QPointF(10, i * itemSize.height()), itemSize));
+        mScene.addItem(item);
+    }
+}
+
+void BenchmarkHbRichTextItem::cleanupTestCase()
+{
+    QPixmapCache::setCacheLimit(mDefaultCacheLimit);
+}
+
+void BenchmarkHbRichTextItem::scrollList_data()
+{
+    QTest::addColumn<bool>("cached");
+
+    // Without room in QPixmapCache the items draw the document on every paint.
+    QTest::newRow("direct") << false;
+    QTest::newRow("cached") << true;
+}
+
+/*
+    Scrolls through the whole list and back, rendering the visible part of
+    the scene after every step as the view would.
+*/
+void BenchmarkHbRichTextItem::scrollList()
+{
+    QFETCH(bool, cached);
+
+    QPixmapCache::clear();
+    QPixmapCache::setCacheLimit(cached ? mDefaultCacheLimit : 0);
+
+    QImage frame(viewportSize, QImage::Format_ARGB32_Premultiplied);
+    const qreal listHeight = itemCount * itemSize.height() - viewportSize.height();
+
+    QBENCHMARK {
+        for (int direction = 0; direction < 2; ++direction) {
+            for (qreal y = 0; y <= listHeight; y += scrollStep) {
+                const qreal top = direction ? listHeight - y : y;
+                frame.fill(0);
+                QPainter painter(&frame);
+                mScene.render(&painter, QRectF(QPointF(0, 0), viewportSize),
+                              QRectF(QPointF(0, top), viewportSize));
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    BenchmarkHbRichTextItem benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "benchmark_hbrichtextitem.moc"
@@ -0,0 +1,115 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <hbmemorymanager_p.h>
+#include <hbsharedmemorymanagerut_p.h>
+
+class BenchmarkHbSharedMemoryManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void allocFree_data();
+    void allocFree();
+    void fragmented_data();
+    void fragmented();
+
+private:
+    HbMemoryManager *mManager;
+};
+
+void BenchmarkHbSharedMemoryManager::initTestCase()
+{
+    // Allocate from a writable test chunk instead of the theme server's.
+    HbSharedMemoryManagerUt::enableForProcess();
+    mManager = HbMemoryManager::instance(HbMemoryManager::SharedMemory);
+    QVERIFY(mManager);
+    QVERIFY(mManager->isWritable());
+}
+
+void BenchmarkHbSharedMemoryManager::allocFree_data()
+{
+    // Allocations up to 224 bytes go to the multisegment sub allocator,
+    // larger ones to the splay tree main allocator.
+    QTest::addColumn<int>("size");
+    QTest::newRow("16 bytes") << 16;
+    QTest::newRow("200 bytes") << 200;
+    QTest::newRow("1 kB") << 1024;
+    QTest::newRow("64 kB") << 64 * 1024;
+}
+
+void BenchmarkHbSharedMemoryManager::allocFree()
+{
+    QFETCH(int, size);
+    const int count = 256;
+    QVector<qptrdiff> offsets(count);
+
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i) {
+            offsets[i] = mManager->alloc(size);
+        }
+        for (int i = 0; i < count; ++i) {
+            mManager->free(offsets.at(i));
+        }
+    }
+}
+
+void BenchmarkHbSharedMemoryManager::fragmented_data()
+{
+    QTest::addColumn<int>("liveCount");
+    QTest::newRow("100 live blocks") << 100;
+    QTest::newRow("1000 live blocks") << 1000;
+}
+
+/*
+    Frees and reallocates every other block of a population of mixed sizes,
+    which resembles the theme server loading and unloading css and icons.
+*/
+void BenchmarkHbSharedMemoryManager::fragmented()
+{
+    QFETCH(int, liveCount);
+    QVector<qptrdiff> offsets(liveCount);
+    for (int i = 0; i < liveCount; ++i) {
+        offsets[i] = mManager->alloc(24 + (i * 37) % 600);
+    }
+
+    QBENCHMARK {
+        for (int i = 0; i < liveCount; i += 2) {
+            mManager->free(offsets.at(i));
+        }
+        for (int i = 0; i < liveCount; i += 2) {
+            offsets[i] = mManager->alloc(24 + (i * 53) % 600);
+        }
+    }
+
+    for (int i = 0; i < liveCount; ++i) {
+        mManager->free(offsets.at(i));
+    }
+}
+
+QTEST_MAIN(BenchmarkHbSharedMemoryManager)
+#include "benchmark_hbsharedmemorymanager.moc"
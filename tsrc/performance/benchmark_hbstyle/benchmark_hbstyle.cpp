@@ -0,0 +1,187 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QGraphicsLinearLayout>
+#include <hbapplication.h>
+#include <hbmainwindow.h>
+#include <hbview.h>
+#include <hbanchorlayout.h>
+#include <hbpushbutton.h>
+#include <hblabel.h>
+#include <hbcheckbox.h>
+#include <hblineedit.h>
+
+// Gives access to the protected polishEvent() so that the benchmark can
+// polish a widget synchronously instead of going through the event loop.
+class PolishProbe
+{
+public:
+    virtual ~PolishProbe() {}
+    virtual void polishNow() = 0;
+};
+
+template <class T>
+class Polishable : public T, public PolishProbe
+{
+public:
+    void polishNow() { T::polishEvent(); }
+};
+
+class BenchmarkHbStyle : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void polish_data();
+    void polish();
+    void anchorLayoutSolve_data();
+    void anchorLayoutSolve();
+
+private:
+    void populate(int rowCount);
+
+    HbMainWindow *mWindow;
+    HbView *mView;
+    QList<HbWidget *> mWidgets;
+    QList<PolishProbe *> mProbes;
+};
+
+void BenchmarkHbStyle::initTestCase()
+{
+    mWindow = new HbMainWindow;
+    mView = mWindow->addView(new HbWidget);
+    mWindow->show();
+    QTest::qWaitForWindowShown(mWindow);
+}
+
+void BenchmarkHbStyle::cleanupTestCase()
+{
+    delete mWindow;
+    mWindow = 0;
+}
+
+/*
+    Replaces the view content with a synthetic widget tree of \a rowCount
+    rows. Each row is a container holding one widget of every kind, which
+    gives the mix of widgetml layouts and css rules of a typical form.
+*/
+void BenchmarkHbStyle::populate(int rowCount)
+{
+    mWidgets.clear();
+    mProbes.clear();
+    HbWidget *content = new HbWidget;
+    QGraphicsLinearLayout *rows = new QGraphicsLinearLayout(Qt::Vertical, content);
+    for (int i = 0; i < rowCount; ++i) {
+        HbWidget *row = new HbWidget;
+        QGraphicsLinearLayout *layout = new QGraphicsLinearLayout(Qt::Horizontal, row);
+
+        Polishable<HbPushButton> *button = new Polishable<HbPushButton>;
+        button->setText(QString("Button %1").arg(i));
+        button->setAdditionalText(QString("Additional %1").arg(i));
+        button->setIcon(HbIcon("qtg_mono_settings"));
+        layout->addItem(button);
+
+        Polishable<HbLabel> *label = new Polishable<HbLabel>;
+        label->setPlainText(QString("Label %1").arg(i));
+        layout->addItem(label);
+
+        Polishable<HbCheckBox> *checkBox = new Polishable<HbCheckBox>;
+        checkBox->setText(QString("Check box %1").arg(i));
+        layout->addItem(checkBox);
+
+        Polishable<HbLineEdit> *lineEdit = new Polishable<HbLineEdit>;
+        lineEdit->setText(QString("Line edit %1").arg(i));
+        layout->addItem(lineEdit);
+
+        rows->addItem(row);
+        mWidgets << button << label << checkBox << lineEdit;
+        mProbes << button << label << checkBox << lineEdit;
+    }
+    mView->setWidget(content);
+    QCoreApplication::processEvents();
+}
+
+void BenchmarkHbStyle::polish_data()
+{
+    QTest::addColumn<int>("rowCount");
+    QTest::newRow("1 row") << 1;
+    QTest::newRow("10 rows") << 10;
+    QTest::newRow("50 rows") << 50;
+}
+
+void BenchmarkHbStyle::polish()
+{
+    QFETCH(int, rowCount);
+    populate(rowCount);
+
+    QBENCHMARK {
+        foreach (PolishProbe *probe, mProbes) {
+            probe->polishNow();
+        }
+    }
+}
+
+void BenchmarkHbStyle::anchorLayoutSolve_data()
+{
+    polish_data();
+}
+
+void BenchmarkHbStyle::anchorLayoutSolve()
+{
+    QFETCH(int, rowCount);
+    populate(rowCount);
+
+    QList<HbAnchorLayout *> layouts;
+    foreach (HbWidget *widget, mWidgets) {
+        HbAnchorLayout *layout = dynamic_cast<HbAnchorLayout *>(widget->layout());
+        if (layout) {
+            layouts.append(layout);
+        }
+    }
+    QVERIFY(!layouts.isEmpty());
+
+    // Alternate between two widths so that every iteration solves the anchors.
+    bool wide = false;
+    QBENCHMARK {
+        wide = !wide;
+        const QRectF rect(0, 0, wide ? 360 : 240, 64);
+        foreach (HbAnchorLayout *layout, layouts) {
+            layout->invalidate();
+            layout->setGeometry(rect);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    BenchmarkHbStyle benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "benchmark_hbstyle.moc"
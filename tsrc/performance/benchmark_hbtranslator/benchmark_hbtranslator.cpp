@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLocale>
+#include <hbapplication.h>
+#include <hbtranslator.h>
+#include <hbtranslator_p.h>
+
+static const char *const catalogPrefix = "commonstrings_";
+
+class BenchmarkHbTranslator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void startup_data();
+    void startup();
+
+private:
+    QString mPath;
+    QStringList mCatalogs;
+};
+
+/*
+    Installs the ten catalogs compiled by the project file as application
+    catalogs for the current language, and checks that each of them loads.
+*/
+void BenchmarkHbTranslator::initTestCase()
+{
+#ifdef Q_OS_SYMBIAN
+    QSKIP("The catalogs are compiled to the build directory, which is not deployed", SkipAll);
+#endif
+    // HbTranslator looks for <name>_<language>.qm with the language it
+    // resolves from the system locale.
+    QString lang = QLocale::system().name();
+    HbTranslatorPrivate().languageDowngrade(lang);
+
+    mPath = QDir::temp().filePath("benchmark_hbtranslator") + '/';
+    QDir().mkpath(mPath);
+    QDir catalogDir(BENCHMARK_CATALOG_DIR);
+    foreach (const QString &file, catalogDir.entryList(QStringList("*.qm"), QDir::Files)) {
+        QString name = QFileInfo(file).completeBaseName();
+        QString target = mPath + name + '_' + lang + ".qm";
+        QFile::remove(target);
+        QVERIFY(QFile::copy(catalogDir.filePath(file), target));
+        mCatalogs.append(name);
+    }
+    QCOMPARE(mCatalogs.count(), 10);
+
+    foreach (const QString &name, mCatalogs) {
+        HbTranslator translator(mPath, name);
+        QString expected = name.mid(QString(catalogPrefix).length()) + " #OK";
+        QCOMPARE(hbTrId("txt_common_button_ok"), expected);
+    }
+}
+
+void BenchmarkHbTranslator::cleanupTestCase()
+{
+    QDir dir(mPath);
+    foreach (const QString &file, dir.entryList(QDir::Files)) {
+        dir.remove(file);
+    }
+    QDir().rmdir(mPath);
+}
+
+void BenchmarkHbTranslator::startup_data()
+{
+    QTest::addColumn<bool>("resolved");
+
+    // A process starting for the first time looks the files up, later
+    // translators reuse the resolved names.
+    QTest::newRow("first") << false;
+    QTest::newRow("resolved") << true;
+}
+
+/*
+    Creates a translator for each of the ten catalogs, as an application
+    does at startup, and deletes them again.
+*/
+void BenchmarkHbTranslator::startup()
+{
+    QFETCH(bool, resolved);
+
+    QList<HbTranslator *> translators;
+    QBENCHMARK {
+        if (!resolved) {
+            HbTranslatorPrivate::clearCatalogCache();
+        }
+        foreach (const QString &name, mCatalogs) {
+            translators.append(new HbTranslator(mPath, name));
+        }
+        qDeleteAll(translators);
+        translators.clear();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    BenchmarkHbTranslator benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "benchmark_hbtranslator.moc"
@@ -0,0 +1,48 @@
+#
+#############################################################################
+##
+## Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+## All rights reserved.
+## Contact: Nokia Corporation (developer.feedback@nokia.com)
+##
+## This file is part of the UI Extensions for Mobile.
+##
+## GNU Lesser General Public License Usage
+## This file may be used under the terms of the GNU Lesser General Public
+## License version 2.1 as published by the Free Software Foundation and
+## appearing in the file LICENSE.LGPL included in the packaging of this file.
+## Please review the following information to ensure the GNU Lesser General
+## Public License version 2.1 requirements will be met:
+## http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+##
+## In addition, as a special exception, Nokia gives you certain additional
+## rights.  These rights are described in the Nokia Qt LGPL Exception
+## version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+##
+## If you have questions regarding the use of this file, please contact
+## Nokia at developer.feedback@nokia.com.
+##
+#############################################################################
+
+TARGET = benchmark_hbtranslator
+
+include(../performance_include.pri)
+
+SOURCES += benchmark_hbtranslator.cpp
+
+# Ten of the common string catalogs, compiled to the build directory. The
+# benchmark installs them as ten distinct application catalogs.
+CATALOG_SOURCE_DIR = $${HB_SOURCE_DIR}/src/hbcore/i18n/translations/commonstrings
+CATALOG_DIR = $${OUT_PWD}/catalogs
+for(language, $$list(de fr fi sv es it nl pl ru hu)) {
+    CATALOGS += $${CATALOG_SOURCE_DIR}/commonstrings_$${language}.ts
+}
+
+catalogs.input = CATALOGS
+catalogs.output = $${CATALOG_DIR}/${QMAKE_FILE_BASE}.qm
+catalogs.commands = $$hbNativePath($$[QT_INSTALL_BINS]/lrelease) -silent -idbased ${QMAKE_FILE_IN} -qm ${QMAKE_FILE_OUT}
+catalogs.name = LRELEASE ${QMAKE_FILE_IN}
+catalogs.CONFIG = no_link target_predeps
+QMAKE_EXTRA_COMPILERS += catalogs
+
+DEFINES += BENCHMARK_CATALOG_DIR=\"\\\"$${CATALOG_DIR}\\\"\"
@@ -0,0 +1,255 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the HbTools module of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include "hbgesturetrace_p.h"
+#include <QApplication>
+#include <QWidget>
+#include <QFile>
+#include <QDataStream>
+#include <QMouseEvent>
+#include <QTouchEvent>
+#include <QTimer>
+
+// File header: 'HBGT' and format version.
+static const quint32 trace_magic = 0x48424754;
+static const quint32 trace_version = 1;
+
+static bool isMouseEvent(int type)
+{
+    return type == QEvent::MouseButtonPress
+           || type == QEvent::MouseMove
+           || type == QEvent::MouseButtonRelease;
+}
+
+static bool isTouchEvent(int type)
+{
+    return type == QEvent::TouchBegin
+           || type == QEvent::TouchUpdate
+           || type == QEvent::TouchEnd;
+}
+
+/*
+  Events are stored with the time as a delta from the previous event and the
+  coordinates as floats, which keeps the traces small.
+*/
+bool HbGestureTrace::save(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << trace_magic << trace_version << quint32(events.count());
+
+    qint64 previousTime = 0;
+    foreach(const HbGestureTraceEvent &event, events) {
+        out << quint32(event.time - previousTime) << quint16(event.type);
+        previousTime = event.time;
+        if (isMouseEvent(event.type)) {
+            out << float(event.pos.x()) << float(event.pos.y())
+                << quint8(event.button) << quint8(event.buttons);
+        } else {
+            out << quint8(event.touchPoints.count());
+            foreach(const HbGestureTraceTouchPoint &point, event.touchPoints) {
+                out << qint32(point.id) << quint8(point.state)
+                    << float(point.pos.x()) << float(point.pos.y());
+            }
+        }
+    }
+    return out.status() == QDataStream::Ok;
+}
+
+bool HbGestureTrace::load(const QString &fileName)
+{
+    events.clear();
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_4_6);
+    quint32 magic;
+    quint32 version;
+    quint32 count;
+    in >> magic >> version >> count;
+    if (magic != trace_magic || version != trace_version) {
+        return false;
+    }
+
+    qint64 time = 0;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        HbGestureTraceEvent event;
+        quint32 delta;
+        quint16 type;
+        in >> delta >> type;
+        time += delta;
+        event.time = time;
+        event.type = type;
+        event.button = 0;
+        event.buttons = 0;
+        if (isMouseEvent(type)) {
+            float x, y;
+            quint8 button, buttons;
+            in >> x >> y >> button >> buttons;
+            event.pos = QPointF(x, y);
+            event.button = button;
+            event.buttons = buttons;
+        } else if (isTouchEvent(type)) {
+            quint8 pointCount;
+            in >> pointCount;
+            for (int j = 0; j < pointCount; ++j) {
+                HbGestureTraceTouchPoint point;
+                qint32 id;
+                quint8 state;
+                float x, y;
+                in >> id >> state >> x >> y;
+                point.id = id;
+                point.state = state;
+                point.pos = QPointF(x, y);
+                event.touchPoints.append(point);
+            }
+        } else {
+            return false;
+        }
+        events.append(event);
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+HbGestureTraceRecorder::HbGestureTraceRecorder(QWidget *viewport, HbGestureTrace *trace) :
+    QObject(viewport),
+    mTrace(trace)
+{
+    viewport->installEventFilter(this);
+}
+
+bool HbGestureTraceRecorder::eventFilter(QObject *obj, QEvent *event)
+{
+    int type = event->type();
+    if (!isMouseEvent(type) && !isTouchEvent(type)) {
+        return QObject::eventFilter(obj, event);
+    }
+    if (!mTimer.isValid()) {
+        mTimer.start();
+    }
+
+    HbGestureTraceEvent record;
+    record.time = mTimer.elapsed();
+    record.type = type;
+    record.button = 0;
+    record.buttons = 0;
+    if (isMouseEvent(type)) {
+        QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+        record.pos = mouseEvent->posF();
+        record.button = mouseEvent->button();
+        record.buttons = mouseEvent->buttons();
+    } else {
+        QTouchEvent *touchEvent = static_cast<QTouchEvent *>(event);
+        foreach(const QTouchEvent::TouchPoint &touchPoint, touchEvent->touchPoints()) {
+            HbGestureTraceTouchPoint point;
+            point.id = touchPoint.id();
+            point.state = touchPoint.state();
+            point.pos = touchPoint.pos();
+            record.touchPoints.append(point);
+        }
+    }
+    mTrace->events.append(record);
+    return QObject::eventFilter(obj, event);
+}
+
+/*
+  Replays the trace to \a viewport. With \a speed 1.0 the events are sent at
+  the recorded times, with 2.0 twice as fast, and with 0 as fast as possible.
+*/
+HbGestureTracePlayer::HbGestureTracePlayer(QWidget *viewport, const HbGestureTrace &trace, qreal speed) :
+    QObject(viewport),
+    mViewport(viewport),
+    mTrace(trace),
+    mSpeed(speed),
+    mNext(0)
+{
+}
+
+void HbGestureTracePlayer::start()
+{
+    mNext = 0;
+    mDeliveryTimes.clear();
+    mTimer.start();
+    scheduleNext();
+}
+
+void HbGestureTracePlayer::scheduleNext()
+{
+    if (mNext >= mTrace.events.count()) {
+        emit finished();
+        return;
+    }
+    int delay = 0;
+    if (mSpeed > 0) {
+        qint64 due = qint64(mTrace.events.at(mNext).time / mSpeed);
+        delay = int(qMax(qint64(0), due - mTimer.elapsed()));
+    }
+    // Also with no delay the event loop runs in between, so the timers of the
+    // recognizers and the scroll animations get their turn.
+    QTimer::singleShot(delay, this, SLOT(sendNext()));
+}
+
+void HbGestureTracePlayer::sendNext()
+{
+    const HbGestureTraceEvent &event = mTrace.events.at(mNext++);
+    QElapsedTimer timer;
+    timer.start();
+    send(event);
+    mDeliveryTimes.append(timer.nsecsElapsed());
+    scheduleNext();
+}
+
+void HbGestureTracePlayer::send(const HbGestureTraceEvent &event)
+{
+    QPointF origin(mViewport->mapToGlobal(QPoint(0, 0)));
+    if (isMouseEvent(event.type)) {
+        QMouseEvent mouseEvent(QEvent::Type(event.type), event.pos.toPoint(),
+                               (origin + event.pos).toPoint(),
+                               Qt::MouseButton(event.button),
+                               Qt::MouseButtons(event.buttons), Qt::NoModifier);
+        QApplication::sendEvent(mViewport, &mouseEvent);
+    } else {
+        QList<QTouchEvent::TouchPoint> touchPoints;
+        Qt::TouchPointStates states = 0;
+        foreach(const HbGestureTraceTouchPoint &point, event.touchPoints) {
+            QTouchEvent::TouchPoint touchPoint(point.id);
+            touchPoint.setState(Qt::TouchPointState(point.state));
+            touchPoint.setPos(point.pos);
+            touchPoint.setScreenPos(origin + point.pos);
+            touchPoints.append(touchPoint);
+            states |= Qt::TouchPointState(point.state);
+        }
+        QTouchEvent touchEvent(QEvent::Type(event.type), QTouchEvent::TouchScreen,
+                               Qt::NoModifier, states, touchPoints);
+        touchEvent.setWidget(mViewport);
+        QApplication::sendEvent(mViewport, &touchEvent);
+    }
+}
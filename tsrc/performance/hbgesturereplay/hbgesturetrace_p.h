@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the HbTools module of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#ifndef HBGESTURETRACE_P_H
+#define HBGESTURETRACE_P_H
+
+#include <QObject>
+#include <QList>
+#include <QPointF>
+#include <QElapsedTimer>
+
+class QWidget;
+
+struct HbGestureTraceTouchPoint
+{
+    int id;
+    int state;
+    QPointF pos;
+};
+
+// One recorded mouse or touch event. Positions are relative to the viewport
+// of the main window.
+struct HbGestureTraceEvent
+{
+    qint64 time; // milliseconds from the start of the recording
+    int type;
+    QPointF pos;
+    int button;
+    int buttons;
+    QList<HbGestureTraceTouchPoint> touchPoints;
+};
+
+class HbGestureTrace
+{
+public:
+    bool load(const QString &fileName);
+    bool save(const QString &fileName) const;
+
+    QList<HbGestureTraceEvent> events;
+};
+
+class HbGestureTraceRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    HbGestureTraceRecorder(QWidget *viewport, HbGestureTrace *trace);
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *event);
+
+private:
+    HbGestureTrace *mTrace;
+    QElapsedTimer mTimer;
+};
+
+class HbGestureTracePlayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    HbGestureTracePlayer(QWidget *viewport, const HbGestureTrace &trace, qreal speed);
+
+    // Time spent delivering each event, including gesture recognition, in nanoseconds.
+    const QList<qint64> &deliveryTimes() const { return mDeliveryTimes; }
+
+public slots:
+    void start();
+
+signals:
+    void finished();
+
+private slots:
+    void sendNext();
+
+private:
+    void scheduleNext();
+    void send(const HbGestureTraceEvent &event);
+
+    QWidget *mViewport;
+    const HbGestureTrace &mTrace;
+    qreal mSpeed;
+    int mNext;
+    QElapsedTimer mTimer;
+    QList<qint64> mDeliveryTimes;
+};
+
+#endif // HBGESTURETRACE_P_H
@@ -0,0 +1,313 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the HbTools module of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QStringList>
+#include <QEvent>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QGestureRecognizer>
+#include <hbapplication.h>
+#include <hbmainwindow.h>
+#include <hblistwidget.h>
+#include <hbgesturerecognizers_p.h>
+#include "hbgesturetrace_p.h"
+#include <iostream>
+
+// Time to wait for the kinetic scrolling to end after the last event.
+static const int settle_timeout = 5000; // ms
+
+void showHelp() {
+    std::cout << "hbgesturereplay usage:\n\n";
+
+    std::cout << "hbgesturereplay -record traceFile\n";
+    std::cout << "hbgesturereplay -replay traceFile [-speed factor] [-hidden] [-verbose]\n";
+    std::cout << "hbgesturereplay -synthetic [-speed factor] [-hidden] [-verbose]\n\n";
+
+    std::cout << "    Records the mouse and touch events given to a list of 500 items\n";
+    std::cout << "    until the window is closed, or replays a recorded trace to the\n";
+    std::cout << "    same list. -synthetic replays a built-in trace of slow drags\n";
+    std::cout << "    and flicks in both directions.\n\n";
+
+    std::cout << "    After a replay prints the time spent delivering the events,\n";
+    std::cout << "    including gesture recognition, the time spent in each gesture\n";
+    std::cout << "    recognizer and the number of scroll position changes (frames)\n";
+    std::cout << "    of the list.\n\n";
+
+    std::cout << "options:\n\n";
+
+    std::cout << " -speed \tplayback speed, 1 for the recorded speed (default) and 0\n";
+    std::cout << "        \tfor as fast as possible. Note that the recognizers measure\n";
+    std::cout << "        \ttime themselves, so other speeds change the gesture velocities.\n";
+    std::cout << " -hidden \tdoes not show the window on the screen.\n";
+    std::cout << " -verbose \tprints the delivery time of each event.\n\n";
+}
+
+class FrameCounter : public QObject
+{
+    Q_OBJECT
+
+public:
+    FrameCounter() : frames(0), scrolling(false) {}
+
+    int frames;
+    bool scrolling;
+
+public slots:
+    void countFrame() { ++frames; }
+    void scrollingStarted() { scrolling = true; }
+    void scrollingEnded() { scrolling = false; }
+};
+
+// Forwards to a recognizer of HbCore and adds up the time spent in its
+// recognize(). Registered in place of the recognizers HbInstance installed.
+class TimedRecognizer : public QGestureRecognizer
+{
+public:
+    TimedRecognizer(const char *name, QGestureRecognizer *recognizer)
+        : name(name), calls(0), time(0), mRecognizer(recognizer) {}
+    ~TimedRecognizer() { delete mRecognizer; }
+
+    QGesture *create(QObject *target)
+    {
+        return mRecognizer->create(target);
+    }
+
+    Result recognize(QGesture *state, QObject *watched, QEvent *event)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        Result result = mRecognizer->recognize(state, watched, event);
+        time += timer.nsecsElapsed();
+        ++calls;
+        return result;
+    }
+
+    void reset(QGesture *state)
+    {
+        mRecognizer->reset(state);
+    }
+
+    const char *name;
+    int calls;
+    qint64 time;
+
+private:
+    QGestureRecognizer *mRecognizer;
+};
+
+// Replaces the gesture recognizers with timed ones. The gesture manager owns
+// the recognizers and deletes them when the application exits.
+static QList<TimedRecognizer *> installTimedRecognizers()
+{
+    QList<TimedRecognizer *> recognizers;
+#ifdef HB_GESTURE_FW
+    QGestureRecognizer::unregisterRecognizer(Qt::TapGesture);
+    QGestureRecognizer::unregisterRecognizer(Qt::TapAndHoldGesture);
+    QGestureRecognizer::unregisterRecognizer(Qt::PanGesture);
+    QGestureRecognizer::unregisterRecognizer(Qt::SwipeGesture);
+    QGestureRecognizer::unregisterRecognizer(Qt::PinchGesture);
+
+    recognizers << new TimedRecognizer("tap", new HbTapGestureRecognizer);
+    recognizers << new TimedRecognizer("tap and hold", new HbTapAndHoldGestureRecognizer);
+    recognizers << new TimedRecognizer("pan", new HbPanGestureRecognizer);
+    recognizers << new TimedRecognizer("swipe", new HbSwipeGestureRecognizer);
+    recognizers << new TimedRecognizer("pinch", new HbPinchGestureRecognizer);
+    foreach (TimedRecognizer *recognizer, recognizers) {
+        QGestureRecognizer::registerRecognizer(recognizer);
+    }
+#endif
+    return recognizers;
+}
+
+class ReplayWaiter : public QObject
+{
+    Q_OBJECT
+
+public:
+    ReplayWaiter(FrameCounter *counter) : mCounter(counter), mWaited(0) {}
+
+public slots:
+    void replayFinished() { poll(); }
+
+private slots:
+    void poll()
+    {
+        if (mCounter->scrolling && mWaited < settle_timeout) {
+            mWaited += 50;
+            QTimer::singleShot(50, this, SLOT(poll()));
+        } else {
+            qApp->quit();
+        }
+    }
+
+private:
+    FrameCounter *mCounter;
+    int mWaited;
+};
+
+static void appendMouseEvent(HbGestureTrace &trace, QEvent::Type type,
+                             const QPointF &pos, qint64 time)
+{
+    HbGestureTraceEvent event;
+    event.time = time;
+    event.type = type;
+    event.pos = pos;
+    event.button = type == QEvent::MouseMove ? Qt::NoButton : Qt::LeftButton;
+    event.buttons = type == QEvent::MouseButtonRelease ? Qt::NoButton : Qt::LeftButton;
+    trace.events.append(event);
+}
+
+// Alternating drags and flicks down and up the list, one move every 16 ms.
+static void makeSyntheticTrace(HbGestureTrace &trace)
+{
+    qint64 time = 500;
+    for (int stroke = 0; stroke < 20; ++stroke) {
+        const bool flick = stroke % 4 >= 2;
+        const qreal step = (stroke % 2 ? 1 : -1) * (flick ? 40 : 6);
+        const int moves = flick ? 6 : 40;
+        QPointF pos(100, stroke % 2 ? 100 : 400);
+        appendMouseEvent(trace, QEvent::MouseButtonPress, pos, time);
+        for (int i = 0; i < moves; ++i) {
+            time += 16;
+            pos.ry() += step;
+            appendMouseEvent(trace, QEvent::MouseMove, pos, time);
+        }
+        time += 16;
+        appendMouseEvent(trace, QEvent::MouseButtonRelease, pos, time);
+        time += flick ? 1500 : 300;
+    }
+}
+
+static void printReport(const QList<qint64> &times, const HbGestureTrace &trace,
+                        const QList<TimedRecognizer *> &recognizers, int frames, bool verbose)
+{
+    qint64 total = 0;
+    qint64 worst = 0;
+    for (int i = 0; i < times.count(); ++i) {
+        total += times.at(i);
+        worst = qMax(worst, times.at(i));
+        if (verbose) {
+            std::cout << "event," << i << "," << trace.events.at(i).type << ","
+                      << times.at(i) / 1000 << "\n";
+        }
+    }
+    std::cout << "events: " << times.count() << "\n";
+    if (!times.isEmpty()) {
+        std::cout << "delivery total: " << total / 1000 << " us\n";
+        std::cout << "delivery mean: " << total / times.count() / 1000 << " us\n";
+        std::cout << "delivery max: " << worst / 1000 << " us\n";
+    }
+    foreach (const TimedRecognizer *recognizer, recognizers) {
+        std::cout << "recognizer " << recognizer->name << ": " << recognizer->calls
+                  << " calls, total " << recognizer->time / 1000 << " us";
+        if (recognizer->calls) {
+            std::cout << ", mean " << recognizer->time / recognizer->calls << " ns";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "scroll frames: " << frames << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    HbApplication app(argc, argv);
+    QStringList args = app.arguments();
+
+    QString recordFile;
+    QString replayFile;
+    qreal speed = 1.0;
+    bool hidden = false;
+    bool verbose = false;
+    bool synthetic = false;
+    for (int i = 1; i < args.count(); ++i) {
+        const QString &arg = args.at(i);
+        if (arg == "-record" && i + 1 < args.count()) {
+            recordFile = args.at(++i);
+        } else if (arg == "-replay" && i + 1 < args.count()) {
+            replayFile = args.at(++i);
+        } else if (arg == "-speed" && i + 1 < args.count()) {
+            speed = args.at(++i).toDouble();
+        } else if (arg == "-synthetic") {
+            synthetic = true;
+        } else if (arg == "-hidden") {
+            hidden = true;
+        } else if (arg == "-verbose") {
+            verbose = true;
+        }
+    }
+    if (int(!recordFile.isEmpty()) + int(!replayFile.isEmpty()) + int(synthetic) != 1) {
+        showHelp();
+        return 1;
+    }
+
+    HbMainWindow window;
+    HbListWidget *list = new HbListWidget;
+    for (int i = 0; i < 500; ++i) {
+        list->addItem(QString("Item %1").arg(i));
+    }
+    window.addView(list);
+
+    FrameCounter counter;
+    QObject::connect(list, SIGNAL(scrollPositionChanged(QPointF)), &counter, SLOT(countFrame()));
+    QObject::connect(list, SIGNAL(scrollingStarted()), &counter, SLOT(scrollingStarted()));
+    QObject::connect(list, SIGNAL(scrollingEnded()), &counter, SLOT(scrollingEnded()));
+
+    if (hidden) {
+        window.setAttribute(Qt::WA_DontShowOnScreen);
+    }
+    window.show();
+
+    HbGestureTrace trace;
+    if (!recordFile.isEmpty()) {
+        new HbGestureTraceRecorder(window.viewport(), &trace);
+        int result = app.exec();
+        if (!trace.save(recordFile)) {
+            std::cout << "Error: cannot write " << recordFile.toStdString() << ".\n";
+            return 1;
+        }
+        std::cout << "Recorded " << trace.events.count() << " events.\n";
+        return result;
+    }
+
+    if (synthetic) {
+        makeSyntheticTrace(trace);
+    } else if (!trace.load(replayFile)) {
+        std::cout << "Error: cannot read " << replayFile.toStdString() << ".\n";
+        return 1;
+    }
+    // HbInstance registers the recognizers again when it is created, so
+    // they are replaced only after the main window exists.
+    QList<TimedRecognizer *> recognizers = installTimedRecognizers();
+    HbGestureTracePlayer *player = new HbGestureTracePlayer(window.viewport(), trace, speed);
+    ReplayWaiter waiter(&counter);
+    QObject::connect(player, SIGNAL(finished()), &waiter, SLOT(replayFinished()));
+    // Let the window get laid out before the first event.
+    QTimer::singleShot(0, player, SLOT(start()));
+    int result = app.exec();
+    printReport(player->deliveryTimes(), trace, recognizers, counter.frames, verbose);
+    return result;
+}
+
+#include "main.moc"
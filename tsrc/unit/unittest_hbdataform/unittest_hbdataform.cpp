@@ -0,0 +1,336 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <hbapplication.h>
+#include <hbmainwindow.h>
+#include <hbview.h>
+#include <hbstyle.h>
+#include <hbcombobox.h>
+#include <hbdataform.h>
+#include <hbdataformmodel.h>
+#include <hbdataformmodelitem.h>
+
+// Long enough for the posted events that create the items near the view
+static const int KSettleTime = 100;
+
+/*
+    Appends the indexes of \a parent in the order the form shows them.
+*/
+static void displayOrder(const HbDataForm *form, const QModelIndex &parent, QModelIndexList *indexes)
+{
+    const QAbstractItemModel *model = form->model();
+    for (int row = 0; row < model->rowCount(parent); ++row) {
+        QModelIndex index = model->index(row, 0, parent);
+        indexes->append(index);
+        if (form->isExpanded(index)) {
+            displayOrder(form, index, indexes);
+        }
+    }
+}
+
+static HbComboBox *findCombo(QGraphicsItem *root, const QString &name)
+{
+    foreach (QGraphicsItem *child, root->childItems()) {
+        if (HbStyle::itemName(child) == name) {
+            if (HbComboBox *combo = qobject_cast<HbComboBox *>(child->toGraphicsObject())) {
+                return combo;
+            }
+        }
+        if (HbComboBox *combo = findCombo(child, name)) {
+            return combo;
+        }
+    }
+    return 0;
+}
+
+static QStringList labels(const QString &prefix, int count)
+{
+    QStringList result;
+    for (int i = 0; i < count; ++i) {
+        result.append(prefix + QString::number(i));
+    }
+    return result;
+}
+
+class TestHbDataForm : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void itemsCreatedNearView();
+    void expandPastBufferEdge();
+    void collapsePastBufferEdge();
+    void scrollToUncreatedIndex();
+    void pageComboAfterReset();
+    void pageComboAfterRowsInserted();
+    void groupPageComboAfterReset();
+
+private:
+    HbDataFormModelItem *appendGroup(const QString &label, int itemCount);
+    int createdItemCount() const;
+    bool createdItemsContiguous() const;
+
+    HbMainWindow *mWindow;
+    HbView *mView;
+    HbDataForm *mForm;
+    HbDataFormModel *mModel;
+};
+
+void TestHbDataForm::initTestCase()
+{
+    mWindow = new HbMainWindow;
+    mWindow->show();
+    QTest::qWaitForWindowShown(mWindow);
+}
+
+void TestHbDataForm::cleanupTestCase()
+{
+    delete mWindow;
+    mWindow = 0;
+}
+
+void TestHbDataForm::init()
+{
+    mModel = new HbDataFormModel;
+    mForm = new HbDataForm;
+    mView = mWindow->addView(mForm);
+    mWindow->setCurrentView(mView);
+}
+
+void TestHbDataForm::cleanup()
+{
+    mWindow->removeView(mView);
+    delete mView;
+    mView = 0;
+    mForm = 0;
+    delete mModel;
+    mModel = 0;
+}
+
+HbDataFormModelItem *TestHbDataForm::appendGroup(const QString &label, int itemCount)
+{
+    HbDataFormModelItem *group = mModel->appendDataFormGroup(label);
+    for (int i = 0; i < itemCount; ++i) {
+        mModel->appendDataFormItem(HbDataFormModelItem::TextItem,
+                                   label + QString::number(i), group);
+    }
+    return group;
+}
+
+int TestHbDataForm::createdItemCount() const
+{
+    QModelIndexList indexes;
+    displayOrder(mForm, QModelIndex(), &indexes);
+    int count = 0;
+    foreach (const QModelIndex &index, indexes) {
+        if (mForm->itemByIndex(index)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/*
+    The items always cover the beginning of the form, without gaps.
+*/
+bool TestHbDataForm::createdItemsContiguous() const
+{
+    QModelIndexList indexes;
+    displayOrder(mForm, QModelIndex(), &indexes);
+    bool created = true;
+    foreach (const QModelIndex &index, indexes) {
+        if (mForm->itemByIndex(index)) {
+            if (!created) {
+                return false;
+            }
+        } else {
+            created = false;
+        }
+    }
+    return true;
+}
+
+void TestHbDataForm::itemsCreatedNearView()
+{
+    HbDataFormModelItem *group = appendGroup("Item ", 1000);
+    mForm->setModel(mModel);
+    mForm->setExpanded(mModel->indexFromItem(group), true);
+    QTest::qWait(KSettleTime);
+
+    QVERIFY(createdItemCount() > 1);
+    QVERIFY(createdItemCount() < 1000);
+    QVERIFY(!mForm->itemByIndex(mModel->indexFromItem(group->childAt(999))));
+    QVERIFY(createdItemsContiguous());
+}
+
+void TestHbDataForm::expandPastBufferEdge()
+{
+    QList<HbDataFormModelItem *> groups;
+    for (int i = 0; i < 10; ++i) {
+        groups.append(appendGroup(QString("Group %1 item ").arg(i), 100));
+    }
+    mForm->setModel(mModel);
+    QTest::qWait(KSettleTime);
+    QVERIFY(mForm->itemByIndex(mModel->indexFromItem(groups.last())));
+
+    // The children of the first group push the other groups out of the buffer
+    QModelIndex firstGroup = mModel->indexFromItem(groups.first());
+    mForm->setExpanded(firstGroup, true);
+    QVERIFY(createdItemsContiguous());
+    QTest::qWait(KSettleTime);
+    QVERIFY(createdItemsContiguous());
+    QVERIFY(mForm->itemByIndex(mModel->indexFromItem(groups.first()->childAt(0))));
+    QVERIFY(!mForm->itemByIndex(mModel->indexFromItem(groups.last())));
+
+    // The children of the last group reach past the end of the buffer
+    mForm->setExpanded(firstGroup, false);
+    QTest::qWait(KSettleTime);
+    QModelIndex lastGroup = mModel->indexFromItem(groups.last());
+    QVERIFY(mForm->itemByIndex(lastGroup));
+    mForm->setExpanded(lastGroup, true);
+    QVERIFY(createdItemsContiguous());
+    QTest::qWait(KSettleTime);
+    QVERIFY(createdItemsContiguous());
+    QVERIFY(!mForm->itemByIndex(mModel->indexFromItem(groups.last()->childAt(99))));
+}
+
+void TestHbDataForm::collapsePastBufferEdge()
+{
+    QList<HbDataFormModelItem *> groups;
+    for (int i = 0; i < 10; ++i) {
+        groups.append(appendGroup(QString("Group %1 item ").arg(i), 100));
+    }
+    mForm->setModel(mModel);
+    QModelIndex firstGroup = mModel->indexFromItem(groups.first());
+    mForm->setExpanded(firstGroup, true);
+    QTest::qWait(KSettleTime);
+    QVERIFY(!mForm->itemByIndex(mModel->indexFromItem(groups.first()->childAt(99))));
+
+    // Collapsing deletes the items of the children that were created
+    mForm->setExpanded(firstGroup, false);
+    QVERIFY(createdItemsContiguous());
+    for (int i = 0; i < groups.first()->childCount(); ++i) {
+        QVERIFY(!mForm->itemByIndex(mModel->indexFromItem(groups.first()->childAt(i))));
+    }
+    QTest::qWait(KSettleTime);
+    QVERIFY(createdItemsContiguous());
+    QVERIFY(mForm->itemByIndex(mModel->indexFromItem(groups.last())));
+}
+
+void TestHbDataForm::scrollToUncreatedIndex()
+{
+    HbDataFormModelItem *group = appendGroup("Item ", 1000);
+    mForm->setModel(mModel);
+    mForm->setExpanded(mModel->indexFromItem(group), true);
+    QTest::qWait(KSettleTime);
+
+    QModelIndex target = mModel->indexFromItem(group->childAt(500));
+    QVERIFY(!mForm->itemByIndex(target));
+    mForm->scrollTo(target);
+    QVERIFY(mForm->itemByIndex(target));
+    QVERIFY(createdItemsContiguous());
+    QTest::qWait(KSettleTime);
+    QVERIFY(mForm->itemByIndex(target));
+}
+
+void TestHbDataForm::pageComboAfterReset()
+{
+    const QStringList pages = labels("Page ", 30);
+    foreach (const QString &page, pages) {
+        HbDataFormModelItem *pageItem = mModel->appendDataFormPage(page);
+        for (int i = 0; i < 40; ++i) {
+            mModel->appendDataFormItem(HbDataFormModelItem::TextItem,
+                                       page + " item " + QString::number(i), pageItem);
+        }
+    }
+    mForm->setModel(mModel);
+    QTest::qWait(KSettleTime);
+
+    HbComboBox *combo = findCombo(mForm, "dataForm_Combo");
+    QVERIFY(combo);
+    QCOMPARE(combo->items(), pages);
+}
+
+void TestHbDataForm::pageComboAfterRowsInserted()
+{
+    QStringList pages = labels("Page ", 30);
+    foreach (const QString &page, pages) {
+        HbDataFormModelItem *pageItem = mModel->appendDataFormPage(page);
+        for (int i = 0; i < 40; ++i) {
+            mModel->appendDataFormItem(HbDataFormModelItem::TextItem,
+                                       page + " item " + QString::number(i), pageItem);
+        }
+    }
+    mForm->setModel(mModel);
+    QTest::qWait(KSettleTime);
+
+    mModel->appendDataFormPage("Late page");
+    pages.append("Late page");
+    QTest::qWait(KSettleTime);
+
+    HbComboBox *combo = findCombo(mForm, "dataForm_Combo");
+    QVERIFY(combo);
+    QCOMPARE(combo->items(), pages);
+}
+
+void TestHbDataForm::groupPageComboAfterReset()
+{
+    const QStringList pages = labels("Group page ", 30);
+    HbDataFormModelItem *group = mModel->appendDataFormGroup("Group");
+    foreach (const QString &page, pages) {
+        HbDataFormModelItem *pageItem = mModel->appendDataFormGroupPage(page, group);
+        for (int i = 0; i < 40; ++i) {
+            mModel->appendDataFormItem(HbDataFormModelItem::TextItem,
+                                       page + " item " + QString::number(i), pageItem);
+        }
+    }
+    mForm->setModel(mModel);
+    QTest::qWait(KSettleTime);
+
+    HbAbstractViewItem *groupItem = mForm->itemByIndex(mModel->indexFromItem(group));
+    QVERIFY(groupItem);
+    HbComboBox *combo = findCombo(groupItem, "dataGroup_Combo");
+    QVERIFY(combo);
+    QCOMPARE(combo->items(), pages);
+
+    mModel->appendDataFormGroupPage("Late page", group);
+    QTest::qWait(KSettleTime);
+    QCOMPARE(combo->items(), QStringList(pages) << "Late page");
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    TestHbDataForm test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "unittest_hbdataform.moc"
@@ -0,0 +1,197 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <hbextendedlocale.h>
+#include <hbi18ndef.h>
+#include <hbdatetimeformat_p.h>
+
+static QStringList allFormats()
+{
+    return QStringList()
+        << r_qtn_time_usual << r_qtn_time_usual_with_zero
+        << r_qtn_time_long << r_qtn_time_long_with_zero
+        << r_qtn_date_short << r_qtn_date_short_with_zero
+        << r_qtn_date_usual << r_qtn_date_usual_with_zero
+        << r_qtn_date_without_year << r_qtn_date_without_year_with_zero
+        << r_qtn_time_durat_short << r_qtn_time_durat_short_with_zero
+        << r_qtn_time_durat_long << r_qtn_time_durat_long_with_zero
+        << r_qtn_time_durat_min_sec << r_qtn_time_durat_min_sec_with_zero;
+}
+
+class TestHbDateTimeFormat : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void timeFormats_data();
+    void timeFormats();
+    void dateFormats_data();
+    void dateFormats();
+    void cachedMatchesCompiled();
+
+    void formatThroughput_data();
+    void formatThroughput();
+};
+
+void TestHbDateTimeFormat::initTestCase()
+{
+#ifdef Q_OS_SYMBIAN
+    // The expected strings assume the fixed settings that HbExtendedLocale
+    // reports on other platforms: American dates separated with '/', 12 hour
+    // time separated with ':' and am/pm after the time with a space.
+    QSKIP("The locale settings come from the device", SkipAll);
+#endif
+    QLocale::setDefault(QLocale(QLocale::English, QLocale::UnitedStates));
+}
+
+void TestHbDateTimeFormat::timeFormats_data()
+{
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<QTime>("time");
+    QTest::addColumn<QString>("expected");
+
+    const QTime morning(9, 5, 4);
+    const QTime afternoon(13, 45, 0);
+    QTest::newRow("usual") << r_qtn_time_usual << morning << "9:05 AM";
+    QTest::newRow("usual pm") << r_qtn_time_usual << afternoon << "1:45 PM";
+    QTest::newRow("usual zero") << r_qtn_time_usual_with_zero << morning << "09:05 AM";
+    QTest::newRow("long") << r_qtn_time_long << morning << "9:05:04 AM";
+    QTest::newRow("long zero") << r_qtn_time_long_with_zero << afternoon << "01:45:00 PM";
+    QTest::newRow("durat short") << r_qtn_time_durat_short << afternoon << "13:45";
+    QTest::newRow("durat short zero") << r_qtn_time_durat_short_with_zero << morning << "09:05";
+    QTest::newRow("durat long") << r_qtn_time_durat_long << morning << "9:05:04";
+    QTest::newRow("durat min sec") << r_qtn_time_durat_min_sec << morning << "5:04";
+    QTest::newRow("durat min sec zero") << r_qtn_time_durat_min_sec_with_zero << morning << "05:04";
+    // %A gives the am/pm text regardless of the clock, %B only with the
+    // 12 hour clock, and both follow the locale position with - and +.
+    QTest::newRow("%A") << "%H%T%A" << afternoon << "1345PM";
+    QTest::newRow("%-A %+A") << "%-A%H%T%+A" << morning << "0905 AM";
+    QTest::newRow("%B") << "%B" << morning << "AM";
+    QTest::newRow("literal %") << "%%%H" << morning << "%09";
+    QTest::newRow("unknown") << "%Q%H" << morning << "09";
+}
+
+void TestHbDateTimeFormat::timeFormats()
+{
+    QFETCH(QString, format);
+    QFETCH(QTime, time);
+    QFETCH(QString, expected);
+
+    HbExtendedLocale locale;
+    QCOMPARE(locale.format(time, format), expected);
+}
+
+void TestHbDateTimeFormat::dateFormats_data()
+{
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<QDate>("date");
+    QTest::addColumn<QString>("expected");
+
+    const QDate date(2010, 3, 7);
+    QTest::newRow("short") << r_qtn_date_short << date << "3/7/10";
+    QTest::newRow("short zero") << r_qtn_date_short_with_zero << date << "03/07/10";
+    QTest::newRow("usual") << r_qtn_date_usual << date << "3/7/2010";
+    QTest::newRow("usual zero") << r_qtn_date_usual_with_zero << date << "03/07/2010";
+    QTest::newRow("without year") << r_qtn_date_without_year << date << "3/7";
+    QTest::newRow("without year zero") << r_qtn_date_without_year_with_zero << date << "03/07";
+    QTest::newRow("fixed order") << "%F%Y-%M-%D" << date << "2010-03-07";
+    QTest::newRow("names") << "%*E %N" << date << "Sun March";
+}
+
+void TestHbDateTimeFormat::dateFormats()
+{
+    QFETCH(QString, format);
+    QFETCH(QDate, date);
+    QFETCH(QString, expected);
+
+    HbExtendedLocale locale;
+    QCOMPARE(locale.format(date, format), expected);
+}
+
+/*
+    The cached format must give the same output as a format that is compiled
+    for each call, also after the cache has been filled with other formats.
+*/
+void TestHbDateTimeFormat::cachedMatchesCompiled()
+{
+    HbExtendedLocale locale;
+    const QStringList formats = allFormats();
+    QDateTime dateTime(QDate(1999, 12, 31), QTime(23, 59, 59));
+    for (int i = 0; i < 500; ++i) {
+        dateTime = dateTime.addSecs(7919);
+        const QString &format = formats.at(i % formats.count());
+        const QString compiled = HbDateTimeFormat::compile(format)
+                                 .run(locale, dateTime.date(), dateTime.time());
+        QString cached;
+        if (format.contains(QLatin1Char('/'))) {
+            cached = locale.format(dateTime.date(), format);
+        } else {
+            cached = locale.format(dateTime.time(), format);
+        }
+        QCOMPARE(cached, compiled);
+    }
+}
+
+void TestHbDateTimeFormat::formatThroughput_data()
+{
+    QTest::addColumn<int>("mode");
+    QTest::newRow("short format") << 0;
+    QTest::newRow("parse per call") << 1;
+    QTest::newRow("cached") << 2;
+}
+
+/*
+    Formats 100k dates. "short format" is what format() returned on other
+    platforms than Symbian before the formats were interpreted, "parse per
+    call" is the cost of interpreting the format string for every date.
+*/
+void TestHbDateTimeFormat::formatThroughput()
+{
+    QFETCH(int, mode);
+    HbExtendedLocale locale;
+    const QString format(r_qtn_date_usual_with_zero);
+    const QDate first(2000, 1, 1);
+    int length = 0;
+
+    QBENCHMARK {
+        for (int i = 0; i < 100000; ++i) {
+            const QDate date = first.addDays(i);
+            if (mode == 0) {
+                length += locale.toString(date, QLocale::ShortFormat).length();
+            } else if (mode == 1) {
+                length += HbDateTimeFormat::compile(format).run(locale, date, QTime(0, 0)).length();
+            } else {
+                length += locale.format(date, format).length();
+            }
+        }
+    }
+    QVERIFY(length > 0);
+}
+
+QTEST_MAIN(TestHbDateTimeFormat)
+#include "unittest_hbdatetimeformat.moc"
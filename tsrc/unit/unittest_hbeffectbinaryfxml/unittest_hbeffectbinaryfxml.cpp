@@ -0,0 +1,238 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QBuffer>
+#include <QEasingCurve>
+#include <QTemporaryFile>
+#include <hbeffectbinaryfxml_p.h>
+#include <hbeffectxmlparser_p.h>
+
+// Covers the parts of the format the effects use: durations, styles,
+// references, loop markers, color keyframes and filters. Filters are parsed
+// only when HbCore is built with HB_FILTER_EFFECTS.
+static const char fxml[] =
+    "<layers>"
+    " <visual src=\"Item\">"
+    "  <param name=\"scale_x\" type=\"anim\">"
+    "   <duration>0.3</duration>"
+    "   <style>inquad</style>"
+    "   <keyframe at=\"0.0\">0</keyframe>"
+    "   <keyframe at=\"1.0\">1</keyframe>"
+    "   <start ref=\"visual.width\">1.1</start>"
+    "   <end ref=\"visual.width\">0.3</end>"
+    "  </param>"
+    "  <param name=\"opacity\" type=\"anim\">"
+    "   <duration>1.25</duration>"
+    "   <style>outback</style>"
+    "   <marker at=\"0.2\" type=\"loop_start\"/>"
+    "   <marker at=\"0.8\" type=\"loop_end\"/>"
+    "   <keyframe at=\"0.0\">1.0</keyframe>"
+    "   <keyframe at=\"0.8\">0.5</keyframe>"
+    "   <keyframe at=\"1.0\">0.0</keyframe>"
+    "  </param>"
+    "  <param name=\"scale_origin_x\" ref=\"visual.width\">0.5</param>"
+    " </visual>"
+    " <blending>additive</blending>"
+    " <filter name=\"colorize\" type=\"colorize\">"
+    "  <param name=\"color\" type=\"anim\">"
+    "   <duration>0.5</duration>"
+    "   <keyframe at=\"0.0\">#ff0000</keyframe>"
+    "   <keyframe at=\"1.0\">#0000ff</keyframe>"
+    "  </param>"
+    " </filter>"
+    "</layers>";
+
+class TestHbEffectBinaryFxml : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void roundTripMatchesParser();
+    void durationsAndCurvesAreResolved();
+    void fxmlIsNotBinary();
+    void readFile();
+    void truncatedIsRejected();
+
+private:
+    bool parse(HbEffectFxmlData *data);
+    static void compareParams(const QList<HbEffectFxmlParamData> &expected,
+                              const QList<HbEffectFxmlParamData> &actual);
+
+    HbEffectFxmlData *mParsed;
+    QByteArray mBinary;
+};
+
+bool TestHbEffectBinaryFxml::parse(HbEffectFxmlData *data)
+{
+    QByteArray contents(fxml);
+    QBuffer buffer(&contents);
+    buffer.open(QIODevice::ReadOnly | QIODevice::Text);
+    HbEffectXmlParser parser;
+    return parser.read(&buffer, data);
+}
+
+void TestHbEffectBinaryFxml::init()
+{
+    mParsed = new HbEffectFxmlData;
+    QVERIFY(parse(mParsed));
+    QBuffer buffer(&mBinary);
+    buffer.open(QIODevice::WriteOnly);
+    QVERIFY(HbEffectBinaryFxml::write(&buffer, *mParsed));
+}
+
+void TestHbEffectBinaryFxml::cleanup()
+{
+    delete mParsed;
+    mParsed = 0;
+    mBinary.clear();
+}
+
+/*
+    Compares the params field by field. The binary form keeps everything
+    except the style, which it stores as the resolved curve.
+*/
+void TestHbEffectBinaryFxml::compareParams(const QList<HbEffectFxmlParamData> &expected,
+                                           const QList<HbEffectFxmlParamData> &actual)
+{
+    QCOMPARE(actual.count(), expected.count());
+    for (int i = 0; i < expected.count(); ++i) {
+        const HbEffectFxmlParamData &e = expected.at(i);
+        const HbEffectFxmlParamData &a = actual.at(i);
+        QCOMPARE(a.name(), e.name());
+        QCOMPARE(a.getValue(), e.getValue());
+        QCOMPARE(a.durationMsecs(), e.durationMsecs());
+        QCOMPARE(a.curveShape(), e.curveShape());
+        QCOMPARE(a.startRef(), e.startRef());
+        QCOMPARE(a.endRef(), e.endRef());
+        QCOMPARE(a.loopDefined(), e.loopDefined());
+        QCOMPARE(a.loopStart(), e.loopStart());
+        QCOMPARE(a.loopEnd(), e.loopEnd());
+        QCOMPARE(a.getAttribute("ref"), e.getAttribute("ref"));
+        QCOMPARE(a.getAttribute("start"), e.getAttribute("start"));
+        QCOMPARE(a.getAttribute("end"), e.getAttribute("end"));
+        QList<HbKeyFrame> eFrames = e.keyFrames();
+        QList<HbKeyFrame> aFrames = a.keyFrames();
+        QCOMPARE(aFrames.count(), eFrames.count());
+        for (int j = 0; j < eFrames.count(); ++j) {
+            QCOMPARE(aFrames.at(j).pos, eFrames.at(j).pos);
+            QCOMPARE(QString(aFrames.at(j).stringValue), QString(eFrames.at(j).stringValue));
+            if (QString(eFrames.at(j).stringValue).isEmpty()) {
+                QCOMPARE(aFrames.at(j).val, eFrames.at(j).val);
+            }
+        }
+    }
+}
+
+void TestHbEffectBinaryFxml::roundTripMatchesParser()
+{
+    QVERIFY(HbEffectBinaryFxml::isBinary(reinterpret_cast<const uchar *>(mBinary.constData()),
+                                         mBinary.size()));
+    HbEffectFxmlData read;
+    QVERIFY(HbEffectBinaryFxml::read(reinterpret_cast<const uchar *>(mBinary.constData()),
+                                     mBinary.size(), &read));
+
+    QCOMPARE(mParsed->paramData().count(), 3);
+    compareParams(mParsed->paramData(), read.paramData());
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+
+    QList<HbEffectFxmlFilterData> expected = mParsed->filterData();
+    QList<HbEffectFxmlFilterData> actual = read.filterData();
+    QCOMPARE(actual.count(), expected.count());
+    for (int i = 0; i < expected.count(); ++i) {
+        QCOMPARE(actual.at(i).type(), expected.at(i).type());
+        QCOMPARE(actual.at(i).blending(), expected.at(i).blending());
+        compareParams(expected.at(i).paramData(), actual.at(i).paramData());
+        if (QTest::currentTestFailed()) {
+            return;
+        }
+    }
+}
+
+void TestHbEffectBinaryFxml::durationsAndCurvesAreResolved()
+{
+    HbEffectFxmlData read;
+    QVERIFY(HbEffectBinaryFxml::read(reinterpret_cast<const uchar *>(mBinary.constData()),
+                                     mBinary.size(), &read));
+    QList<HbEffectFxmlParamData> params = read.paramData();
+    QCOMPARE(params.at(0).durationMsecs(), 300);
+    QCOMPARE(params.at(0).curveShape(), int(QEasingCurve::InQuad));
+    QCOMPARE(params.at(1).durationMsecs(), 1250);
+    QCOMPARE(params.at(1).curveShape(), int(QEasingCurve::OutBack));
+    QCOMPARE(params.at(2).durationMsecs(), -1);
+    QCOMPARE(params.at(2).curveShape(), -1);
+
+    // Nothing is left to parse when the effect is created.
+    QVERIFY(params.at(0).duration().isEmpty());
+    QVERIFY(params.at(0).getAttribute("style").isEmpty());
+    QVERIFY(params.at(1).loopDefined());
+    foreach (const HbEffectFxmlFilterData &filter, read.filterData()) {
+        QCOMPARE(filter.paramData().at(0).durationMsecs(), 500);
+    }
+}
+
+void TestHbEffectBinaryFxml::fxmlIsNotBinary()
+{
+    QVERIFY(!HbEffectBinaryFxml::isBinary(reinterpret_cast<const uchar *>(fxml), sizeof(fxml)));
+    QVERIFY(!HbEffectBinaryFxml::isBinary(0, 0));
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(fxml);
+    file.seek(0);
+    HbEffectFxmlData data;
+    bool isBinary = true;
+    QVERIFY(!HbEffectBinaryFxml::readFile(&file, &data, &isBinary));
+    QVERIFY(!isBinary);
+    QVERIFY(data.isNull());
+}
+
+void TestHbEffectBinaryFxml::readFile()
+{
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(mBinary);
+    file.seek(0);
+    HbEffectFxmlData data;
+    bool isBinary = false;
+    QVERIFY(HbEffectBinaryFxml::readFile(&file, &data, &isBinary));
+    QVERIFY(isBinary);
+    compareParams(mParsed->paramData(), data.paramData());
+}
+
+void TestHbEffectBinaryFxml::truncatedIsRejected()
+{
+    HbEffectFxmlData data;
+    QVERIFY(!HbEffectBinaryFxml::read(reinterpret_cast<const uchar *>(mBinary.constData()),
+                                      mBinary.size() - 8, &data));
+}
+
+QTEST_MAIN(TestHbEffectBinaryFxml)
+#include "unittest_hbeffectbinaryfxml.moc"
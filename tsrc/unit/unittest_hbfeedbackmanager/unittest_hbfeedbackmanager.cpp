@@ -0,0 +1,195 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <hbapplication.h>
+#include <hbwidget.h>
+#include <hbfeedbackengine.h>
+#include <hbfeedbackmanager.h>
+
+// Longer than the frame the continuous deltas are summed over.
+static const int KFrameWait = 40;
+
+/*
+    Engine that records the order of the interactions it receives.
+*/
+class TestEngine : public HbFeedbackEngine
+{
+public:
+    enum Call {
+        Continuous,
+        Stopped,
+        Instant
+    };
+
+    explicit TestEngine(HbFeedbackManager *manager)
+        : HbFeedbackEngine(manager)
+    {
+    }
+
+    QPointF totalDelta() const
+    {
+        QPointF total;
+        foreach (const QPointF &delta, deltas) {
+            total += delta;
+        }
+        return total;
+    }
+
+    QList<Call> calls;
+    QList<QPointF> deltas;
+
+protected:
+    void triggered(const HbWidget *widget, Hb::InstantInteraction interaction, Hb::InteractionModifiers modifiers)
+    {
+        Q_UNUSED(widget);
+        Q_UNUSED(interaction);
+        Q_UNUSED(modifiers);
+        calls.append(Instant);
+    }
+
+    void continuousTriggered(const HbWidget *widget, Hb::ContinuousInteraction interaction, QPointF delta)
+    {
+        Q_UNUSED(widget);
+        Q_UNUSED(interaction);
+        calls.append(Continuous);
+        deltas.append(delta);
+    }
+
+    void continuousStopped(const HbWidget *widget, Hb::ContinuousInteraction interaction)
+    {
+        Q_UNUSED(widget);
+        Q_UNUSED(interaction);
+        calls.append(Stopped);
+    }
+};
+
+class TestHbFeedbackManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void dragIsSummedPerFrame();
+    void stopFollowsFinalDelta();
+    void instantFollowsPendingDelta();
+    void deletedWidgetDropsDelta();
+
+private:
+    HbFeedbackManager *mManager;
+    TestEngine *mEngine;
+    HbWidget *mWidget;
+};
+
+void TestHbFeedbackManager::init()
+{
+    mManager = HbFeedbackManager::instance();
+    mEngine = new TestEngine(mManager);
+    mWidget = new HbWidget;
+}
+
+void TestHbFeedbackManager::cleanup()
+{
+    delete mWidget;
+    mWidget = 0;
+    delete mEngine;
+    mEngine = 0;
+}
+
+/*
+    Simulates a one second drag on a touch panel that reports at 120 Hz,
+    two moves for every frame of the display.
+*/
+void TestHbFeedbackManager::dragIsSummedPerFrame()
+{
+    const int frames = 60;
+    const int movesPerFrame = 2;
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int move = 0; move < movesPerFrame; ++move) {
+            mManager->continuousTriggered(mWidget, Hb::ContinuousDragged, QPointF(0, 1));
+        }
+        QTest::qWait(KFrameWait);
+    }
+    mManager->continuousStopped(mWidget, Hb::ContinuousDragged);
+
+    QVERIFY(mEngine->deltas.count() > 0);
+    QVERIFY(mEngine->deltas.count() <= frames);
+    QCOMPARE(mEngine->totalDelta(), QPointF(0, frames * movesPerFrame));
+    QCOMPARE(mEngine->calls.count(TestEngine::Stopped), 1);
+    QCOMPARE(mEngine->calls.last(), TestEngine::Stopped);
+}
+
+void TestHbFeedbackManager::stopFollowsFinalDelta()
+{
+    mManager->continuousTriggered(mWidget, Hb::ContinuousDragged, QPointF(2, 0));
+    mManager->continuousTriggered(mWidget, Hb::ContinuousDragged, QPointF(3, 0));
+    mManager->continuousStopped(mWidget, Hb::ContinuousDragged);
+
+    QCOMPARE(mEngine->calls.count(), 2);
+    QCOMPARE(mEngine->calls.at(0), TestEngine::Continuous);
+    QCOMPARE(mEngine->deltas.at(0), QPointF(5, 0));
+    QCOMPARE(mEngine->calls.at(1), TestEngine::Stopped);
+
+    // nothing is left to be delivered after the stop
+    QTest::qWait(KFrameWait);
+    QCOMPARE(mEngine->calls.count(), 2);
+}
+
+void TestHbFeedbackManager::instantFollowsPendingDelta()
+{
+    HbWidget other;
+    mManager->continuousTriggered(mWidget, Hb::ContinuousDragged, QPointF(0, 4));
+    mManager->triggered(&other, Hb::InstantDraggedOver);
+
+    QCOMPARE(mEngine->calls.count(), 2);
+    QCOMPARE(mEngine->calls.at(0), TestEngine::Continuous);
+    QCOMPARE(mEngine->deltas.at(0), QPointF(0, 4));
+    QCOMPARE(mEngine->calls.at(1), TestEngine::Instant);
+
+    mManager->continuousStopped(mWidget, Hb::ContinuousDragged);
+    QCOMPARE(mEngine->calls.count(), 3);
+    QCOMPARE(mEngine->calls.at(2), TestEngine::Stopped);
+}
+
+void TestHbFeedbackManager::deletedWidgetDropsDelta()
+{
+    mManager->continuousTriggered(mWidget, Hb::ContinuousDragged, QPointF(1, 1));
+    delete mWidget;
+    mWidget = 0;
+
+    QTest::qWait(KFrameWait);
+    QVERIFY(mEngine->calls.isEmpty());
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    TestHbFeedbackManager test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "unittest_hbfeedbackmanager.moc"
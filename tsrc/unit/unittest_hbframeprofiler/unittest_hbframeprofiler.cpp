@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QPainter>
+#include <hbapplication.h>
+#include <hbgraphicsscene.h>
+#include <hbwidget.h>
+#include <hbframeprofiler_p.h>
+
+class TestHbFrameProfiler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void cleanup();
+    void enabledFrameRecordsPhases();
+    void disabledFrameRecordsNothing();
+
+private:
+    void renderFrame();
+    QStringList recordedPhases();
+
+    QString mTraceFile;
+};
+
+void TestHbFrameProfiler::initTestCase()
+{
+    mTraceFile = QDir::temp().filePath("unittest_hbframeprofiler.json");
+}
+
+void TestHbFrameProfiler::cleanupTestCase()
+{
+    QFile::remove(mTraceFile);
+}
+
+void TestHbFrameProfiler::cleanup()
+{
+    HbFrameProfiler::setEnabled(false);
+    HbFrameProfiler::clear();
+}
+
+/*
+    Renders one frame of a scene with a widget that still needs polishing.
+    Rendering goes through the same drawBackground(), drawItems() and
+    drawForeground() calls as a view with indirect painting.
+*/
+void TestHbFrameProfiler::renderFrame()
+{
+    HbGraphicsScene scene;
+    HbWidget *widget = new HbWidget;
+    widget->setGeometry(QRectF(0, 0, 100, 100));
+    scene.addItem(widget);
+
+    QImage image(100, 100, QImage::Format_ARGB32_Premultiplied);
+    image.fill(0);
+    QPainter painter(&image);
+    scene.render(&painter);
+}
+
+/*
+    Returns the phase names of the recorded events, in the order of the trace.
+*/
+QStringList TestHbFrameProfiler::recordedPhases()
+{
+    QStringList phases;
+    if (!HbFrameProfiler::exportTrace(mTraceFile)) {
+        return phases;
+    }
+    QFile file(mTraceFile);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return phases;
+    }
+    QString trace = QString::fromUtf8(file.readAll());
+    QRegExp name("\"name\":\"([A-Za-z]+)\"");
+    for (int pos = name.indexIn(trace); pos >= 0; pos = name.indexIn(trace, pos + name.matchedLength())) {
+        phases.append(name.cap(1));
+    }
+    return phases;
+}
+
+void TestHbFrameProfiler::enabledFrameRecordsPhases()
+{
+    HbFrameProfiler::setEnabled(true);
+    HbFrameProfiler::clear();
+    renderFrame();
+
+    QStringList phases = recordedPhases();
+    QCOMPARE(phases.count("frame"), 1);
+    QCOMPARE(phases.count("polish"), 1);
+    QCOMPARE(phases.count("layoutRequest"), 1);
+    QCOMPARE(phases.count("paint"), 1);
+
+    // The item painting lies inside the frame.
+    QVERIFY(phases.indexOf("paint") < phases.indexOf("frame"));
+    QVERIFY(phases.indexOf("layoutRequest") < phases.indexOf("paint"));
+}
+
+void TestHbFrameProfiler::disabledFrameRecordsNothing()
+{
+    HbFrameProfiler::setEnabled(true);
+    HbFrameProfiler::setEnabled(false);
+    HbFrameProfiler::clear();
+    QVERIFY(!HbFrameProfiler::isEnabled());
+    renderFrame();
+
+    // An empty trace is still written.
+    QVERIFY(HbFrameProfiler::exportTrace(mTraceFile));
+    QCOMPARE(recordedPhases(), QStringList());
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    TestHbFrameProfiler test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "unittest_hbframeprofiler.moc"
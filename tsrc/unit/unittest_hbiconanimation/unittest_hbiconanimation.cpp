@@ -0,0 +1,146 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QPainter>
+#include <hbapplication.h>
+#include <hbicon.h>
+#include <hbiconanimator.h>
+#include <hbiconanimationmanager.h>
+
+/*
+    A 4x4 GIF with two frames of 20 ms each.
+*/
+static const uchar twoFrameGif[] = {
+    0x47, 0x49, 0x46, 0x38, 0x39, 0x61, 0x04, 0x00, 0x04, 0x00, 0xf1, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
+    0xff, 0x21, 0xff, 0x0b, 0x4e, 0x45, 0x54, 0x53, 0x43, 0x41, 0x50, 0x45,
+    0x32, 0x2e, 0x30, 0x03, 0x01, 0x00, 0x00, 0x00, 0x21, 0xf9, 0x04, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04,
+    0x00, 0x00, 0x02, 0x0a, 0x4c, 0x98, 0x30, 0x61, 0xc2, 0x84, 0x09, 0x13,
+    0x26, 0x05, 0x00, 0x21, 0xf9, 0x04, 0x00, 0x02, 0x00, 0x00, 0x00, 0x2c,
+    0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x02, 0x0a, 0x94,
+    0x28, 0x51, 0xa2, 0x44, 0x89, 0x12, 0x25, 0x4a, 0x05, 0x00, 0x3b
+};
+
+class TestHbIconAnimation : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void loopRestartHitsFrameCache();
+    void secondAnimatorHitsFrameCache();
+
+private:
+    bool play(HbIconAnimator &animator, const QSizeF &size, int loopCount);
+
+    QString mFileName;
+};
+
+void TestHbIconAnimation::initTestCase()
+{
+    mFileName = QDir::temp().filePath("unittest_hbiconanimation.gif");
+    QFile file(mFileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(reinterpret_cast<const char *>(twoFrameGif), sizeof(twoFrameGif));
+}
+
+void TestHbIconAnimation::cleanupTestCase()
+{
+    QFile::remove(mFileName);
+}
+
+/*
+    Paints the test animation at \a size with \a animator and waits until it
+    finishes. After the first pass the animation restarts \a loopCount times.
+    Returns false if the animation did not finish.
+*/
+bool TestHbIconAnimation::play(HbIconAnimator &animator, const QSizeF &size, int loopCount)
+{
+    HbIcon icon(mFileName);
+    icon.setSize(size);
+    animator.setIcon(icon);
+    animator.setLoopCount(loopCount);
+
+    QSignalSpy finished(&animator, SIGNAL(animationFinished()));
+    QImage image(size.toSize(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(0);
+    QPainter painter(&image);
+    // The first paint creates the animation, the second one applies the loop count.
+    animator.paint(&painter, QRectF(QPointF(), size));
+    animator.paint(&painter, QRectF(QPointF(), size));
+    for (int i = 0; i < 100 && finished.isEmpty(); ++i) {
+        QTest::qWait(20);
+    }
+    return !finished.isEmpty();
+}
+
+void TestHbIconAnimation::loopRestartHitsFrameCache()
+{
+    HbIconAnimationManager *manager = HbIconAnimationManager::global();
+    int hits = manager->frameCacheHits();
+    int misses = manager->frameCacheMisses();
+
+    // The first pass decodes the frames, the restarted loop plays them from the cache.
+    HbIconAnimator animator;
+    QVERIFY(play(animator, QSizeF(16, 16), 1));
+    QCOMPARE(manager->frameCacheMisses() - misses, 1);
+    QCOMPARE(manager->frameCacheHits() - hits, 1);
+}
+
+void TestHbIconAnimation::secondAnimatorHitsFrameCache()
+{
+    HbIconAnimationManager *manager = HbIconAnimationManager::global();
+    int hits = manager->frameCacheHits();
+    int misses = manager->frameCacheMisses();
+
+    HbIconAnimator first;
+    QVERIFY(play(first, QSizeF(24, 24), 0));
+    QCOMPARE(manager->frameCacheMisses() - misses, 1);
+    QCOMPARE(manager->frameCacheHits() - hits, 0);
+
+    // Another animator of the same icon at the same size shares the frames.
+    HbIconAnimator second;
+    QVERIFY(play(second, QSizeF(24, 24), 0));
+    QCOMPARE(manager->frameCacheMisses() - misses, 1);
+    QCOMPARE(manager->frameCacheHits() - hits, 1);
+
+    // A different size does not.
+    HbIconAnimator third;
+    QVERIFY(play(third, QSizeF(32, 32), 0));
+    QCOMPARE(manager->frameCacheMisses() - misses, 2);
+    QCOMPARE(manager->frameCacheHits() - hits, 1);
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    TestHbIconAnimation test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "unittest_hbiconanimation.moc"
@@ -0,0 +1,261 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <hbapplication.h>
+#include <hbinputbutton.h>
+#include <hbinputbuttongroup.h>
+#include <hbinputbuttongroup_p.h>
+
+static const QSize groupGrid(4, 3);
+static const QSize groupSize(360, 180);
+
+/*
+    Button group created with the protected constructor, so that the test
+    keeps a pointer to the private data.
+*/
+class TestButtonGroup : public HbInputButtonGroup
+{
+public:
+    explicit TestButtonGroup(HbInputButtonGroupPrivate *d)
+        : HbInputButtonGroup(*d, groupGrid), d(d)
+    {
+    }
+
+    using HbInputButtonGroup::paint;
+
+    HbInputButtonGroupPrivate *d;
+};
+
+static QImage emptyImage()
+{
+    QImage image(groupSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(0);
+    return image;
+}
+
+/*
+    Paints \a group into \a image the way the view does after the area
+    \a exposed has been updated.
+*/
+static void paintGroup(TestButtonGroup *group, QImage &image, const QRectF &exposed)
+{
+    QStyleOptionGraphicsItem option;
+    option.exposedRect = exposed;
+    QPainter painter(&image);
+    painter.setClipRect(exposed);
+    group->paint(&painter, &option, 0);
+}
+
+/*
+    Paints all of \a group without the cached layer, as paint() did before
+    the layer was added.
+*/
+static QImage paintDirectly(TestButtonGroup *group)
+{
+    QImage image = emptyImage();
+    QPainter painter(&image);
+    group->d->paintContent(&painter, QRectF(QPointF(0, 0), groupSize));
+    return image;
+}
+
+/*
+    Returns true if the pixels of \a a and \a b differ by at most \a tolerance
+    in every channel, ignoring \a ignored.
+*/
+static bool fuzzyCompare(const QImage &a, const QImage &b, int tolerance, const QRect &ignored = QRect())
+{
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            if (ignored.contains(x, y)) {
+                continue;
+            }
+            QRgb pa = a.pixel(x, y);
+            QRgb pb = b.pixel(x, y);
+            if (qAbs(qRed(pa) - qRed(pb)) > tolerance || qAbs(qGreen(pa) - qGreen(pb)) > tolerance
+                || qAbs(qBlue(pa) - qBlue(pb)) > tolerance || qAbs(qAlpha(pa) - qAlpha(pb)) > tolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+class TestHbInputButtonGroup : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void layerMatchesDirectPaint();
+    void pressRepaintsOnlyButton();
+    void releaseRestoresButton();
+    void changesInvalidateLayer();
+    void scaledPaintBypassesLayer();
+
+private:
+    QPointF buttonCenter(int index) const;
+
+    TestButtonGroup *mGroup;
+};
+
+void TestHbInputButtonGroup::init()
+{
+    mGroup = new TestButtonGroup(new HbInputButtonGroupPrivate);
+    QList<HbInputButton *> buttons;
+    for (int i = 0; i < groupGrid.width() * groupGrid.height(); ++i) {
+        HbInputButton *button = new HbInputButton('a' + i, QPoint(i % groupGrid.width(), i / groupGrid.width()));
+        button->setText(QString(QChar('a' + i)), HbInputButton::ButtonTextIndexPrimary);
+        buttons.append(button);
+    }
+    mGroup->setButtons(buttons);
+    mGroup->setGeometry(QRectF(QPointF(0, 0), groupSize));
+}
+
+void TestHbInputButtonGroup::cleanup()
+{
+    delete mGroup;
+    mGroup = 0;
+}
+
+QPointF TestHbInputButtonGroup::buttonCenter(int index) const
+{
+    return mGroup->button(index)->boundingRect().center();
+}
+
+void TestHbInputButtonGroup::layerMatchesDirectPaint()
+{
+    QImage cached = emptyImage();
+    paintGroup(mGroup, cached, QRectF(QPointF(0, 0), groupSize));
+    QVERIFY(mGroup->d->mLayerValid);
+
+    QVERIFY(fuzzyCompare(cached, paintDirectly(mGroup), 1));
+}
+
+void TestHbInputButtonGroup::pressRepaintsOnlyButton()
+{
+    HbInputButtonGroupPrivate *d = mGroup->d;
+    QImage image = emptyImage();
+    paintGroup(mGroup, image, QRectF(QPointF(0, 0), groupSize));
+    QImage before = image;
+
+    const int index = 5;
+    d->pressEvent(buttonCenter(index), false);
+    QCOMPARE(mGroup->button(index)->state(), HbInputButton::ButtonStatePressed);
+    QCOMPARE(d->mDirtyButtons, QList<int>() << index);
+    QVERIFY(d->mLayerValid);
+
+    // Only the rectangle of the pressed button is exposed and painted again.
+    QRectF buttonRect = mGroup->button(index)->boundingRect();
+    paintGroup(mGroup, image, buttonRect);
+    QVERIFY(d->mDirtyButtons.isEmpty());
+    QVERIFY(d->mLayerValid);
+
+    QVERIFY(fuzzyCompare(image, paintDirectly(mGroup), 1));
+    QVERIFY(fuzzyCompare(image, before, 0, buttonRect.toAlignedRect()));
+}
+
+void TestHbInputButtonGroup::releaseRestoresButton()
+{
+    HbInputButtonGroupPrivate *d = mGroup->d;
+    QImage image = emptyImage();
+    paintGroup(mGroup, image, QRectF(QPointF(0, 0), groupSize));
+    QImage before = image;
+
+    const int index = 2;
+    QRectF buttonRect = mGroup->button(index)->boundingRect();
+    d->pressEvent(buttonCenter(index), false);
+    paintGroup(mGroup, image, buttonRect);
+    d->releaseEvent(buttonCenter(index), false);
+    QCOMPARE(mGroup->button(index)->state(), HbInputButton::ButtonStateReleased);
+    paintGroup(mGroup, image, buttonRect);
+
+    QVERIFY(fuzzyCompare(image, before, 1));
+}
+
+void TestHbInputButtonGroup::changesInvalidateLayer()
+{
+    HbInputButtonGroupPrivate *d = mGroup->d;
+    QImage image = emptyImage();
+
+    paintGroup(mGroup, image, QRectF(QPointF(0, 0), groupSize));
+    QVERIFY(d->mLayerValid);
+    mGroup->button(0)->setText("x", HbInputButton::ButtonTextIndexPrimary);
+    mGroup->setButtons(mGroup->buttons());
+    QVERIFY(!d->mLayerValid);
+
+    // The new text is in the layer after the next paint.
+    image = emptyImage();
+    paintGroup(mGroup, image, QRectF(QPointF(0, 0), groupSize));
+    QVERIFY(d->mLayerValid);
+    QVERIFY(fuzzyCompare(image, paintDirectly(mGroup), 1));
+
+    mGroup->setEnabled(false);
+    QVERIFY(!d->mLayerValid);
+    paintGroup(mGroup, image, QRectF(QPointF(0, 0), groupSize));
+
+    mGroup->setFontSize(HbInputButtonGroup::ButtonTextTypeSingle, 2 * mGroup->fontSize(HbInputButtonGroup::ButtonTextTypeSingle));
+    QVERIFY(!d->mLayerValid);
+    paintGroup(mGroup, image, QRectF(QPointF(0, 0), groupSize));
+    QVERIFY(d->mLayerValid);
+}
+
+void TestHbInputButtonGroup::scaledPaintBypassesLayer()
+{
+    HbInputButtonGroupPrivate *d = mGroup->d;
+
+    QImage scaled(groupSize * 2, QImage::Format_ARGB32_Premultiplied);
+    scaled.fill(0);
+    {
+        QStyleOptionGraphicsItem option;
+        option.exposedRect = QRectF(QPointF(0, 0), groupSize);
+        QPainter painter(&scaled);
+        painter.scale(2, 2);
+        mGroup->paint(&painter, &option, 0);
+    }
+    QVERIFY(!d->mLayerValid);
+
+    QImage direct(groupSize * 2, QImage::Format_ARGB32_Premultiplied);
+    direct.fill(0);
+    {
+        QPainter painter(&direct);
+        painter.scale(2, 2);
+        d->paintContent(&painter, QRectF(QPointF(0, 0), groupSize));
+    }
+    QVERIFY(fuzzyCompare(scaled, direct, 0));
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    TestHbInputButtonGroup test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "unittest_hbinputbuttongroup.moc"
@@ -0,0 +1,213 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QThread>
+#include <hbapplication.h>
+#include <hbinputsettingproxy.h>
+#include <hbinputsettingproxy_p.h>
+
+static const int customDataLengthA = 100;
+static const int customDataLengthB = 128;
+
+/*
+    Returns true if \a data is one of the two values the writer stores,
+    and not a mix of them.
+*/
+static bool isWrittenValue(const QByteArray &data)
+{
+    if (data == QByteArray(customDataLengthA, 'a')) {
+        return true;
+    }
+    return data == QByteArray(customDataLengthB, 'b');
+}
+
+/*
+    Keeps rewriting the custom data of the preferred horizontal input method
+    through its own attachment to the shared memory, taking the lock like the
+    setters of HbInputSettingProxy do.
+*/
+class SettingsWriter : public QThread
+{
+public:
+    SettingsWriter() : mStop(0), mWrites(0) {}
+
+    void stop() {
+        mStop.fetchAndStoreOrdered(1);
+    }
+
+    int writes() {
+        return mWrites.fetchAndAddOrdered(0);
+    }
+
+protected:
+    void run() {
+        HbInputSettingProxyPrivate writer;
+        HbSettingProxyInternalData *prData = writer.proxyData();
+        if (!prData) {
+            return;
+        }
+        while (!mStop.fetchAndAddOrdered(0)) {
+            writer.lock();
+            if (mWrites.fetchAndAddOrdered(0) & 1) {
+                prData->preferredMethodHorizontal.setData(QByteArray(customDataLengthA, 'a'));
+            } else {
+                prData->preferredMethodHorizontal.setData(QByteArray(customDataLengthB, 'b'));
+            }
+            writer.unlock();
+            mWrites.fetchAndAddOrdered(1);
+        }
+    }
+
+private:
+    QAtomicInt mStop;
+    QAtomicInt mWrites;
+};
+
+class TestHbInputSettingProxy : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void dataVersion();
+    void writeAdvancesSequence();
+    void loadKeepsSequence();
+    void deadWriterFallsBackToLock();
+    void consistentUnderConcurrentWriter();
+
+private:
+    HbInputSettingProxyPrivate *mPrivate;
+    HbSettingProxyInternalData *mData;
+};
+
+void TestHbInputSettingProxy::initTestCase()
+{
+    // Creates the shared memory block if there is no input server.
+    HbInputSettingProxy::instance();
+    mPrivate = new HbInputSettingProxyPrivate;
+    mData = mPrivate->proxyData();
+    if (!mData) {
+        QSKIP("The input settings shared memory is not available", SkipAll);
+    }
+}
+
+void TestHbInputSettingProxy::dataVersion()
+{
+    QCOMPARE(HbProxyDataRequiredVersion, 26);
+    QCOMPARE(mData->version, HbProxyDataRequiredVersion);
+    QCOMPARE(int(mData->sequence) & 1, 0);
+}
+
+void TestHbInputSettingProxy::writeAdvancesSequence()
+{
+    HbInputSettingProxy *proxy = HbInputSettingProxy::instance();
+    HbInputLanguage original = proxy->globalInputLanguage();
+    HbInputLanguage other(original.language() == QLocale::Finnish ? QLocale::Swedish : QLocale::Finnish);
+
+    int sequence = mData->sequence;
+    mPrivate->lock();
+    QCOMPARE(int(mData->sequence), sequence + 1);
+    mPrivate->unlock();
+    QCOMPARE(int(mData->sequence), sequence + 2);
+
+    proxy->setGlobalInputLanguage(other);
+    QCOMPARE(int(mData->sequence), sequence + 4);
+    QCOMPARE(proxy->globalInputLanguage(), other);
+
+    proxy->setGlobalInputLanguage(original);
+    QCOMPARE(proxy->globalInputLanguage(), original);
+}
+
+void TestHbInputSettingProxy::loadKeepsSequence()
+{
+    HbSettingProxyInternalData *saved = new HbSettingProxyInternalData;
+    memcpy((void *)saved, (void *)mData, sizeof(HbSettingProxyInternalData));
+    saved->sequence = 12345;
+    HbInputSettingProxyPrivate::save(saved);
+    delete saved;
+
+    int sequence = mData->sequence;
+    mPrivate->lock();
+    bool loaded = HbInputSettingProxyPrivate::load(mData);
+    mPrivate->unlock();
+    QVERIFY(loaded);
+    QCOMPARE(int(mData->sequence), sequence + 2);
+}
+
+void TestHbInputSettingProxy::deadWriterFallsBackToLock()
+{
+    // A writer that died in the middle of an update leaves the sequence odd.
+    // The readers give up retrying and read under the lock, which makes the
+    // sequence even again.
+    HbInputSettingProxy *proxy = HbInputSettingProxy::instance();
+    HbInputMethodDescriptor original = proxy->preferredInputMethod(Qt::Vertical);
+
+    HbInputSettingProxyPrivate::beginWrite(mData);
+    QVERIFY(int(mData->sequence) & 1);
+    HbInputMethodDescriptor result = proxy->preferredInputMethod(Qt::Vertical);
+    QCOMPARE(result.pluginNameAndPath(), original.pluginNameAndPath());
+    QCOMPARE(result.key(), original.key());
+    QCOMPARE(int(mData->sequence) & 1, 0);
+}
+
+void TestHbInputSettingProxy::consistentUnderConcurrentWriter()
+{
+    HbInputSettingProxy *proxy = HbInputSettingProxy::instance();
+    QByteArray original = proxy->preferredInputMethodCustomData(Qt::Horizontal);
+
+    SettingsWriter writer;
+    writer.start();
+    while (writer.isRunning() && writer.writes() < 2) {
+        QThread::yieldCurrentThread();
+    }
+
+    int torn = 0;
+    for (int i = 0; i < 20000; ++i) {
+        if (!isWrittenValue(proxy->preferredInputMethodCustomData(Qt::Horizontal))) {
+            ++torn;
+        }
+    }
+    writer.stop();
+    writer.wait();
+
+    QVERIFY(writer.writes() > 2);
+    QCOMPARE(torn, 0);
+    QCOMPARE(int(mData->sequence) & 1, 0);
+
+    mPrivate->lock();
+    mData->preferredMethodHorizontal.setData(original);
+    mPrivate->unlock();
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    TestHbInputSettingProxy test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "unittest_hbinputsettingproxy.moc"
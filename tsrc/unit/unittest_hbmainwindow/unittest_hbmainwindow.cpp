@@ -0,0 +1,204 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QGraphicsScene>
+#include <hbapplication.h>
+#include <hbmainwindow.h>
+#include <hbmainwindow_p.h>
+#include <hbview.h>
+#include <hbwidget.h>
+
+static const int KBroadcastEvent = QEvent::registerEventType();
+static const int KSliceBudget = 16;
+static const int KRootWidgetCount = 300;
+// Time each widget spends handling the event, in milliseconds
+static const int KHandlingTime = 1;
+
+/*
+    Widget that records when it got the broadcast event.
+*/
+class ProbeWidget : public HbWidget
+{
+public:
+    explicit ProbeWidget(QGraphicsItem *parent = 0)
+        : HbWidget(parent), received(0), order(-1)
+    {
+    }
+
+    int received;
+    int order;
+    static int nextOrder;
+
+protected:
+    bool event(QEvent *e)
+    {
+        if (e->type() == KBroadcastEvent) {
+            ++received;
+            order = nextOrder++;
+            QElapsedTimer timer;
+            timer.start();
+            while (timer.elapsed() < KHandlingTime) {
+            }
+            return true;
+        }
+        return HbWidget::event(e);
+    }
+};
+
+int ProbeWidget::nextOrder = 0;
+
+class TestHbMainWindow : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void broadcastIsSliced();
+    void visibleWidgetsFirst();
+
+private:
+    bool waitForBroadcast(QSignalSpy *spy);
+
+    HbMainWindow *mWindow;
+    ProbeWidget *mContent;
+    QList<ProbeWidget *> mRootWidgets;
+    int mDefaultBudget;
+};
+
+void TestHbMainWindow::initTestCase()
+{
+    mDefaultBudget = HbMainWindowPrivate::broadcastSliceBudget;
+    HbMainWindowPrivate::broadcastSliceBudget = KSliceBudget;
+    mWindow = new HbMainWindow;
+    mContent = new ProbeWidget;
+    mWindow->addView(mContent);
+    mWindow->show();
+    QTest::qWaitForWindowShown(mWindow);
+}
+
+void TestHbMainWindow::cleanupTestCase()
+{
+    delete mWindow;
+    mWindow = 0;
+    HbMainWindowPrivate::broadcastSliceBudget = mDefaultBudget;
+}
+
+void TestHbMainWindow::init()
+{
+    for (int i = 0; i < KRootWidgetCount; ++i) {
+        ProbeWidget *widget = new ProbeWidget;
+        widget->setGeometry(QRectF(i % 10 * 10, i / 10 * 10, 10, 10));
+        mWindow->scene()->addItem(widget);
+        mRootWidgets.append(widget);
+    }
+    mContent->received = 0;
+    ProbeWidget::nextOrder = 0;
+}
+
+void TestHbMainWindow::cleanup()
+{
+    qDeleteAll(mRootWidgets);
+    mRootWidgets.clear();
+}
+
+bool TestHbMainWindow::waitForBroadcast(QSignalSpy *spy)
+{
+    QElapsedTimer timeout;
+    timeout.start();
+    while (spy->isEmpty() && timeout.elapsed() < 10000) {
+        QTest::qWait(10);
+    }
+    return !spy->isEmpty();
+}
+
+/*
+    The current view gets the event before broadcastEvent() returns, the
+    rest in slices, so the first slice is much shorter than the broadcast.
+*/
+void TestHbMainWindow::broadcastIsSliced()
+{
+    QSignalSpy spy(HbMainWindowPrivate::d_ptr(mWindow), SIGNAL(broadcastFinished(int)));
+    QElapsedTimer timer;
+    timer.start();
+    mWindow->broadcastEvent(KBroadcastEvent);
+    qint64 firstSlice = timer.elapsed();
+
+    QCOMPARE(mContent->received, 1);
+    int informed = 0;
+    foreach (ProbeWidget *widget, mRootWidgets) {
+        informed += widget->received;
+    }
+    QVERIFY(informed < KRootWidgetCount);
+
+    QVERIFY(waitForBroadcast(&spy));
+    qint64 total = timer.elapsed();
+    QCOMPARE(spy.at(0).at(0).toInt(), KBroadcastEvent);
+    foreach (ProbeWidget *widget, mRootWidgets) {
+        QCOMPARE(widget->received, 1);
+    }
+    QCOMPARE(mContent->received, 1);
+
+    qDebug() << "first slice" << firstSlice << "ms, whole broadcast" << total << "ms";
+    QVERIFY(total >= KRootWidgetCount * KHandlingTime);
+    QVERIFY(firstSlice * 4 < total);
+}
+
+void TestHbMainWindow::visibleWidgetsFirst()
+{
+    for (int i = 0; i < KRootWidgetCount; i += 2) {
+        mRootWidgets.at(i)->hide();
+    }
+
+    QSignalSpy spy(HbMainWindowPrivate::d_ptr(mWindow), SIGNAL(broadcastFinished(int)));
+    mWindow->broadcastEvent(KBroadcastEvent);
+    QVERIFY(waitForBroadcast(&spy));
+
+    QCOMPARE(mContent->order, 0);
+    int lastVisible = -1;
+    int firstHidden = ProbeWidget::nextOrder;
+    foreach (ProbeWidget *widget, mRootWidgets) {
+        QCOMPARE(widget->received, 1);
+        if (widget->isVisible()) {
+            lastVisible = qMax(lastVisible, widget->order);
+        } else {
+            firstHidden = qMin(firstHidden, widget->order);
+        }
+    }
+    QVERIFY(lastVisible < firstHidden);
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    TestHbMainWindow test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "unittest_hbmainwindow.moc"
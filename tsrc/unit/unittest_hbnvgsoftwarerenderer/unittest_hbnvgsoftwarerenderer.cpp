@@ -0,0 +1,434 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QPainter>
+#include <QPainterPath>
+#include <string.h>
+#include <hbnvgsoftwarerenderer_p.h>
+
+/*
+    Writes NVG-CS data with 16 bit path coordinates: the header with the view
+    box, the offset vector of the sections and the command list, followed by
+    the sections.
+*/
+class NvgWriter
+{
+public:
+    NvgWriter(const QRectF &viewBox) : mViewBox(viewBox), mExtraWords(0) {}
+
+    int addFlatPaint(QRgb color)
+    {
+        QByteArray section;
+        appendWord(section, 1); // flat paint
+        appendWord(section, quint32(qRed(color)) << 24 | qGreen(color) << 16
+                            | qBlue(color) << 8 | qAlpha(color));
+        return addSection(section);
+    }
+
+    int addLinearGradient(const QPointF &start, const QPointF &end)
+    {
+        QByteArray section;
+        appendWord(section, 2); // linear gradient without a paint transformation
+        appendReal(section, start.x());
+        appendReal(section, start.y());
+        appendReal(section, end.x());
+        appendReal(section, end.y());
+        return addSection(section);
+    }
+
+    int addColorRamp(const QGradientStops &stops)
+    {
+        QByteArray section;
+        appendWord(section, quint32(stops.count()) << 16);
+        foreach (const QGradientStop &stop, stops) {
+            appendReal(section, stop.first);
+            appendReal(section, stop.second.redF());
+            appendReal(section, stop.second.greenF());
+            appendReal(section, stop.second.blueF());
+            appendReal(section, stop.second.alphaF());
+        }
+        return addSection(section);
+    }
+
+    // Segments are OpenVG segment commands, coords are in view box units.
+    int addPath(const QList<quint8> &segments, const QList<qreal> &coords)
+    {
+        QByteArray section;
+        quint16 count = segments.count();
+        section.append(reinterpret_cast<const char *>(&count), sizeof(count));
+        foreach (quint8 segment, segments) {
+            section.append(char(segment));
+        }
+        if (section.size() & 1) {
+            section.append('\0');
+        }
+        foreach (qreal coord, coords) {
+            qint16 value = qRound(coord * 16);
+            section.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        }
+        return addSection(section);
+    }
+
+    void command(quint32 command, int section = 0) { mCommands.append(command | section); }
+    void commandWord(quint32 word) { mCommands.append(word); ++mExtraWords; }
+    void commandReal(float value)
+    {
+        quint32 word;
+        memcpy(&word, &value, sizeof(word));
+        commandWord(word);
+    }
+
+    QByteArray data() const
+    {
+        const int headerSize = 56;
+        QByteArray data(headerSize, '\0');
+        memcpy(data.data(), "nvg", 3);
+        data[3] = 1; // version
+        const quint16 size = headerSize;
+        memcpy(data.data() + 4, &size, sizeof(size));
+        const qint16 pathDataType = 2; // 16 bit coordinates
+        memcpy(data.data() + 26, &pathDataType, sizeof(pathDataType));
+        const float viewBox[4] = { float(mViewBox.x()), float(mViewBox.y()),
+                                   float(mViewBox.width()), float(mViewBox.height()) };
+        memcpy(data.data() + 36, viewBox, sizeof(viewBox));
+
+        int sectionStart = headerSize + 2 + 2 * mSections.count() + 2 + 4 * mCommands.count();
+        sectionStart = (sectionStart + 3) & ~3;
+
+        quint16 sectionCount = mSections.count();
+        data.append(reinterpret_cast<const char *>(&sectionCount), sizeof(sectionCount));
+        int offset = sectionStart;
+        foreach (const QByteArray &section, mSections) {
+            quint16 value = offset;
+            data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+            offset += (section.size() + 3) & ~3;
+        }
+        quint16 commandCount = mCommands.count() - mExtraWords;
+        data.append(reinterpret_cast<const char *>(&commandCount), sizeof(commandCount));
+        foreach (quint32 command, mCommands) {
+            data.append(reinterpret_cast<const char *>(&command), sizeof(command));
+        }
+        data.append(QByteArray(sectionStart - data.size(), '\0'));
+        foreach (const QByteArray &section, mSections) {
+            data.append(section);
+            data.append(QByteArray(((section.size() + 3) & ~3) - section.size(), '\0'));
+        }
+        return data;
+    }
+
+private:
+    int addSection(const QByteArray &section)
+    {
+        mSections.append(section);
+        return mSections.count() - 1;
+    }
+
+    static void appendWord(QByteArray &data, quint32 word)
+    {
+        data.append(reinterpret_cast<const char *>(&word), sizeof(word));
+    }
+
+    static void appendReal(QByteArray &data, qreal value)
+    {
+        float f = value;
+        data.append(reinterpret_cast<const char *>(&f), sizeof(f));
+    }
+
+    QRectF mViewBox;
+    QList<QByteArray> mSections;
+    QList<quint32> mCommands;
+    int mExtraWords;
+};
+
+static const quint32 cmdSetFillPaint = 4 << 24;
+static const quint32 cmdSetStrokePaint = 5 << 24;
+static const quint32 cmdSetColorRamp = 6 << 24;
+static const quint32 cmdDrawPath = 7 << 24;
+static const quint32 cmdSetTransformation = 8 << 24;
+static const quint32 cmdSetStrokeWidth = 9 << 24;
+static const quint32 opaque = 0xff << 16;
+static const quint32 fillPath = 0x00020000;
+static const quint32 strokePath = 0x00010000;
+
+enum {
+    Close = 0,
+    MoveTo = 2,
+    LineTo = 4,
+    SCCWArcTo = 18
+};
+
+static QImage referenceImage(const QSize &size)
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(0);
+    return image;
+}
+
+// Number of pixels in which any channel differs by more than tolerance.
+static int differingPixels(const QImage &a, const QImage &b, int tolerance)
+{
+    int count = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            QRgb p = a.pixel(x, y);
+            QRgb q = b.pixel(x, y);
+            if (qAbs(qRed(p) - qRed(q)) > tolerance || qAbs(qGreen(p) - qGreen(q)) > tolerance
+                || qAbs(qBlue(p) - qBlue(q)) > tolerance || qAbs(qAlpha(p) - qAlpha(q)) > tolerance) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+// The square of squareSegments() as the renderer builds it.
+static QPainterPath squarePath()
+{
+    QPainterPath square;
+    square.setFillRule(Qt::WindingFill);
+    square.moveTo(2, 2);
+    square.lineTo(8, 2);
+    square.lineTo(8, 8);
+    square.lineTo(2, 8);
+    square.closeSubpath();
+    return square;
+}
+
+static QList<quint8> squareSegments()
+{
+    return QList<quint8>() << MoveTo << LineTo << LineTo << LineTo << Close;
+}
+
+static QList<qreal> squareCoords()
+{
+    return QList<qreal>() << 2 << 2 << 8 << 2 << 8 << 8 << 2 << 8;
+}
+
+/*
+    The expected images are drawn with QPainter from the same geometry. Paths
+    drawn the same way must match exactly, pixel aligned rectangles within
+    rounding, and arcs, which the renderer turns into its own curves, on the
+    anti-aliased edge only.
+*/
+class TestHbNvgSoftwareRenderer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void flatFill_data();
+    void flatFill();
+    void stroke();
+    void linearGradient();
+    void transformation();
+    void arcs();
+    void badData_data();
+    void badData();
+};
+
+void TestHbNvgSoftwareRenderer::flatFill_data()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<int>("mode");
+    QTest::addColumn<QRectF>("expectedRect");
+
+    QTest::newRow("scaled") << QSize(40, 40) << int(Qt::IgnoreAspectRatio) << QRectF(8, 8, 24, 24);
+    QTest::newRow("stretched") << QSize(80, 40) << int(Qt::IgnoreAspectRatio) << QRectF(16, 8, 48, 24);
+    QTest::newRow("centered") << QSize(80, 40) << int(Qt::KeepAspectRatio) << QRectF(28, 8, 24, 24);
+    QTest::newRow("expanded") << QSize(20, 40) << int(Qt::KeepAspectRatioByExpanding) << QRectF(-2, 8, 24, 24);
+}
+
+void TestHbNvgSoftwareRenderer::flatFill()
+{
+    QFETCH(QSize, size);
+    QFETCH(int, mode);
+    QFETCH(QRectF, expectedRect);
+
+    NvgWriter nvg(QRectF(0, 0, 10, 10));
+    int paint = nvg.addFlatPaint(qRgb(255, 0, 0));
+    int path = nvg.addPath(squareSegments(), squareCoords());
+    nvg.command(cmdSetFillPaint | opaque, paint);
+    nvg.command(cmdDrawPath | fillPath, path);
+
+    QImage image;
+    HbNvgSoftwareRenderer renderer;
+    QVERIFY(renderer.rasterize(nvg.data(), size, Qt::AspectRatioMode(mode), image));
+    QCOMPARE(image.size(), size);
+
+    QImage expected = referenceImage(size);
+    QPainter painter(&expected);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(expectedRect, Qt::red);
+    painter.end();
+    QCOMPARE(differingPixels(image, expected, 1), 0);
+}
+
+void TestHbNvgSoftwareRenderer::stroke()
+{
+    NvgWriter nvg(QRectF(0, 0, 10, 10));
+    int fill = nvg.addFlatPaint(qRgb(0, 0, 255));
+    int stroke = nvg.addFlatPaint(qRgb(0, 128, 0));
+    int path = nvg.addPath(squareSegments(), squareCoords());
+    nvg.command(cmdSetFillPaint | opaque, fill);
+    nvg.command(cmdSetStrokePaint | opaque, stroke);
+    nvg.command(cmdSetStrokeWidth);
+    nvg.commandReal(1.5);
+    nvg.command(cmdDrawPath | fillPath | strokePath, path);
+
+    QImage image;
+    HbNvgSoftwareRenderer renderer;
+    QVERIFY(renderer.rasterize(nvg.data(), QSize(40, 40), Qt::IgnoreAspectRatio, image));
+
+    QImage expected = referenceImage(QSize(40, 40));
+    QPainter painter(&expected);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setTransform(QTransform::fromScale(4, 4));
+    painter.setBrush(QColor(0, 0, 255));
+    QPen pen(QBrush(QColor(0, 128, 0)), 1.5, Qt::SolidLine, Qt::FlatCap, Qt::MiterJoin);
+    pen.setMiterLimit(4.0);
+    painter.setPen(pen);
+    painter.drawPath(squarePath());
+    painter.end();
+    QCOMPARE(image, expected);
+}
+
+void TestHbNvgSoftwareRenderer::linearGradient()
+{
+    NvgWriter nvg(QRectF(0, 0, 10, 10));
+    QGradientStops stops;
+    stops << QGradientStop(0, QColor(255, 0, 0)) << QGradientStop(1, QColor(0, 0, 255));
+    int gradient = nvg.addLinearGradient(QPointF(2, 0), QPointF(8, 0));
+    int ramp = nvg.addColorRamp(stops);
+    int path = nvg.addPath(squareSegments(), squareCoords());
+    nvg.command(cmdSetFillPaint | opaque, gradient);
+    nvg.command(cmdSetColorRamp, ramp);
+    nvg.command(cmdDrawPath | fillPath, path);
+
+    QImage image;
+    HbNvgSoftwareRenderer renderer;
+    QVERIFY(renderer.rasterize(nvg.data(), QSize(40, 40), Qt::IgnoreAspectRatio, image));
+
+    QImage expected = referenceImage(QSize(40, 40));
+    QPainter painter(&expected);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setTransform(QTransform::fromScale(4, 4));
+    QLinearGradient linear(QPointF(2, 0), QPointF(8, 0));
+    linear.setStops(stops);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(linear);
+    painter.drawPath(squarePath());
+    painter.end();
+    QCOMPARE(image, expected);
+
+    // Red on the left, blue on the right.
+    QVERIFY(qRed(image.pixel(9, 20)) > qBlue(image.pixel(9, 20)));
+    QVERIFY(qBlue(image.pixel(30, 20)) > qRed(image.pixel(30, 20)));
+}
+
+void TestHbNvgSoftwareRenderer::transformation()
+{
+    NvgWriter nvg(QRectF(0, 0, 10, 10));
+    int paint = nvg.addFlatPaint(qRgb(0, 0, 0));
+    int path = nvg.addPath(squareSegments(), squareCoords());
+    nvg.command(cmdSetFillPaint | opaque, paint);
+    // Translation only: the type is in the command, the values follow.
+    nvg.command(cmdSetTransformation | (16 << 16));
+    nvg.commandReal(-2);
+    nvg.commandReal(-2);
+    nvg.command(cmdDrawPath | fillPath, path);
+    // Back to the view box transformation.
+    nvg.command(cmdSetTransformation | (1 << 16));
+    nvg.command(cmdDrawPath | fillPath, path);
+
+    QImage image;
+    HbNvgSoftwareRenderer renderer;
+    QVERIFY(renderer.rasterize(nvg.data(), QSize(40, 40), Qt::IgnoreAspectRatio, image));
+
+    QImage expected = referenceImage(QSize(40, 40));
+    QPainter painter(&expected);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(QRectF(0, 0, 24, 24), Qt::black);
+    painter.fillRect(QRectF(8, 8, 24, 24), Qt::black);
+    painter.end();
+    QCOMPARE(differingPixels(image, expected, 1), 0);
+}
+
+void TestHbNvgSoftwareRenderer::arcs()
+{
+    // A circle of radius 3 around (5, 5) from two half arcs.
+    NvgWriter nvg(QRectF(0, 0, 10, 10));
+    int paint = nvg.addFlatPaint(qRgb(255, 255, 255));
+    int path = nvg.addPath(QList<quint8>() << MoveTo << SCCWArcTo << SCCWArcTo << Close,
+                           QList<qreal>() << 2 << 5
+                                          << 3 << 3 << 0 << 8 << 5
+                                          << 3 << 3 << 0 << 2 << 5);
+    nvg.command(cmdSetFillPaint | opaque, paint);
+    nvg.command(cmdDrawPath | fillPath, path);
+
+    QImage image;
+    HbNvgSoftwareRenderer renderer;
+    QVERIFY(renderer.rasterize(nvg.data(), QSize(100, 100), Qt::IgnoreAspectRatio, image));
+
+    QImage expected = referenceImage(QSize(100, 100));
+    QPainter painter(&expected);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(Qt::white);
+    painter.drawEllipse(QRectF(20, 20, 60, 60));
+    painter.end();
+    // Only the anti-aliased edge may differ.
+    QCOMPARE(differingPixels(image, expected, 64), 0);
+}
+
+void TestHbNvgSoftwareRenderer::badData_data()
+{
+    QTest::addColumn<int>("length");
+    QTest::newRow("empty") << 0;
+    QTest::newRow("signature only") << 3;
+    QTest::newRow("header only") << 56;
+    QTest::newRow("truncated commands") << 66;
+    QTest::newRow("truncated sections") << 90;
+}
+
+void TestHbNvgSoftwareRenderer::badData()
+{
+    QFETCH(int, length);
+
+    NvgWriter nvg(QRectF(0, 0, 10, 10));
+    int paint = nvg.addFlatPaint(qRgb(255, 0, 0));
+    int path = nvg.addPath(squareSegments(), squareCoords());
+    nvg.command(cmdSetFillPaint | opaque, paint);
+    nvg.command(cmdDrawPath | fillPath, path);
+    QByteArray data = nvg.data();
+    QVERIFY(length < data.size());
+
+    QImage image;
+    HbNvgSoftwareRenderer renderer;
+    QVERIFY(!renderer.rasterize(data.left(length), QSize(20, 20), Qt::IgnoreAspectRatio, image));
+    QVERIFY(renderer.rasterize(data, QSize(20, 20), Qt::IgnoreAspectRatio, image));
+}
+
+QTEST_MAIN(TestHbNvgSoftwareRenderer)
+#include "unittest_hbnvgsoftwarerenderer.moc"
@@ -0,0 +1,202 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QPointF>
+#include <hbpointrecorder_p.h>
+#include <hbvelocitycalculator_p.h>
+#include <hbgestures_p.h>
+
+/*
+    The list based recorder that HbPointRecorder replaced, kept as the
+    reference for the ring buffer.
+*/
+class ReferenceRecorder
+{
+public:
+    ReferenceRecorder(qreal threshold) : mThreshold(threshold) {}
+
+    void record(qreal point, qint64 time)
+    {
+        if (!mPoints.isEmpty()) {
+            if (time - mPoints.last().second <= 0
+                || qAbs(mPoints.last().first - point) < mThreshold) {
+                return;
+            }
+        }
+        if (mPoints.count() > 1) {
+            qreal dir0 = mPoints.last().first - mPoints.at(mPoints.count() - 2).first;
+            qreal dir1 = point - mPoints.last().first;
+            if (qAbs(dir1) > mThreshold
+                && ((dir0 < 0 && dir1 >= 0) || (dir0 > 0 && dir1 <= 0))) {
+                HbPointTime last = mPoints.last();
+                mPoints.clear();
+                mPoints.append(last);
+            }
+        }
+        if (mPoints.isEmpty() || point != mPoints.last().first) {
+            mPoints.append(HbPointTime(point, time));
+        }
+    }
+
+    qreal velocity(qint64 currentTime) const
+    {
+        if (mPoints.count() < 2 || currentTime - mPoints.last().second >= HbVelocityStopTime) {
+            return 0.0;
+        }
+        qint64 timeDelta = 0;
+        int i = mPoints.count();
+        while (timeDelta < HbVelocitySampleTime && i > 0) {
+            i--;
+            timeDelta = currentTime - mPoints.at(i).second;
+        }
+        if (timeDelta <= 0) {
+            return 0.0;
+        }
+        return (mPoints.last().first - mPoints.at(i).first) / qreal(timeDelta);
+    }
+
+    QList<HbPointTime> mPoints;
+    qreal mThreshold;
+};
+
+class TestHbPointRecorder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void keepsNewestPoints();
+    void directionChangeKeepsLastPoint();
+    void resetEmpties();
+    void matchesListRecorder_data();
+    void matchesListRecorder();
+};
+
+void TestHbPointRecorder::keepsNewestPoints()
+{
+    HbPointRecorder recorder;
+    const int total = 3 * HbPointRecorderCapacity + 7;
+    for (int i = 0; i < total; ++i) {
+        recorder.record(i, i + 1);
+    }
+    QCOMPARE(recorder.count(), HbPointRecorderCapacity);
+    for (int i = 0; i < recorder.count(); ++i) {
+        const int expected = total - HbPointRecorderCapacity + i;
+        QCOMPARE(recorder.at(i).first, qreal(expected));
+        QCOMPARE(recorder.at(i).second, qint64(expected + 1));
+    }
+    QCOMPARE(recorder.lastPoint(), qreal(total - 1));
+    QCOMPARE(recorder.lastTime(), qint64(total));
+}
+
+void TestHbPointRecorder::directionChangeKeepsLastPoint()
+{
+    HbPointRecorder recorder;
+    // Wrap the buffer first so that the start index is not at zero.
+    for (int i = 0; i < HbPointRecorderCapacity + 10; ++i) {
+        recorder.record(i, i + 1);
+    }
+    const qreal turn = recorder.lastPoint();
+    const qint64 turnTime = recorder.lastTime();
+
+    recorder.record(turn - 5, turnTime + 1);
+    QCOMPARE(recorder.count(), 2);
+    QCOMPARE(recorder.at(0), HbPointTime(turn, turnTime));
+    QCOMPARE(recorder.at(1), HbPointTime(turn - 5, turnTime + 1));
+
+    // Points within the threshold and with old timestamps are ignored.
+    recorder.resetRecorder(2.0);
+    recorder.record(10, 1);
+    recorder.record(11, 2);
+    recorder.record(20, 1);
+    QCOMPARE(recorder.count(), 1);
+}
+
+void TestHbPointRecorder::resetEmpties()
+{
+    HbPointRecorder recorder;
+    for (int i = 0; i < 2 * HbPointRecorderCapacity; ++i) {
+        recorder.record(i, i + 1);
+    }
+    recorder.resetRecorder(1.5);
+    QVERIFY(recorder.isEmpty());
+    QCOMPARE(recorder.mThreshold, qreal(1.5));
+    recorder.record(3, 1);
+    QCOMPARE(recorder.count(), 1);
+    QCOMPARE(recorder.lastPoint(), qreal(3));
+}
+
+void TestHbPointRecorder::matchesListRecorder_data()
+{
+    QTest::addColumn<uint>("seed");
+    QTest::addColumn<qreal>("threshold");
+    QTest::newRow("no threshold") << 1u << qreal(0.0);
+    QTest::newRow("threshold") << 2u << qreal(3.5);
+    QTest::newRow("other seed") << 3u << qreal(1.0);
+}
+
+/*
+    Runs long random walks with direction changes through both recorders.
+    The velocity must be the same at every step, although the ring buffer
+    forgets points that the list still has.
+*/
+void TestHbPointRecorder::matchesListRecorder()
+{
+    QFETCH(uint, seed);
+    QFETCH(qreal, threshold);
+
+    qsrand(seed);
+    HbPointRecorder recorder;
+    recorder.resetRecorder(threshold);
+    ReferenceRecorder reference(threshold);
+    HbPointRecorder unused;
+    HbVelocityCalculator calculator(recorder, unused);
+
+    qreal pos = 0;
+    qint64 time = 0;
+    int direction = 1;
+    for (int i = 0; i < 20000; ++i) {
+        if (qrand() % 400 == 0) {
+            direction = -direction;
+        }
+        pos += direction * (qrand() % 8);
+        time += qrand() % 3;
+        recorder.record(pos, time);
+        reference.record(pos, time);
+
+        QCOMPARE(recorder.lastPoint(), reference.mPoints.last().first);
+        QCOMPARE(recorder.lastTime(), reference.mPoints.last().second);
+        QVERIFY(recorder.count() <= HbPointRecorderCapacity);
+        // The running sums cover the window from its first point to the last one.
+        const HbPointTime &first = recorder.at(recorder.windowFirst());
+        QCOMPARE(recorder.windowDelta(), recorder.lastPoint() - first.first);
+        QCOMPARE(recorder.windowTime(), recorder.lastTime() - first.second);
+        const qint64 now = time + qrand() % 20;
+        QCOMPARE(calculator.velocity(now).x(), reference.velocity(now));
+    }
+}
+
+QTEST_MAIN(TestHbPointRecorder)
+#include "unittest_hbpointrecorder.moc"
@@ -0,0 +1,269 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QTextDocument>
+#include <QTextCursor>
+#include <QTextBlock>
+#include <hbapplication.h>
+#include <hbsmileytheme.h>
+#include <hbsmileyengine_p.h>
+#include <hbsmileyengine_p_p.h>
+
+// Patterns that share prefixes and suffixes, so that the automaton needs
+// both its failure and its output links to find the QRegExp match.
+static HbSmileyTheme testTheme()
+{
+    HbSmileyTheme theme;
+    theme.insert("smile", ":)");
+    theme.insert("bigsmile", ":))");
+    theme.insert("wink", ";)");
+    theme.insert("sad", ":(");
+    theme.insert("cry", ":'(");
+    theme.insert("tongue", ":-P");
+    theme.insert("nose", "-P");
+    theme.insert("heart", "<3");
+    return theme;
+}
+
+static QString randomText(int length)
+{
+    static const QString alphabet(":;)('-P<3 ab\n");
+    QString text;
+    text.reserve(length);
+    for (int i = 0; i < length; ++i) {
+        text.append(alphabet.at(qrand() % alphabet.length()));
+    }
+    return text;
+}
+
+class TestHbSmileyEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void matcherAgreesWithRegExp();
+    void insertSmileys();
+    void removeSmileys();
+    void typeSmileys();
+    void typeCharacters();
+    void retypeSmileys();
+
+private:
+    QTextDocument *mDocument;
+    HbSmileyEngine *mEngine;
+};
+
+void TestHbSmileyEngine::initTestCase()
+{
+    qsrand(1234);
+}
+
+void TestHbSmileyEngine::init()
+{
+    mDocument = new QTextDocument;
+    mEngine = new HbSmileyEngine;
+    mEngine->setDocument(mDocument);
+    mEngine->setTheme(testTheme());
+}
+
+void TestHbSmileyEngine::cleanup()
+{
+    delete mEngine;
+    delete mDocument;
+}
+
+/*
+    The automaton must give the same leftmost-longest match as the
+    alternation QRegExp that the engine used before.
+*/
+void TestHbSmileyEngine::matcherAgreesWithRegExp()
+{
+    const HbSmileyTheme theme = testTheme();
+    HbSmileyMatcher matcher;
+    matcher.build(theme.patterns());
+    QRegExp regExp = theme.regExp();
+
+    for (int round = 0; round < 500; ++round) {
+        const QString text = randomText(64);
+        int from = 0;
+        forever {
+            int start = -1;
+            int length = 0;
+            const bool found = matcher.find(text, from, &start, &length);
+            const int expectedStart = regExp.indexIn(text, from);
+            QCOMPARE(found, expectedStart >= 0);
+            if (!found) {
+                break;
+            }
+            QCOMPARE(start, expectedStart);
+            QCOMPARE(length, regExp.matchedLength());
+            from = start + length;
+        }
+    }
+}
+
+void TestHbSmileyEngine::insertSmileys()
+{
+    const QString text("a :) b :)) c\n;) :'( -P :-P <3");
+    mDocument->setPlainText(text);
+    mEngine->insertSmileys();
+
+    // The seven patterns, 17 characters in all, collapse into one
+    // replacement character each.
+    QCOMPARE(mDocument->toPlainText().length(), text.length() - 17 + 7);
+    QCOMPARE(mEngine->toPlainText(), text);
+}
+
+void TestHbSmileyEngine::removeSmileys()
+{
+    mDocument->setPlainText("a :) b :( c <3 d");
+    mEngine->insertSmileys();
+
+    // Remove " b :(" which holds the second smiley.
+    QTextCursor cursor(mDocument);
+    cursor.setPosition(3);
+    cursor.setPosition(7, QTextCursor::KeepAnchor);
+    QCOMPARE(cursor.selectedText(), QString(" b %1").arg(QChar(QChar::ObjectReplacementCharacter)));
+    cursor.removeSelectedText();
+    QCOMPARE(mEngine->toPlainText(), QString("a :) c <3 d"));
+
+    // Remove the first smiley on its own.
+    cursor.setPosition(2);
+    cursor.deleteChar();
+    QCOMPARE(mEngine->toPlainText(), QString("a  c <3 d"));
+}
+
+void TestHbSmileyEngine::typeSmileys()
+{
+    mEngine->setEditRescanEnabled(true);
+    mDocument->setPlainText("a b");
+    QTextCursor cursor(mDocument);
+    cursor.setPosition(1);
+
+    // The pattern is completed by the second character.
+    cursor.insertText(":");
+    QCOMPARE(mDocument->toPlainText(), QString("a: b"));
+    cursor.insertText(")");
+    QCOMPARE(mDocument->toPlainText(), QString("a%1 b").arg(QChar(QChar::ObjectReplacementCharacter)));
+
+    // Deleting the character between two halves joins them into a pattern.
+    cursor.movePosition(QTextCursor::End);
+    cursor.insertText(" <x3");
+    cursor.setPosition(cursor.position() - 2);
+    cursor.deleteChar();
+    QCOMPARE(mDocument->toPlainText().count(QChar::ObjectReplacementCharacter), 2);
+    QCOMPARE(mEngine->toPlainText(), QString("a:) b <3"));
+
+    // Without rescanning, edits leave the patterns alone.
+    mEngine->setEditRescanEnabled(false);
+    cursor.insertText(";)");
+    QCOMPARE(mDocument->toPlainText().count(QChar::ObjectReplacementCharacter), 2);
+}
+
+/*
+    Types 10000 characters one at a time into a document that already holds
+    smileys. Every keystroke goes through the contents change handler, which
+    should only look at the smileys and blocks around the edit.
+*/
+void TestHbSmileyEngine::typeCharacters()
+{
+    QStringList lines;
+    for (int i = 0; i < 200; ++i) {
+        lines.append(QString("line %1 :) and ;) and <3\n").arg(i));
+    }
+    mDocument->setPlainText(lines.join(QString()));
+    mEngine->insertSmileys();
+    mEngine->setEditRescanEnabled(true);
+
+    const QString typed = randomText(10000);
+    QTextCursor cursor(mDocument);
+    cursor.setPosition(mDocument->findBlockByNumber(100).position());
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < typed.length(); ++i) {
+            cursor.insertText(QString(typed.at(i)));
+        }
+    }
+
+    // The typed patterns have become smileys, which convert back to the
+    // same text, and none of the existing smileys is lost.
+    const QString expected = QStringList(lines.mid(0, 100)).join(QString())
+                             + typed + QStringList(lines.mid(100)).join(QString());
+    QCOMPARE(mEngine->toPlainText(), expected);
+    QVERIFY(mDocument->toPlainText().count(QChar::ObjectReplacementCharacter) >= 600);
+}
+
+/*
+    Deletes every smiley of a 200 line document and types its pattern again.
+    Each deletion removes a tracked smiley and each retyped pattern creates
+    one, so both halves of the contents change handler run on every edit.
+*/
+void TestHbSmileyEngine::retypeSmileys()
+{
+    QString text;
+    for (int i = 0; i < 200; ++i) {
+        text.append(QString("line %1 :) and ;) and <3\n").arg(i));
+    }
+    mDocument->setPlainText(text);
+    mEngine->insertSmileys();
+    mEngine->setEditRescanEnabled(true);
+    const QString document = mDocument->toPlainText();
+
+    const QStringList patterns = QStringList() << ":)" << ";)" << "<3";
+    QBENCHMARK {
+        for (QTextBlock block = mDocument->begin(); block.isValid(); block = block.next()) {
+            int offset = -1;
+            for (int k = 0; k < patterns.count(); ++k) {
+                offset = block.text().indexOf(QChar(QChar::ObjectReplacementCharacter), offset + 1);
+                if (offset < 0) {
+                    break;
+                }
+                QTextCursor cursor(mDocument);
+                cursor.setPosition(block.position() + offset);
+                cursor.deleteChar();
+                foreach (const QChar &c, patterns.at(k)) {
+                    cursor.insertText(QString(c));
+                }
+            }
+        }
+    }
+
+    QCOMPARE(mDocument->toPlainText(), document);
+    QCOMPARE(mEngine->toPlainText(), text);
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    TestHbSmileyEngine test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "unittest_hbsmileyengine.moc"
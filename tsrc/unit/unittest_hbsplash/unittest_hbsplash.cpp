@@ -0,0 +1,418 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QPainter>
+#include <hbsplash_p.h>
+#include <hbsplashcodec_p.h>
+#include <hbsplashdefs_p.h>
+
+static const int splashWidth = 360;
+static const int splashHeight = 640;
+static const quint32 baseId = 0x4c0ffee0;
+
+/*
+    Writes \a image as a splash file with the legacy header: width, height,
+    bytes per line, format, extra flags and the compressed size, which is 0
+    for uncompressed pixel data.
+*/
+static bool writeSplash(const QString &fileName, const QImage &image, bool compress)
+{
+    QFile f(fileName);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    QByteArray pixels(reinterpret_cast<const char *>(image.bits()), image.byteCount());
+    if (compress) {
+        pixels = qCompress(pixels);
+    }
+    quint32 header[6];
+    header[0] = image.width();
+    header[1] = image.height();
+    header[2] = image.bytesPerLine();
+    header[3] = image.format();
+    header[4] = 0;
+    header[5] = compress ? pixels.size() : 0;
+    f.write(reinterpret_cast<const char *>(header), sizeof(header));
+    f.write(pixels);
+    return f.error() == QFile::NoError;
+}
+
+/*
+    Writes \a image as a splash file with the extended header. When \a base
+    is set only the pixels inside \a rects are stored and the rest is taken
+    from the generic screen that has \a base as its id.
+*/
+static bool writeExtendedSplash(const QString &fileName, const QImage &image, quint32 codec,
+                                quint32 id, quint32 base = 0,
+                                const QVector<QRect> &rects = QVector<QRect>())
+{
+    QFile f(fileName);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    QByteArray pixels;
+    if (base) {
+        // Invalid rectangles are written as they are, but only the part
+        // inside the image has pixels.
+        foreach (const QRect &stored, rects) {
+            const QRect rect = stored & image.rect();
+            for (int y = rect.top(); y <= rect.bottom(); ++y) {
+                pixels.append(reinterpret_cast<const char *>(image.scanLine(y)) + rect.left() * 4,
+                              rect.width() * 4);
+            }
+        }
+    } else {
+        pixels = QByteArray(reinterpret_cast<const char *>(image.bits()), image.byteCount());
+    }
+    if (codec == HbSplashCodecLz) {
+        pixels = HbSplashCodec::compress(reinterpret_cast<const uchar *>(pixels.constData()),
+                                         pixels.size());
+    } else if (codec == HbSplashCodecZlib) {
+        pixels = qCompress(pixels);
+    }
+    quint32 header[] = {
+        hbsplash_file_magic, 0, hbsplash_file_version,
+        (quint32) image.width(), (quint32) image.height(), (quint32) image.bytesPerLine(),
+        (quint32) image.format(), 0,
+        codec, codec == HbSplashCodecRaw ? 0 : (quint32) pixels.size(), id, base,
+        (quint32) rects.count()
+    };
+    f.write(reinterpret_cast<const char *>(header), sizeof(header));
+    foreach (const QRect &rect, rects) {
+        quint32 r[] = { (quint32) rect.x(), (quint32) rect.y(),
+                        (quint32) rect.width(), (quint32) rect.height() };
+        f.write(reinterpret_cast<const char *>(r), sizeof(r));
+    }
+    f.write(pixels);
+    return f.error() == QFile::NoError;
+}
+
+static bool loadsImage(const QString &appId, const QImage &image)
+{
+    int w = 0, h = 0, bpl = 0;
+    QImage::Format fmt = QImage::Format_Invalid;
+    uchar *data = HbSplash::load(w, h, bpl, fmt, HbSplashScreen::FixedVertical, appId);
+    bool ok = data && w == image.width() && h == image.height()
+              && bpl == image.bytesPerLine() && fmt == image.format()
+              && memcmp(data, image.bits(), h * bpl) == 0;
+    delete[] data;
+    return ok;
+}
+
+class TestHbSplash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void mappedMatchesCopied_data();
+    void mappedMatchesCopied();
+    void releaseMappedKeepsOthers();
+    void timeToFirstPixel_data();
+    void timeToFirstPixel();
+    void codecRoundTrip_data();
+    void codecRoundTrip();
+    void codecRejectsBadInput();
+    void headers_data();
+    void headers();
+    void deltaDecoding();
+    void deltaFallback_data();
+    void deltaFallback();
+
+private:
+    QString mOldCurrent;
+    QString mDir;
+    QImage mImage;
+    QImage mAppImage;
+    QVector<QRect> mAppRects;
+};
+
+void TestHbSplash::initTestCase()
+{
+    // HbSplash looks for the files in "splashscreens" under the current
+    // directory on non-Symbian platforms.
+    mOldCurrent = QDir::currentPath();
+    mDir = QDir::temp().filePath("unittest_hbsplash");
+    QDir().mkpath(mDir + "/splashscreens");
+    QVERIFY(QDir::setCurrent(mDir));
+
+    mImage = QImage(splashWidth, splashHeight, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&mImage);
+    QLinearGradient gradient(0, 0, splashWidth, splashHeight);
+    gradient.setColorAt(0, Qt::darkBlue);
+    gradient.setColorAt(1, Qt::yellow);
+    painter.fillRect(mImage.rect(), gradient);
+    painter.end();
+
+    // The application-specific screen differs from the generic one in the
+    // title and in the content area, like the ones hbsplashgenerator writes.
+    mAppRects << QRect(0, 0, splashWidth, 60) << QRect(20, 200, 320, 240);
+    mAppImage = mImage.copy();
+    painter.begin(&mAppImage);
+    painter.fillRect(mAppRects.at(0), Qt::white);
+    painter.fillRect(mAppRects.at(1), QColor(10, 120, 40, 200));
+    painter.end();
+
+    // Portrait is stored uncompressed and can be mapped, landscape is
+    // compressed and always read through the copying path. Portrait is
+    // also the base of the delta-encoded screens.
+    QVERIFY(writeExtendedSplash("splashscreens/splash_prt.spl", mImage, HbSplashCodecRaw, baseId));
+    QVERIFY(writeSplash("splashscreens/splash_lsc.spl", mImage, true));
+}
+
+void TestHbSplash::cleanupTestCase()
+{
+    QFile::remove("splashscreens/splash_prt.spl");
+    QFile::remove("splashscreens/splash_lsc.spl");
+    QDir::setCurrent(mOldCurrent);
+    QDir(mDir).rmpath("splashscreens");
+}
+
+void TestHbSplash::mappedMatchesCopied_data()
+{
+    QTest::addColumn<int>("flags");
+    QTest::newRow("uncompressed") << int(HbSplashScreen::FixedVertical);
+    QTest::newRow("compressed") << int(HbSplashScreen::FixedHorizontal);
+}
+
+void TestHbSplash::mappedMatchesCopied()
+{
+    QFETCH(int, flags);
+    int w = 0, h = 0, bpl = 0;
+    QImage::Format fmt = QImage::Format_Invalid;
+    uchar *copied = HbSplash::load(w, h, bpl, fmt, HbSplashScreen::Flags(flags));
+    QVERIFY(copied);
+    QCOMPARE(w, splashWidth);
+    QCOMPARE(h, splashHeight);
+    QCOMPARE(bpl, mImage.bytesPerLine());
+    QCOMPARE(fmt, mImage.format());
+
+    int mw = 0, mh = 0, mbpl = 0;
+    QImage::Format mfmt = QImage::Format_Invalid;
+    uchar *mapped = HbSplash::loadMapped(mw, mh, mbpl, mfmt, HbSplashScreen::Flags(flags));
+    QVERIFY(mapped);
+    QCOMPARE(mw, w);
+    QCOMPARE(mh, h);
+    QCOMPARE(mbpl, bpl);
+    QCOMPARE(mfmt, fmt);
+
+    QVERIFY(memcmp(copied, mapped, h * bpl) == 0);
+    QVERIFY(memcmp(mapped, mImage.bits(), h * bpl) == 0);
+
+    HbSplash::releaseMapped(mapped);
+    delete[] copied;
+}
+
+void TestHbSplash::releaseMappedKeepsOthers()
+{
+    int w, h, bpl;
+    QImage::Format fmt;
+    uchar *first = HbSplash::loadMapped(w, h, bpl, fmt, HbSplashScreen::FixedVertical);
+    uchar *second = HbSplash::loadMapped(w, h, bpl, fmt, HbSplashScreen::FixedVertical);
+    QVERIFY(first);
+    QVERIFY(second);
+    QVERIFY(first != second);
+
+    // Releasing one mapping must leave the other one readable.
+    HbSplash::releaseMapped(first);
+    QVERIFY(memcmp(second, mImage.bits(), h * bpl) == 0);
+    HbSplash::releaseMapped(second);
+
+    // Null is ignored.
+    HbSplash::releaseMapped(0);
+}
+
+void TestHbSplash::timeToFirstPixel_data()
+{
+    QTest::addColumn<bool>("mapped");
+    QTest::newRow("copying") << false;
+    QTest::newRow("mapped") << true;
+}
+
+/*
+    Measures the time from the load call until the first pixel of the
+    uncompressed splash screen can be read, which is the part of the
+    application start-up that the mapped path shortens.
+*/
+void TestHbSplash::timeToFirstPixel()
+{
+    QFETCH(bool, mapped);
+    int w, h, bpl;
+    QImage::Format fmt;
+    quint32 firstPixel = 0;
+
+    QBENCHMARK {
+        uchar *data = mapped
+            ? HbSplash::loadMapped(w, h, bpl, fmt, HbSplashScreen::FixedVertical)
+            : HbSplash::load(w, h, bpl, fmt, HbSplashScreen::FixedVertical);
+        QVERIFY(data);
+        firstPixel = *reinterpret_cast<const quint32 *>(data);
+        if (mapped) {
+            HbSplash::releaseMapped(data);
+        } else {
+            delete[] data;
+        }
+    }
+    QCOMPARE(firstPixel, quint32(mImage.pixel(0, 0)));
+}
+
+void TestHbSplash::codecRoundTrip_data()
+{
+    QTest::addColumn<QByteArray>("input");
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("shorter than a match") << QByteArray("abc");
+    QTest::newRow("uniform") << QByteArray(100000, '\x7f');
+    QByteArray random(100000, 0);
+    qsrand(1);
+    for (int i = 0; i < random.size(); ++i) {
+        random[i] = char(qrand());
+    }
+    QTest::newRow("random") << random;
+    // Repeats further apart than the largest match offset.
+    QByteArray far = random.left(70000);
+    far.append(random.left(70000));
+    QTest::newRow("far repeats") << far;
+    QTest::newRow("image") << QByteArray(reinterpret_cast<const char *>(mImage.bits()),
+                                         mImage.byteCount());
+}
+
+void TestHbSplash::codecRoundTrip()
+{
+    QFETCH(QByteArray, input);
+    const uchar *src = reinterpret_cast<const uchar *>(input.constData());
+    QByteArray compressed = HbSplashCodec::compress(src, input.size());
+    QByteArray output(input.size(), 0);
+    QVERIFY(HbSplashCodec::uncompress(reinterpret_cast<const uchar *>(compressed.constData()),
+                                      compressed.size(),
+                                      reinterpret_cast<uchar *>(output.data()),
+                                      output.size()));
+    QCOMPARE(output, input);
+    if (QByteArray(QTest::currentDataTag()) == "uniform") {
+        QVERIFY(compressed.size() < input.size() / 100);
+    }
+}
+
+void TestHbSplash::codecRejectsBadInput()
+{
+    const uchar *src = mAppImage.bits();
+    const int size = mAppImage.byteCount();
+    QByteArray compressed = HbSplashCodec::compress(src, size);
+    const uchar *c = reinterpret_cast<const uchar *>(compressed.constData());
+    QByteArray output(size + 1, 0);
+    uchar *dst = reinterpret_cast<uchar *>(output.data());
+
+    QVERIFY(HbSplashCodec::uncompress(c, compressed.size(), dst, size));
+    // Too small and too large output buffers.
+    QVERIFY(!HbSplashCodec::uncompress(c, compressed.size(), dst, size - 1));
+    QVERIFY(!HbSplashCodec::uncompress(c, compressed.size(), dst, size + 1));
+    // Truncated input.
+    QVERIFY(!HbSplashCodec::uncompress(c, compressed.size() - 1, dst, size));
+    QVERIFY(!HbSplashCodec::uncompress(c, compressed.size() / 2, dst, size));
+}
+
+void TestHbSplash::headers_data()
+{
+    QTest::addColumn<bool>("legacy");
+    QTest::addColumn<int>("codec");
+    QTest::newRow("legacy raw") << true << int(HbSplashCodecRaw);
+    QTest::newRow("legacy zlib") << true << int(HbSplashCodecZlib);
+    QTest::newRow("extended raw") << false << int(HbSplashCodecRaw);
+    QTest::newRow("extended zlib") << false << int(HbSplashCodecZlib);
+    QTest::newRow("extended lz") << false << int(HbSplashCodecLz);
+}
+
+/*
+    Files written by older versions of hbsplashgenerator have the six word
+    header and must keep loading next to the new ones.
+*/
+void TestHbSplash::headers()
+{
+    QFETCH(bool, legacy);
+    QFETCH(int, codec);
+    const QString fileName("splashscreens/splash_prt_header.spl");
+    if (legacy) {
+        QVERIFY(writeSplash(fileName, mAppImage, codec == HbSplashCodecZlib));
+    } else {
+        QVERIFY(writeExtendedSplash(fileName, mAppImage, codec, baseId + 1));
+    }
+    bool ok = loadsImage("header", mAppImage);
+    QFile::remove(fileName);
+    QVERIFY(ok);
+}
+
+void TestHbSplash::deltaDecoding()
+{
+    const QString fileName("splashscreens/splash_prt_delta.spl");
+    QVERIFY(writeExtendedSplash(fileName, mAppImage, HbSplashCodecLz, baseId + 2,
+                                baseId, mAppRects));
+    QVERIFY(QFileInfo(fileName).size() < mAppImage.byteCount() / 2);
+    bool ok = loadsImage("delta", mAppImage);
+
+    // The mapped path cannot use delta-encoded files and reads them instead.
+    int w, h, bpl;
+    QImage::Format fmt;
+    uchar *mapped = HbSplash::loadMapped(w, h, bpl, fmt, HbSplashScreen::FixedVertical, "delta");
+    bool mappedOk = mapped && memcmp(mapped, mAppImage.bits(), h * bpl) == 0;
+    HbSplash::releaseMapped(mapped);
+
+    QFile::remove(fileName);
+    QVERIFY(ok);
+    QVERIFY(mappedOk);
+}
+
+void TestHbSplash::deltaFallback_data()
+{
+    QTest::addColumn<quint32>("base");
+    QTest::addColumn<QRect>("rect");
+    QTest::newRow("stale base") << baseId - 1 << QRect(0, 0, splashWidth, 60);
+    QTest::newRow("rect outside") << baseId << QRect(splashWidth - 10, 0, 20, 60);
+    QTest::newRow("empty rect") << baseId << QRect(0, 0, 0, 60);
+}
+
+/*
+    A delta-encoded screen that does not match its base is rejected and the
+    generic screen is used instead.
+*/
+void TestHbSplash::deltaFallback()
+{
+    QFETCH(quint32, base);
+    QFETCH(QRect, rect);
+    const QString fileName("splashscreens/splash_prt_stale.spl");
+    QVector<QRect> rects;
+    rects << rect;
+    QVERIFY(writeExtendedSplash(fileName, mAppImage, HbSplashCodecLz, baseId + 3, base, rects));
+    bool ok = loadsImage("stale", mImage);
+    QFile::remove(fileName);
+    QVERIFY(ok);
+}
+
+QTEST_MAIN(TestHbSplash)
+#include "unittest_hbsplash.moc"
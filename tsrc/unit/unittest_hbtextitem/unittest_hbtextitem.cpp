@@ -0,0 +1,234 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <hbapplication.h>
+#include <hbtextitem.h>
+#include <hbtextitem_p.h>
+
+/*
+    Text item created with the protected constructor, so that the test
+    keeps a pointer to the private data.
+*/
+class TestTextItem : public HbTextItem
+{
+public:
+    explicit TestTextItem(HbTextItemPrivate *d)
+        : HbTextItem(*d, 0), d(d)
+    {
+    }
+
+    HbTextItemPrivate *d;
+};
+
+static QImage emptyImage(const QSizeF &size)
+{
+    QImage image(size.toSize(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(0);
+    return image;
+}
+
+/*
+    Returns the largest difference of any channel between \a a and \a b.
+*/
+static int maxDifference(const QImage &a, const QImage &b)
+{
+    int result = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            QRgb pa = a.pixel(x, y);
+            QRgb pb = b.pixel(x, y);
+            result = qMax(result, qAbs(qRed(pa) - qRed(pb)));
+            result = qMax(result, qAbs(qGreen(pa) - qGreen(pb)));
+            result = qMax(result, qAbs(qBlue(pa) - qBlue(pb)));
+            result = qMax(result, qAbs(qAlpha(pa) - qAlpha(pb)));
+        }
+    }
+    return result;
+}
+
+static bool isEmpty(const QImage &image)
+{
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            if (qAlpha(image.pixel(x, y))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+class TestHbTextItem : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void cachedFadeMatchesMultiPass_data();
+    void cachedFadeMatchesMultiPass();
+    void cacheFollowsRenderHints();
+    void cacheReleasedOnHide();
+
+private:
+    QImage paintCached(QPainter::RenderHints hints = 0);
+    QImage paintMultiPass(QPainter::RenderHints hints = 0);
+
+    TestTextItem *mItem;
+};
+
+void TestHbTextItem::init()
+{
+    mItem = new TestTextItem(new HbTextItemPrivate);
+    mItem->setTextColor(Qt::black);
+    mItem->setElideMode(Qt::ElideNone);
+    mItem->setFadeLengths(20, 10);
+}
+
+void TestHbTextItem::cleanup()
+{
+    delete mItem;
+    mItem = 0;
+}
+
+QImage TestHbTextItem::paintCached(QPainter::RenderHints hints)
+{
+    QImage image = emptyImage(mItem->size());
+    QPainter painter(&image);
+    painter.setRenderHints(hints);
+    QStyleOptionGraphicsItem option;
+    option.exposedRect = mItem->boundingRect();
+    mItem->paint(&painter, &option, 0);
+    return image;
+}
+
+/*
+    Paints the text the way HbTextItem::paint() does when the cache can't
+    be used, one pass for each gradient area.
+*/
+QImage TestHbTextItem::paintMultiPass(QPainter::RenderHints hints)
+{
+    QImage image = emptyImage(mItem->size());
+    QPainter painter(&image);
+    painter.setRenderHints(hints);
+    painter.setPen(mItem->textColor());
+    painter.save();
+    mItem->d->paintWithFadeEffect(&painter, mItem->textColor());
+    painter.restore();
+    return image;
+}
+
+void TestHbTextItem::cachedFadeMatchesMultiPass_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<int>("alignment");
+    QTest::addColumn<int>("wrapping");
+    QTest::addColumn<QSizeF>("size");
+
+    const QString longText("The quick brown fox jumps over the lazy dog again and again");
+    QTest::newRow("left") << longText << int(Qt::AlignLeft | Qt::AlignVCenter)
+                          << int(Hb::TextNoWrap) << QSizeF(120, 30);
+    QTest::newRow("right") << longText << int(Qt::AlignRight | Qt::AlignVCenter)
+                           << int(Hb::TextNoWrap) << QSizeF(120, 30);
+    QTest::newRow("center") << longText << int(Qt::AlignHCenter | Qt::AlignVCenter)
+                            << int(Hb::TextNoWrap) << QSizeF(120, 30);
+    QTest::newRow("wrapped") << longText + " " + longText << int(Qt::AlignLeft | Qt::AlignTop)
+                             << int(Hb::TextWordWrap) << QSizeF(150, 45);
+    QTest::newRow("wrapped, long word") << QString("Supercalifragilisticexpialidocious ") + longText
+                                        << int(Qt::AlignLeft | Qt::AlignTop)
+                                        << int(Hb::TextWrapAnywhere) << QSizeF(100, 45);
+}
+
+/*
+    The cached images composited through the mask give the same result as
+    drawing the text once for each gradient area, apart from rounding.
+*/
+void TestHbTextItem::cachedFadeMatchesMultiPass()
+{
+    QFETCH(QString, text);
+    QFETCH(int, alignment);
+    QFETCH(int, wrapping);
+    QFETCH(QSizeF, size);
+
+    mItem->setText(text);
+    mItem->setAlignment(Qt::Alignment(alignment));
+    mItem->setTextWrapping(Hb::TextWrapping(wrapping));
+    mItem->setGeometry(QRectF(QPointF(0, 0), size));
+
+    QImage cached = paintCached();
+    QVERIFY(mItem->d->mPaintFaded);
+    QVERIFY(!mItem->d->mFadeTextImage.isNull());
+    QVERIFY(!mItem->d->mFadeMask.isNull());
+
+    QImage multiPass = paintMultiPass();
+    QVERIFY(!isEmpty(multiPass));
+    QVERIFY2(maxDifference(cached, multiPass) <= 3,
+             qPrintable(QString("difference %1").arg(maxDifference(cached, multiPass))));
+
+    // painting again from the cache gives the same image
+    QCOMPARE(paintCached(), cached);
+}
+
+void TestHbTextItem::cacheFollowsRenderHints()
+{
+    mItem->setText("The quick brown fox jumps over the lazy dog");
+    mItem->setGeometry(QRectF(0, 0, 120, 30));
+
+    const QPainter::RenderHints hints = QPainter::Antialiasing | QPainter::TextAntialiasing;
+    QImage cached = paintCached(hints);
+    QCOMPARE(mItem->d->mFadeRenderHints, hints);
+    QVERIFY(maxDifference(cached, paintMultiPass(hints)) <= 3);
+
+    cached = paintCached(0);
+    QCOMPARE(mItem->d->mFadeRenderHints, QPainter::RenderHints(0));
+    QVERIFY(maxDifference(cached, paintMultiPass(0)) <= 3);
+}
+
+void TestHbTextItem::cacheReleasedOnHide()
+{
+    mItem->setText("The quick brown fox jumps over the lazy dog");
+    mItem->setGeometry(QRectF(0, 0, 120, 30));
+
+    paintCached();
+    QVERIFY(!mItem->d->mFadeTextImage.isNull());
+    QVERIFY(!mItem->d->mFadeMask.isNull());
+
+    mItem->hide();
+    QVERIFY(mItem->d->mFadeTextImage.isNull());
+    QVERIFY(mItem->d->mFadeMask.isNull());
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    TestHbTextItem test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "unittest_hbtextitem.moc"
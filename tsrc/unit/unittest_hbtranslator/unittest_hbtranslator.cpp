@@ -0,0 +1,206 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+** Contact: Nokia Corporation (developer.feedback@nokia.com)
+**
+** This file is part of the UI Extensions for Mobile.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser General Public
+** License version 2.1 as published by the Free Software Foundation and
+** appearing in the file LICENSE.LGPL included in the packaging of this file.
+** Please review the following information to ensure the GNU Lesser General
+** Public License version 2.1 requirements will be met:
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** In addition, as a special exception, Nokia gives you certain additional
+** rights.  These rights are described in the Nokia Qt LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** If you have questions regarding the use of this file, please contact
+** Nokia at developer.feedback@nokia.com.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QFile>
+#include <hbapplication.h>
+#include <hbtranslator.h>
+#include <hbtranslator_p.h>
+
+// The magic number of the .qm format. A file with nothing else is an empty
+// but valid catalog.
+static const uchar qmMagic[16] = {
+    0x3c, 0xb8, 0x64, 0x18, 0xca, 0xef, 0x9c, 0x95,
+    0xcd, 0x21, 0x1c, 0xbf, 0x60, 0xa1, 0xbd, 0xdd
+};
+
+class TestHbTranslator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void cleanup();
+
+    void mappingIsShared();
+    void mappingOutlivesResolvedNames();
+    void missIsForgottenOnClear();
+    void missIsForgottenOnLocaleChange();
+    void createTranslators();
+
+private:
+    bool writeCatalog(const QString &name);
+
+    QString mPath;
+};
+
+bool TestHbTranslator::writeCatalog(const QString &name)
+{
+    QFile file(mPath + name + ".qm");
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(reinterpret_cast<const char *>(qmMagic), sizeof(qmMagic)) == sizeof(qmMagic);
+}
+
+void TestHbTranslator::initTestCase()
+{
+#ifdef Q_OS_SYMBIAN
+    QSKIP("Catalogs are not memory mapped on Symbian", SkipAll);
+#endif
+    mPath = QDir::temp().filePath("unittest_hbtranslator") + '/';
+    QDir().mkpath(mPath);
+    QVERIFY(HbTranslatorCatalogCache::instance());
+}
+
+void TestHbTranslator::cleanupTestCase()
+{
+    QDir dir(mPath);
+    foreach (const QString &file, dir.entryList(QDir::Files)) {
+        dir.remove(file);
+    }
+    QDir().rmdir(mPath);
+}
+
+void TestHbTranslator::cleanup()
+{
+    QCOMPARE(HbTranslatorCatalogCache::instance()->mappingCount(), 0);
+    HbTranslatorPrivate::clearCatalogCache();
+}
+
+void TestHbTranslator::mappingIsShared()
+{
+    QVERIFY(writeCatalog("shared"));
+    HbTranslatorCatalogCache *cache = HbTranslatorCatalogCache::instance();
+    const QString file = mPath + "shared.qm";
+
+    int size1 = 0;
+    int size2 = 0;
+    uchar *data1 = cache->map(file, size1);
+    uchar *data2 = cache->map(file, size2);
+    QVERIFY(data1);
+    QCOMPARE(data2, data1);
+    QCOMPARE(size1, int(sizeof(qmMagic)));
+    QCOMPARE(size2, size1);
+    QCOMPARE(cache->mappingCount(), 1);
+
+    // The mapping goes away with the last reference.
+    cache->unmap(data1);
+    QCOMPARE(cache->mappingCount(), 1);
+    QVERIFY(memcmp(data2, qmMagic, sizeof(qmMagic)) == 0);
+    cache->unmap(data2);
+    QCOMPARE(cache->mappingCount(), 0);
+
+    // Missing and empty files are not mapped.
+    int size = 0;
+    QVERIFY(!cache->map(mPath + "missing.qm", size));
+    QFile empty(mPath + "empty.qm");
+    QVERIFY(empty.open(QIODevice::WriteOnly));
+    empty.close();
+    QVERIFY(!cache->map(empty.fileName(), size));
+    QCOMPARE(cache->mappingCount(), 0);
+}
+
+void TestHbTranslator::mappingOutlivesResolvedNames()
+{
+    QVERIFY(writeCatalog("outlive"));
+    HbTranslatorCatalogCache *cache = HbTranslatorCatalogCache::instance();
+    int size = 0;
+    uchar *data = cache->map(mPath + "outlive.qm", size);
+    QVERIFY(data);
+    HbTranslatorPrivate::clearCatalogCache();
+    QCOMPARE(cache->mappingCount(), 1);
+    cache->unmap(data);
+}
+
+void TestHbTranslator::missIsForgottenOnClear()
+{
+    HbTranslatorCatalogCache *cache = HbTranslatorCatalogCache::instance();
+    const QString key = mPath + "late";
+    QString file;
+    cache->setResolved(key, QString());
+    QVERIFY(cache->resolved(key, file));
+    QVERIFY(file.isEmpty());
+
+    HbTranslatorPrivate::clearCatalogCache();
+    QVERIFY(!cache->resolved(key, file));
+}
+
+/*
+    A catalog installed after the first lookup is found once the locale
+    changes. The application is watched, no main window is needed.
+*/
+void TestHbTranslator::missIsForgottenOnLocaleChange()
+{
+    HbTranslatorCatalogCache *cache = HbTranslatorCatalogCache::instance();
+    QFile::remove(mPath + "installed.qm");
+    {
+        HbTranslator translator(mPath, "installed");
+        QCOMPARE(cache->mappingCount(), 0);
+    }
+
+    QVERIFY(writeCatalog("installed"));
+    {
+        HbTranslator translator(mPath, "installed");
+        QCOMPARE(cache->mappingCount(), 0);
+    }
+
+    QEvent localeChange(QEvent::LocaleChange);
+    QApplication::sendEvent(qApp, &localeChange);
+    {
+        HbTranslator translator(mPath, "installed");
+        QCOMPARE(cache->mappingCount(), 1);
+    }
+}
+
+/*
+    Benchmarks creating translators for the same catalog, which resolves
+    the file name and maps the file only once.
+*/
+void TestHbTranslator::createTranslators()
+{
+    QVERIFY(writeCatalog("bench"));
+    HbTranslatorCatalogCache *cache = HbTranslatorCatalogCache::instance();
+    QList<HbTranslator *> translators;
+    QBENCHMARK {
+        for (int i = 0; i < 20; ++i) {
+            translators.append(new HbTranslator(mPath, "bench"));
+        }
+        QCOMPARE(cache->mappingCount(), 1);
+        qDeleteAll(translators);
+        translators.clear();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    HbApplication app(argc, argv);
+    TestHbTranslator test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "unittest_hbtranslator.moc"
@@ -0,0 +1,47 @@
+#
+#############################################################################
+##
+## Copyright (C) 2008-2010 Nokia Corporation and/or its subsidiary(-ies).
+## All rights reserved.
+## Contact: Nokia Corporation (developer.feedback@nokia.com)
+##
+## This file is part of the UI Extensions for Mobile.
+##
+## GNU Lesser General Public License Usage
+## This file may be used under the terms of the GNU Lesser General Public
+## License version 2.1 as published by the Free Software Foundation and
+## appearing in the file LICENSE.LGPL included in the packaging of this file.
+## Please review the following information to ensure the GNU Lesser General
+## Public License version 2.1 requirements will be met:
+## http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+##
+## In addition, as a special exception, Nokia gives you certain additional
+## rights.  These rights are described in the Nokia Qt LGPL Exception
+## version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+##
+## If you have questions regarding the use of this file, please contact
+## Nokia at developer.feedback@nokia.com.
+##
+#############################################################################
+
+# Common settings for the QTestLib unit tests. "make test" runs a test with
+# plain text output, "make autotest" stores the results as QTestLib XML to
+# <builddir>/autotest. Tests of private classes need a developer build, which
+# exports the HB_AUTOTEST_EXPORT classes.
+
+TEMPLATE = app
+QT += testlib
+CONFIG += qtestlib console
+CONFIG -= app_bundle
+
+DEPENDPATH += .
+INCLUDEPATH += .
+
+hbAddLibrary(hbcore/HbCore)
+
+unix:test.commands = ./$$TARGET
+else:test.commands = $$TARGET
+autotest.commands = $$test.commands -xml -o $$hbNativePath($${HB_BUILD_DIR}/autotest/$${TARGET}.xml)
+QMAKE_EXTRA_TARGETS += test autotest
+
+include($${HB_SOURCE_DIR}/src/hbcommon.pri)